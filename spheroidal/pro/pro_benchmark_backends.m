@@ -0,0 +1,93 @@
+%
+% Copyright (c) 2014, Ross Adelman, Nail A. Gumerov, and Ramani Duraiswami
+% All rights reserved.
+%
+% Redistribution and use in source and binary forms, with or without
+% modification, are permitted provided that the following conditions are met:
+%
+% 1. Redistributions of source code must retain the above copyright notice,
+% this list of conditions and the following disclaimer.
+%
+% 2. Redistributions in binary form must reproduce the above copyright notice,
+% this list of conditions and the following disclaimer in the documentation
+% and/or other materials provided with the distribution.
+%
+% THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+% AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+% IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+% ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+% LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+% CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+% SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+% INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+% CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+% ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+% POSSIBILITY OF SUCH DAMAGE.
+%
+%
+% Time pro_sphwv with each of its backends (see -backend in
+% sphwv/common_main.cpp), to see how much faster the native ones are than
+% MPFR for a given c, m, and n.  For each backend, everything is first
+% calculated (and the time that takes is reported too), and then the dr
+% coefficients (calculate_drmn) and the prolate spheroidal radial functions
+% from 1 to b (save_Rmn) are each recalculated n_runs times and the best time
+% is kept.  The native backends have a fixed precision and range, so only
+% use this for small values of c, and with log10_*_min that a double can
+% hold.  The results are left in data/, and they're the last backend's.
+%
+% Arguments:
+%     path - the directory in which pro_sphwv is located
+%     max_memory - the maximum amount of memory, in MB, that pro_sphwv can use
+%                  before automatically terminating
+%     precision - the number of bits of precision pro_sphwv should use with
+%                 the mpfr backend
+%     c - k * a, where k is the wavenumber and 2a is the interfocal distance
+%     m - one modal value
+%     n - the other modal value, which is equal to m, m + 1, ...
+%     n_dr, log10_dr_min, n_dr_neg, log10_dr_neg_min, n_c2k, log10_c2k_min -
+%         the same as in pro_calculate_everything
+%     b - the range of values over which to calculate the prolate spheroidal
+%         radial functions.  the range will be [1, b]
+%     d_R - the spacing between argument values when calculating the prolate
+%           spheroidal radial functions
+%     n_runs - how many times to time each one
+% Return Values:
+%     times - a table of the times, in seconds, with one row for each backend
+%             and columns everything, dr, and R
+%
+function times = pro_benchmark_backends(path, max_memory, precision, c, m, n, n_dr, log10_dr_min, n_dr_neg, log10_dr_neg_min, n_c2k, log10_c2k_min, b, d_R, n_runs)
+	backends = {'mpfr', 'double', 'long_double', 'float128', 'double_double', 'extended_double'};
+	fprintf('calculating lambda_approx...\n');
+	pro_calculate_lambdamn_approx(c, m, n);
+	times = zeros(length(backends), 3);
+	for i = 1:length(backends)
+		prefix = sprintf('"%s/pro_sphwv" -max_memory %d -precision %d -backend %s -verbose n -c %s -m %d -n %d', path, max_memory, precision, backends{i}, nice_number(c, 20), m, n);
+		command = sprintf('%s -w everything -n_dr %d -dr_min 1.0e%d -n_dr_neg %d -dr_neg_min 1.0e%d -n_c2k %d -c2k_min 1.0e%d', prefix, n_dr, log10_dr_min, n_dr_neg, log10_dr_neg_min, n_c2k, log10_c2k_min);
+		fprintf('%s\n', command);
+		tic;
+		[ ...
+		status, result ...
+		] = system(command);
+		times(i, 1) = toc;
+		if (status == 1)
+			fprintf('%s', result);
+			return;
+		end
+		times(i, 2) = inf;
+		times(i, 3) = inf;
+		for j = 1:n_runs
+			command = sprintf('%s -w dr -n_dr %d -dr_min 1.0e%d', prefix, n_dr, log10_dr_min);
+			tic;
+			system(command);
+			times(i, 2) = min(times(i, 2), toc);
+			command = sprintf('%s -w R -a 1.0 -b %s -d %s -arg_type xi -which R1_1,R1_2,R2_1,R2_2 -p 40 > data/pro_%s_R_%s.txt', prefix, nice_number(b, 20), nice_number(d_R, 20), generate_name(c, m, n), backends{i});
+			tic;
+			system(command);
+			times(i, 3) = min(times(i, 3), toc);
+		end
+	end
+	fprintf('%-16s%16s%16s%16s\n', 'backend', 'everything', 'dr', 'R');
+	for i = 1:length(backends)
+		fprintf('%-16s%16.3f%16.3f%16.3f\n', backends{i}, times(i, 1), times(i, 2), times(i, 3));
+	end
+end
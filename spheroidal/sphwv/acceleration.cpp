@@ -0,0 +1,283 @@
+//
+// Copyright (c) 2014, Ross Adelman, Nail A. Gumerov, and Ramani Duraiswami
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include "acceleration.hpp"
+#include <atomic>
+#include <deque>
+#include <iostream>
+#include "real.hpp"
+#include "real_types.hpp"
+#include <string>
+#include <vector>
+
+int acceleration::method = acceleration::NONE;
+std::atomic<long> acceleration::n_accelerated(0);
+std::atomic<long> acceleration::n_plain(0);
+std::atomic<long> acceleration::n_terms(0);
+std::atomic<long> acceleration::n_terms_saved(0);
+
+bool acceleration::parse(int & method, const std::string & value)
+{
+	if (value == "none")
+	{
+		method = NONE;
+	}
+	else if (value == "wynn")
+	{
+		method = WYNN;
+	}
+	else if (value == "levin_u")
+	{
+		method = LEVIN_U;
+	}
+	else if (value == "levin_t")
+	{
+		method = LEVIN_T;
+	}
+	else
+	{
+		return false;
+	}
+	return true;
+}
+
+void acceleration::print_statistics()
+{
+	std::cout << "acceleration: " << n_accelerated << " accelerated, " << n_plain << " plain, " << n_terms << " terms, about " << n_terms_saved << " terms saved" << std::endl;
+}
+
+template <class real>
+accelerator<real>::accelerator()
+{
+	clear();
+}
+
+template <class real>
+void accelerator<real>::clear()
+{
+	sums.clear();
+	terms.clear();
+	n = -1;
+	value = real::NAN;
+	prev_value = real::NAN;
+	n_agreeing = 0;
+	converged = false;
+}
+
+template <class real>
+void accelerator<real>::add(const real & s)
+{
+	if (acceleration::method == acceleration::NONE)
+	{
+		return;
+	}
+	if (n >= 0)
+	{
+		terms.push_back(s - sums.back());
+	}
+	else
+	{
+		terms.push_back(s);
+	}
+	sums.push_back(s);
+	if ((int)sums.size() > MAX_ORDER + 1)
+	{
+		sums.pop_front();
+		terms.pop_front();
+	}
+	++n;
+	prev_value = value;
+	if (acceleration::method == acceleration::WYNN)
+	{
+		value = calculate_wynn();
+	}
+	else
+	{
+		value = calculate_levin();
+	}
+	if (value != value || abs(value) == real::INF)
+	{
+		value = s;
+		n_agreeing = 0;
+	}
+	else if (value == prev_value || abs(value - prev_value) < real::SMALL_ENOUGH * abs(value))
+	{
+		++n_agreeing;
+	}
+	else
+	{
+		n_agreeing = 0;
+	}
+	converged = n_agreeing >= 2;
+}
+
+template <class real>
+bool accelerator<real>::has_converged() const
+{
+	return converged;
+}
+
+template <class real>
+real accelerator<real>::get_value() const
+{
+	return value;
+}
+
+template <class real>
+void accelerator<real>::report(bool verbose, const std::string & name, long n_plain_terms)
+{
+	real q;
+	real saved;
+	long n_saved;
+	
+	if (acceleration::method == acceleration::NONE)
+	{
+		return;
+	}
+	n_saved = 0;
+	if (converged)
+	{
+		++acceleration::n_accelerated;
+		if ((int)terms.size() >= 2 && terms.back() != real::ZERO && terms[terms.size() - 2] != real::ZERO)
+		{
+			q = abs(terms.back() / terms[terms.size() - 2]);
+			if (q < real::ONE)
+			{
+				saved = round(log(real::SMALL_ENOUGH * abs(value) / abs(terms.back())) / log(q));
+				if (saved > real::ZERO)
+				{
+					n_saved = saved < real(1000000000) ? (long)saved.get_int() : 1000000000L;
+				}
+			}
+		}
+		if (n_plain_terms - (n + 1) > n_saved)
+		{
+			n_saved = n_plain_terms - (n + 1);
+		}
+		acceleration::n_terms_saved += n_saved;
+	}
+	else
+	{
+		++acceleration::n_plain;
+	}
+	acceleration::n_terms += n + 1;
+	if (verbose)
+	{
+		if (converged)
+		{
+			std::cout << name << ": accelerated after " << n + 1 << " terms, about " << n_saved << " fewer" << std::endl;
+		}
+		else
+		{
+			std::cout << name << ": not accelerated after " << n + 1 << " terms" << std::endl;
+		}
+	}
+}
+
+//
+// Works out the epsilon table from the last elements, and returns the entry
+// in its highest even column, which only depends on the newest elements.
+//
+template <class real>
+real accelerator<real>::calculate_wynn()
+{
+	int k;
+	
+	k = (int)sums.size() - 1;
+	k -= k % 2;
+	if (k == 0)
+	{
+		return sums.back();
+	}
+	prev_column.assign(k + 2, real::ZERO);
+	column.assign(sums.end() - (k + 1), sums.end());
+	for (int j = 1; j <= k; ++j)
+	{
+		next_column.resize(column.size() - 1);
+		for (int i = 0; i < (int)next_column.size(); ++i)
+		{
+			if (column[i + 1] == column[i])
+			{
+				return sums.back();
+			}
+			next_column[i] = prev_column[i + 1] + reciprocal(column[i + 1] - column[i]);
+		}
+		prev_column.swap(column);
+		column.swap(next_column);
+	}
+	return column[0];
+}
+
+//
+// Levin's transformation of order k, where the remainder estimates are
+// (n + 1) times the terms for u, and just the terms for t.
+//
+template <class real>
+real accelerator<real>::calculate_levin()
+{
+	int k;
+	int n0;
+	real numerator;
+	real denominator;
+	real binomial;
+	real f;
+	
+	k = (int)sums.size() - 1;
+	if (k == 0)
+	{
+		return sums.back();
+	}
+	n0 = n - k;
+	numerator = real::ZERO;
+	denominator = real::ZERO;
+	binomial = real::ONE;
+	for (int i = 0; i <= k; ++i)
+	{
+		if (terms[i] == real::ZERO)
+		{
+			return sums.back();
+		}
+		f = binomial * pow_si(real(n0 + i + 1) / real(n0 + k + 1), k - 1);
+		if (acceleration::method == acceleration::LEVIN_U)
+		{
+			f /= real(n0 + i + 1) * terms[i];
+		}
+		else
+		{
+			f /= terms[i];
+		}
+		numerator += f * sums[i];
+		denominator += f;
+		binomial *= -real(k - i) / real(i + 1);
+	}
+	return numerator / denominator;
+}
+
+#define INSTANTIATE_ACCELERATOR(real) \
+	template class accelerator<real>;
+
+FOR_EACH_REAL_TYPE(INSTANTIATE_ACCELERATOR)
@@ -0,0 +1,121 @@
+//
+// Copyright (c) 2014, Ross Adelman, Nail A. Gumerov, and Ramani Duraiswami
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#ifndef ACCELERATION_HPP
+#define ACCELERATION_HPP
+
+#include <atomic>
+#include <deque>
+#include <string>
+#include <vector>
+
+//
+// acceleration::method is the sequence acceleration that the slowly
+// converging loops use, which main sets with -acceleration.  It's NONE by
+// default, in which case every loop sums the way it always has.  WYNN is
+// Wynn's epsilon algorithm, and LEVIN_U and LEVIN_T are Levin's u and t
+// transformations.
+//
+// The counters are added up over every loop that fed an accelerator:
+// n_accelerated is how many of them stopped early with an accelerated
+// value, n_plain is how many of them finished with plain summation anyway,
+// n_terms is how many terms they took altogether, and n_terms_saved is
+// roughly how many more plain summation would have needed.  They're atomic,
+// since loops on different threads (see real_context in real.hpp) can add to
+// them at the same time.  With -verbose y, main prints them at the end.
+//
+class acceleration
+{
+public:
+	static const int NONE = 0;
+	static const int WYNN = 1;
+	static const int LEVIN_U = 2;
+	static const int LEVIN_T = 3;
+	
+	static int method;
+	static std::atomic<long> n_accelerated;
+	static std::atomic<long> n_plain;
+	static std::atomic<long> n_terms;
+	static std::atomic<long> n_terms_saved;
+	
+	static bool parse(int & method, const std::string & value);
+	static void print_statistics();
+};
+
+//
+// accelerator is fed a sequence, one element at a time: the partial sums of
+// a series, or the values of a continued fraction as its terms are added.
+// After each one, it works out an estimate of the limit from the last
+// (up to) MAX_ORDER + 1 elements, with acceleration::method, so each element
+// is a fixed amount of work, no matter how long the sequence gets.
+//
+// As a safeguard, the accelerator has only converged once three estimates in
+// a row agree to within SMALL_ENOUGH (and they aren't infinite or NaN).
+// Until then, the loop keeps on going, and if it finishes on its own first,
+// the plain sum is used, like it would have been anyway.  If the sequence
+// stops changing (so that the estimate would divide by zero), the estimate
+// is just the last element.
+//
+// report adds the loop to the counters in acceleration (and prints what
+// happened, with verbose).  The number of terms saved is estimated from the
+// ratio of the last two terms, as if the rest of the series were geometric,
+// or from n_plain_terms, the fewest terms that the loop's own test could
+// have stopped at (when it only checks every so often), whichever is more.
+//
+// With acceleration::method set to NONE, none of this does anything, and
+// the accelerator never converges.
+//
+template <class real>
+class accelerator
+{
+public:
+	static const int MAX_ORDER = 12;
+	
+	accelerator();
+	void clear();
+	void add(const real & s);
+	bool has_converged() const;
+	real get_value() const;
+	void report(bool verbose, const std::string & name, long n_plain_terms);
+	
+private:
+	std::deque<real> sums;
+	std::deque<real> terms;
+	int n;
+	real value;
+	real prev_value;
+	int n_agreeing;
+	bool converged;
+	std::vector<real> prev_column;
+	std::vector<real> column;
+	std::vector<real> next_column;
+	
+	real calculate_wynn();
+	real calculate_levin();
+};
+
+#endif
@@ -26,95 +26,327 @@
 //
 
 #include "adder.hpp"
-#include <algorithm>
+#include <condition_variable>
+#include <cstdlib>
+#include "complex.hpp"
+#include <functional>
+#include <memory>
+#include <mutex>
 #include "real.hpp"
+#include "real_types.hpp"
+#include <string>
+#include <thread>
+#include <utility>
 #include <vector>
 
-static bool calculate_sum_comparator(const real & a, const real & b);
+//
+// The pool behind reduction::run.  Each job has a generation number, which
+// is how the threads tell a new job from the one they just did.  n_running
+// is how many of them are still working on the current one.
+//
+// There's only one pool, and it can only do one job at a time, so run holds
+// caller for as long as a job takes: a thread that calls it while another
+// thread's job is running waits for that job to be done.
+//
+struct reduction_pool
+{
+	std::mutex caller;
+	std::mutex mutex;
+	std::condition_variable start;
+	std::condition_variable done;
+	std::vector<std::thread> threads;
+	const std::function<void (int)> *job;
+	int n_threads;
+	int precision;
+	int max_reals;
+	long generation;
+	int n_running;
+	bool stopping;
+	
+	reduction_pool();
+	~reduction_pool();
+};
+
+static void work(int i, long generation);
 
-adder::adder()
+int reduction::n_threads = 1;
+
+static reduction_pool pool;
+
+reduction_pool::reduction_pool() : job(0), n_threads(0), precision(0), max_reals(-1), generation(0), n_running(0), stopping(false)
 {
-	clear();
 }
 
-void adder::clear()
+reduction_pool::~reduction_pool()
 {
-	addends.clear();
-	prev_sum = real::NAN;
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		
+		stopping = true;
+	}
+	start.notify_all();
+	for (int i = 0; i < (int)threads.size(); ++i)
+	{
+		threads[i].join();
+	}
 }
 
-void adder::add(const real & a)
+bool reduction::parse(int & n_threads, const std::string & value)
 {
-	addends.push_back(a);
-	prev_sum = real::NAN;
+	n_threads = std::atoi(value.c_str());
+	return n_threads >= 1;
 }
 
-static bool calculate_sum_comparator(const real & a, const real & b)
+void reduction::run(const std::function<void (int)> & job, int precision)
 {
-	return abs(a) < abs(b);
+	std::lock_guard<std::mutex> caller_lock(pool.caller);
+	real_context *context = real_context::get();
+	
+	{
+		std::lock_guard<std::mutex> lock(pool.mutex);
+		
+		while ((int)pool.threads.size() < n_threads - 1)
+		{
+			pool.threads.push_back(std::thread(work, (int)pool.threads.size() + 1, pool.generation));
+		}
+		pool.job = &job;
+		pool.n_threads = n_threads;
+		pool.precision = precision;
+		pool.max_reals = context != 0 ? context->max_reals : -1;
+		pool.n_running = n_threads - 1;
+		++pool.generation;
+	}
+	pool.start.notify_all();
+	job(0);
+	std::unique_lock<std::mutex> lock(pool.mutex);
+	while (pool.n_running > 0)
+	{
+		pool.done.wait(lock);
+	}
 }
 
 //
-// Calculate the sum by sorting the vector of addends by magnitude in
-// ascending order, and then using pairwise addition.
+// Pool thread i waits for each job after the generation it was started in,
+// and does its part of it if it's one of the first n_threads - 1 threads
+// (there can be more threads than that if n_threads has gone down).
 //
-real adder::calculate_sum()
+static void work(int i, long generation)
 {
-	std::vector<int> nums;
-	std::vector<real> sums;
-	real sum;
+	std::unique_ptr<real_context> context;
+	std::unique_lock<std::mutex> lock(pool.mutex);
 	
-	if (prev_sum == prev_sum)
+	while (true)
+	{
+		while (!pool.stopping && pool.generation == generation)
+		{
+			pool.start.wait(lock);
+		}
+		if (pool.stopping)
+		{
+			break;
+		}
+		generation = pool.generation;
+		if (i >= pool.n_threads)
+		{
+			continue;
+		}
+		lock.unlock();
+		if (context == 0 || context->precision != pool.precision || context->max_reals != pool.max_reals)
+		{
+			context.reset();
+			context.reset(new real_context(pool.precision, pool.max_reals));
+		}
+		(*pool.job)(i);
+		lock.lock();
+		--pool.n_running;
+		if (pool.n_running == 0)
+		{
+			pool.done.notify_one();
+		}
+	}
+}
+
+template <class real>
+adder<real>::adder()
+{
+	clear();
+}
+
+template <class real>
+void adder<real>::clear()
+{
+	sum = real::ZERO;
+	correction = real::ZERO;
+	chunk_sum = real::ZERO;
+	chunk_correction = real::ZERO;
+	chunk_length = 0;
+	addends.clear();
+}
+
+//
+// With one thread, a is added to the current chunk right away, and the chunk
+// is added to the total when it's full.  Otherwise, a is kept until there's
+// enough to give every thread a few chunks.
+//
+template <class real>
+void adder<real>::add(const real & a)
+{
+	if (reduction::n_threads == 1)
 	{
-		sum = prev_sum;
+		accumulate(chunk_sum, chunk_correction, a);
+		++chunk_length;
+		if (chunk_length == CHUNK_SIZE)
+		{
+			add_chunk(sum, correction, chunk_sum, chunk_correction);
+			chunk_sum = real::ZERO;
+			chunk_correction = real::ZERO;
+			chunk_length = 0;
+		}
 	}
 	else
 	{
-		std::sort(addends.begin(), addends.end(), calculate_sum_comparator);
-		nums.clear();
-		sums.clear();
+		addends.push_back(a);
+		if ((int)addends.size() == 4 * reduction::n_threads * CHUNK_SIZE)
+		{
+			reduce_addends();
+		}
+	}
+}
+
+//
+// The partial chunk at the end is added to copies of the total, so that the
+// adder can keep going afterward.  With more than one thread, the kept
+// addends that don't make a full chunk are summed into the (otherwise
+// unused) current chunk first.
+//
+template <class real>
+real adder<real>::calculate_sum()
+{
+	real x;
+	real x_correction;
+	
+	if (reduction::n_threads != 1)
+	{
+		reduce_addends();
+		chunk_sum = real::ZERO;
+		chunk_correction = real::ZERO;
 		for (int i = 0; i < (int)addends.size(); ++i)
 		{
-			nums.push_back(1);
-			sums.push_back(addends[i]);
-			while ((int)nums.size() > 1 && nums[(int)nums.size() - 2] == nums[(int)nums.size() - 1])
-			{
-				nums[(int)nums.size() - 2] = nums[(int)nums.size() - 2] + nums[(int)nums.size() - 1];
-				sums[(int)nums.size() - 2] = sums[(int)nums.size() - 2] + sums[(int)nums.size() - 1];
-				nums.pop_back();
-				sums.pop_back();
-			}
+			accumulate(chunk_sum, chunk_correction, addends[i]);
 		}
-		std::sort(sums.begin(), sums.end(), calculate_sum_comparator);
-		sum = real::ZERO;
-		for (int i = 0; i < (int)sums.size(); ++i)
+	}
+	x = sum;
+	x_correction = correction;
+	add_chunk(x, x_correction, chunk_sum, chunk_correction);
+	return x + x_correction;
+}
+
+//
+// This is Knuth's two-sum: s is the rounded sum, and h is exactly what was
+// lost rounding it, with no assumptions about which of x and a is bigger.
+// If the sum is infinite or NaN, h comes out NaN, and there's nothing to
+// correct anyway.
+//
+template <class real>
+void adder<real>::accumulate(real & x, real & x_correction, const real & a)
+{
+	s = x + a;
+	bv = s - x;
+	av = s - bv;
+	av = x - av;
+	bv = a - bv;
+	h = av + bv;
+	if (h == h)
+	{
+		x_correction += h;
+	}
+	std::swap(x, s);
+}
+
+template <class real>
+void adder<real>::add_chunk(real & x, real & x_correction, const real & y, const real & y_correction)
+{
+	accumulate(x, x_correction, y);
+	x_correction += y_correction;
+}
+
+//
+// Sums all of the full chunks that have been kept, with chunk i going to
+// thread i % n_threads, and adds them to the total.  What's left over (less
+// than a chunk) stays kept.
+//
+template <class real>
+void adder<real>::reduce_addends()
+{
+	std::vector<real> sums;
+	std::vector<real> corrections;
+	int n_chunks;
+	
+	n_chunks = (int)addends.size() / CHUNK_SIZE;
+	if (n_chunks == 0)
+	{
+		return;
+	}
+	sums.resize(n_chunks);
+	corrections.resize(n_chunks);
+	reduction::run([&](int i) { reduce_chunks(i, n_chunks, reduction::n_threads, sums, corrections); }, sum.get_precision());
+	for (int i = 0; i < n_chunks; ++i)
+	{
+		add_chunk(sum, correction, sums[i], corrections[i]);
+	}
+	addends.erase(addends.begin(), addends.begin() + n_chunks * CHUNK_SIZE);
+}
+
+//
+// The reals that a thread makes have to be made in its own context, so each
+// thread sums its chunks with an adder of its own.
+//
+template <class real>
+void adder<real>::reduce_chunks(int first, int n_chunks, int n_threads, std::vector<real> & sums, std::vector<real> & corrections)
+{
+	adder<real> chunk;
+	
+	for (int i = first; i < n_chunks; i = i + n_threads)
+	{
+		for (int j = i * CHUNK_SIZE; j < (i + 1) * CHUNK_SIZE; ++j)
 		{
-			sum = sum + sums[i];
+			chunk.accumulate(chunk.chunk_sum, chunk.chunk_correction, addends[j]);
 		}
+		sums[i] = chunk.chunk_sum;
+		corrections[i] = chunk.chunk_correction;
+		chunk.clear();
 	}
-	prev_sum = sum;
-	return sum;
 }
 
-complex_adder::complex_adder()
+template <class real>
+complex_adder<real>::complex_adder()
 {
 	real_adder.clear();
 	imag_adder.clear();
 }
 
-void complex_adder::clear()
+template <class real>
+void complex_adder<real>::clear()
 {
 	real_adder.clear();
 	imag_adder.clear();
 }
 
-void complex_adder::add(const complex & a)
+template <class real>
+void complex_adder<real>::add(const complex<real> & a)
 {
 	real_adder.add(a.a);
 	imag_adder.add(a.b);
 }
 
-complex complex_adder::calculate_sum()
+template <class real>
+complex<real> complex_adder<real>::calculate_sum()
 {
-	return real_adder.calculate_sum() + complex::I * imag_adder.calculate_sum();
+	return real_adder.calculate_sum() + complex<real>::I * imag_adder.calculate_sum();
 }
+
+#define INSTANTIATE_ADDER(real) \
+	template class adder<real>; \
+	template class complex_adder<real>;
+
+FOR_EACH_REAL_TYPE(INSTANTIATE_ADDER)
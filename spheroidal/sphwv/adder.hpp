@@ -28,31 +28,94 @@
 #ifndef ADDER_HPP
 #define ADDER_HPP
 
-#include "real.hpp"
+#include "complex.hpp"
+#include <functional>
+#include <string>
 #include <vector>
 
+//
+// adder keeps a running sum, and, separately, the sum of everything that was
+// rounded off of it, which is added back in at the end.  Each addition is
+// split exactly into its rounded result and its rounding error, so the sum
+// is as accurate as if it had been worked out with twice the precision and
+// then rounded, up to a term that's the square of the precision times the sum
+// of the magnitudes of the addends.  That's better than sorting the addends
+// and adding them pairwise, and it needs neither the addends nor a sort.
+//
+// The addends are summed in chunks of CHUNK_SIZE, and the chunks' sums (and
+// their corrections) are then added to the total, in order.  With more than
+// one thread (see reduction below), the addends are kept until there are a
+// few chunks' worth, and then the chunks are summed at the same time, each
+// by one thread.  Every chunk is summed the same way no matter which thread
+// does it, and the chunks are added to the total in the same order, so the
+// sum comes out the same, to the bit, for any number of threads.
+//
+template <class real>
 class adder
 {
 public:
+	static const int CHUNK_SIZE = 1024;
+	
+	real sum;
+	real correction;
+	real chunk_sum;
+	real chunk_correction;
+	int chunk_length;
 	std::vector<real> addends;
-	real prev_sum;
 	
 	adder();
 	void clear();
 	void add(const real & a);
 	real calculate_sum();
+	
+private:
+	real s;
+	real h;
+	real bv;
+	real av;
+	
+	void accumulate(real & x, real & x_correction, const real & a);
+	void add_chunk(real & x, real & x_correction, const real & y, const real & y_correction);
+	void reduce_addends();
+	void reduce_chunks(int first, int n_chunks, int n_threads, std::vector<real> & sums, std::vector<real> & corrections);
+};
+
+//
+// reduction::n_threads is the number of threads that every adder uses, which
+// main sets with -n_threads.  It's 1 by default, in which case the addends
+// aren't kept at all.
+//
+// The threads are a pool that's started the first time it's needed.  run
+// calls job(i) for each i from 0 to n_threads - 1 at the same time, with
+// job(0) on the calling thread and the rest on the pool's threads, and
+// returns when they're all done.  Each pool thread keeps a context (see
+// real_context in real.hpp) of the given precision between jobs, with the
+// same max_reals as the caller's context, so -max_memory limits each of them
+// the same way it limits the main thread.  A thread only has to make a new
+// context when the precision or the limit changes.  Only one job runs at a
+// time, so if two threads call run at once, the second one waits until the
+// first one's job is done.
+//
+class reduction
+{
+public:
+	static int n_threads;
+	
+	static bool parse(int & n_threads, const std::string & value);
+	static void run(const std::function<void (int)> & job, int precision);
 };
 
+template <class real>
 class complex_adder
 {
 public:
-	adder real_adder;
-	adder imag_adder;
+	adder<real> real_adder;
+	adder<real> imag_adder;
 	
 	complex_adder();
 	void clear();
-	void add(const complex & a);
-	complex calculate_sum();
+	void add(const complex<real> & a);
+	complex<real> calculate_sum();
 };
 
 #endif
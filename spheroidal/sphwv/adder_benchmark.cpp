@@ -0,0 +1,117 @@
+//
+// Copyright (c) 2014, Ross Adelman, Nail A. Gumerov, and Ramani Duraiswami
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include "adder.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include "real.hpp"
+#include <string>
+#include <vector>
+
+static double time_sum(real & x, const std::vector<real> & a, int n_threads);
+
+//
+// Adds up a to get x, with n_threads threads, and returns how long it took
+// (in seconds).
+//
+static double time_sum(real & x, const std::vector<real> & a, int n_threads)
+{
+	adder<real> x_adder;
+	std::chrono::steady_clock::time_point start;
+	
+	reduction::n_threads = n_threads;
+	start = std::chrono::steady_clock::now();
+	x_adder.clear();
+	for (int i = 0; i < (int)a.size(); ++i)
+	{
+		x_adder.add(a[i]);
+	}
+	x = x_adder.calculate_sum();
+	return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+//
+// This times adder (see adder.hpp) on sums of 10^2 up to 10^6 addends, with
+// one thread and with -n_threads threads, at the precision given by
+// -precision, and checks that the sums come out exactly the same.  The
+// addends are (-1)^i * u_i / (i + 1), with u_i pseudorandom in [0.5, 1), so
+// that there's some cancellation and the magnitudes spread out.
+//
+int main(int argc, char **argv)
+{
+	std::string argument;
+	std::string value;
+	int precision;
+	int n_threads;
+	std::vector<real> a;
+	unsigned long u;
+	real x1;
+	real xn;
+	double t1;
+	double tn;
+	
+	precision = 2000;
+	n_threads = 4;
+	for (int i = 1; i < argc; i = i + 2)
+	{
+		argument = std::string(argv[i]);
+		value = std::string(argv[i + 1]);
+		if (argument == "-precision")
+		{
+			precision = std::atoi(value.c_str());
+		}
+		else if (argument == "-n_threads")
+		{
+			if (!reduction::parse(n_threads, value))
+			{
+				std::cout << "invalid number of threads " << value << "..." << std::endl;
+				return 1;
+			}
+		}
+	}
+	real_context context(precision, -1);
+	std::printf("%10s %12s %12s %8s %10s\n", "addends", "1 thread", "threads", "speedup", "identical");
+	u = 1;
+	for (int n = 100; n <= 1000000; n = n * 10)
+	{
+		while ((int)a.size() < n)
+		{
+			u = u * 6364136223846793005UL + 1442695040888963407UL;
+			a.push_back(real(0.5 + (double)(u >> 11) / 18014398509481984.0) / real((int)a.size() + 1));
+			if ((int)a.size() % 2 == 0)
+			{
+				a.back() = -a.back();
+			}
+		}
+		t1 = time_sum(x1, a, 1);
+		tn = time_sum(xn, a, n_threads);
+		std::printf("%10d %10.3fms %10.3fms %8.2f %10s\n", n, 1000.0 * t1, 1000.0 * tn, t1 / tn, x1 == xn ? "yes" : "no");
+	}
+	return 0;
+}
@@ -0,0 +1,225 @@
+//
+// Copyright (c) 2014, Ross Adelman, Nail A. Gumerov, and Ramani Duraiswami
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include "allocator.hpp"
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <gmp.h>
+#include <iostream>
+#include <string>
+
+//
+// Blocks up to MAX_POOLED bytes are pooled, in size classes that are
+// GRANULE bytes apart.  Anything larger goes straight to malloc, since those
+// are rare (MPFR uses them for things like the cache of pi).
+//
+static const size_t GRANULE = 16;
+static const size_t MAX_POOLED = 4096;
+static const size_t N_CLASSES = MAX_POOLED / GRANULE + 1;
+static const size_t CHUNK_SIZE = 1 << 20;
+
+struct limb_pool
+{
+	void *free_lists[N_CLASSES];
+	char *chunk;
+	size_t chunk_left;
+};
+
+static size_t get_size_class(size_t size);
+static void *system_allocate(size_t size);
+static void *system_reallocate(void *ptr, size_t old_size, size_t new_size);
+static void system_free(void *ptr, size_t size);
+static void *pool_allocate(size_t size);
+static void *pool_reallocate(void *ptr, size_t old_size, size_t new_size);
+static void pool_free(void *ptr, size_t size);
+
+std::atomic<long> limb_allocator::n_allocations(0);
+std::atomic<long> limb_allocator::n_reallocations(0);
+std::atomic<long> limb_allocator::n_frees(0);
+std::atomic<long> limb_allocator::n_chunks(0);
+
+//
+// Chunks are never given back.  A block can be freed by a different thread
+// than the one that allocated it, in which case it just joins the free list
+// of the thread that freed it, so the chunks have to outlive every thread.
+//
+static thread_local limb_pool pool;
+
+void limb_allocator::begin(int kind)
+{
+	if (kind == POOL)
+	{
+		mp_set_memory_functions(pool_allocate, pool_reallocate, pool_free);
+	}
+	else
+	{
+		mp_set_memory_functions(system_allocate, system_reallocate, system_free);
+	}
+}
+
+bool limb_allocator::parse(int & kind, const std::string & value)
+{
+	if (value == "system")
+	{
+		kind = SYSTEM;
+	}
+	else if (value == "pool")
+	{
+		kind = POOL;
+	}
+	else
+	{
+		return false;
+	}
+	return true;
+}
+
+void limb_allocator::print_statistics()
+{
+	std::cout << "limb_allocator: " << n_allocations << " allocations, " << n_reallocations << " reallocations, " << n_frees << " frees, " << n_chunks << " chunks" << std::endl;
+}
+
+//
+// Every block has to be big enough to hold the free list pointer, even if
+// it's allocated with a size of 0.
+//
+static size_t get_size_class(size_t size)
+{
+	if (size == 0)
+	{
+		return 1;
+	}
+	return (size + GRANULE - 1) / GRANULE;
+}
+
+static void *system_allocate(size_t size)
+{
+	void *ptr;
+	
+	++limb_allocator::n_allocations;
+	ptr = std::malloc(size);
+	if (ptr == 0)
+	{
+		std::cout << "error: out of memory" << std::endl;
+		exit(1);
+	}
+	return ptr;
+}
+
+static void *system_reallocate(void *ptr, size_t old_size, size_t new_size)
+{
+	++limb_allocator::n_reallocations;
+	ptr = std::realloc(ptr, new_size);
+	if (ptr == 0)
+	{
+		std::cout << "error: out of memory" << std::endl;
+		exit(1);
+	}
+	return ptr;
+}
+
+static void system_free(void *ptr, size_t size)
+{
+	++limb_allocator::n_frees;
+	std::free(ptr);
+}
+
+static void *pool_allocate(size_t size)
+{
+	size_t i;
+	void *ptr;
+	
+	if (size > MAX_POOLED)
+	{
+		return system_allocate(size);
+	}
+	++limb_allocator::n_allocations;
+	i = get_size_class(size);
+	if (pool.free_lists[i] != 0)
+	{
+		// The first word of a free block points to the next one.
+		ptr = pool.free_lists[i];
+		pool.free_lists[i] = *(void **)ptr;
+		return ptr;
+	}
+	if (pool.chunk_left < i * GRANULE)
+	{
+		// The rest of the old chunk is wasted, but it's at most MAX_POOLED
+		// bytes per chunk.
+		pool.chunk = (char *)std::malloc(CHUNK_SIZE);
+		if (pool.chunk == 0)
+		{
+			std::cout << "error: out of memory" << std::endl;
+			exit(1);
+		}
+		pool.chunk_left = CHUNK_SIZE;
+		++limb_allocator::n_chunks;
+	}
+	ptr = pool.chunk;
+	pool.chunk = pool.chunk + i * GRANULE;
+	pool.chunk_left = pool.chunk_left - i * GRANULE;
+	return ptr;
+}
+
+static void *pool_reallocate(void *ptr, size_t old_size, size_t new_size)
+{
+	void *new_ptr;
+	
+	if (old_size > MAX_POOLED && new_size > MAX_POOLED)
+	{
+		return system_reallocate(ptr, old_size, new_size);
+	}
+	++limb_allocator::n_reallocations;
+	if (old_size <= MAX_POOLED && new_size <= MAX_POOLED && get_size_class(old_size) == get_size_class(new_size))
+	{
+		return ptr;
+	}
+	// Moving a block is counted as a reallocation, not as an allocation and
+	// a free.
+	new_ptr = pool_allocate(new_size);
+	--limb_allocator::n_allocations;
+	std::memcpy(new_ptr, ptr, old_size < new_size ? old_size : new_size);
+	pool_free(ptr, old_size);
+	--limb_allocator::n_frees;
+	return new_ptr;
+}
+
+static void pool_free(void *ptr, size_t size)
+{
+	size_t i;
+	
+	if (size > MAX_POOLED)
+	{
+		system_free(ptr, size);
+		return;
+	}
+	++limb_allocator::n_frees;
+	i = get_size_class(size);
+	*(void **)ptr = pool.free_lists[i];
+	pool.free_lists[i] = ptr;
+}
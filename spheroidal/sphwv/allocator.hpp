@@ -0,0 +1,63 @@
+//
+// Copyright (c) 2014, Ross Adelman, Nail A. Gumerov, and Ramani Duraiswami
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#ifndef ALLOCATOR_HPP
+#define ALLOCATOR_HPP
+
+#include <atomic>
+#include <string>
+
+//
+// limb_allocator decides where MPFR (and GMP underneath it) gets its memory
+// from, which is mostly the limbs of the reals.  With SYSTEM, every limb
+// array is its own malloc, like before.  With POOL, blocks are rounded up to
+// a size class, and freed blocks go onto a per-class free list, so that the
+// temporaries that are constantly created and destroyed reuse the same few
+// blocks.  New blocks are carved out of large chunks with a bump pointer.
+// The free lists and the current chunk are per-thread, so there's no locking.
+// Either way, the allocations are counted.
+//
+// The allocator has to be chosen before any reals are allocated, which is
+// why main chooses it before it makes the first real_context.
+//
+class limb_allocator
+{
+public:
+	static const int SYSTEM = 0;
+	static const int POOL = 1;
+	
+	static std::atomic<long> n_allocations;
+	static std::atomic<long> n_reallocations;
+	static std::atomic<long> n_frees;
+	static std::atomic<long> n_chunks;
+	
+	static void begin(int kind);
+	static bool parse(int & kind, const std::string & value);
+	static void print_statistics();
+};
+
+#endif
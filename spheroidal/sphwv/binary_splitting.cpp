@@ -0,0 +1,106 @@
+//
+// Copyright (c) 2014, Ross Adelman, Nail A. Gumerov, and Ramani Duraiswami
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include "binary_splitting.hpp"
+#include <deque>
+#include <functional>
+#include <gmp.h>
+#include "real.hpp"
+#include "real_types.hpp"
+
+//
+// Below LEAF_SIZE factors, they're just multiplied in one at a time, since
+// they're small enough that splitting wouldn't save anything.
+//
+void binary_splitting::calculate_product(mpz_ptr x, const std::function<long (long)> & f, long j0, long j1)
+{
+	const long LEAF_SIZE = 8;
+	long j;
+	mpz_t y;
+	
+	if (j1 - j0 <= LEAF_SIZE)
+	{
+		mpz_set_ui(x, 1);
+		for (j = j0; j < j1; ++j)
+		{
+			mpz_mul_si(x, x, f(j));
+		}
+		return;
+	}
+	j = j0 + (j1 - j0) / 2;
+	calculate_product(x, f, j0, j);
+	mpz_init(y);
+	calculate_product(y, f, j, j1);
+	mpz_mul(x, x, y);
+	mpz_clear(y);
+}
+
+template <class real>
+factor_table<real>::factor_table() : e(0)
+{
+	mpz_init(a);
+}
+
+template <class real>
+factor_table<real>::~factor_table()
+{
+	mpz_clear(a);
+}
+
+template <class real>
+void factor_table<real>::begin(mpz_srcptr first, long ee, const ratio_function & rratio)
+{
+	factors.clear();
+	mpz_set(a, first);
+	e = ee;
+	ratio = rratio;
+}
+
+template <class real>
+const real & factor_table<real>::get(long i)
+{
+	long p;
+	unsigned long q;
+	
+	while ((long)factors.size() <= i)
+	{
+		if (!factors.empty())
+		{
+			ratio(p, q, (long)factors.size());
+			mpz_mul_si(a, a, p);
+			mpz_divexact_ui(a, a, q);
+		}
+		factors.push_back(real());
+		set_z_2exp(factors.back(), a, e);
+	}
+	return factors[i];
+}
+
+#define INSTANTIATE_FACTOR_TABLE(real) \
+	template class factor_table<real>;
+
+FOR_EACH_REAL_TYPE(INSTANTIATE_FACTOR_TABLE)
@@ -0,0 +1,87 @@
+//
+// Copyright (c) 2014, Ross Adelman, Nail A. Gumerov, and Ramani Duraiswami
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#ifndef BINARY_SPLITTING_HPP
+#define BINARY_SPLITTING_HPP
+
+#include <deque>
+#include <functional>
+#include <gmp.h>
+
+//
+// binary_splitting::calculate_product sets x to the product of the integers
+// f(j), for j from j0 to j1 - 1, exactly.  It splits the range in half, works
+// out the product of each half the same way, and multiplies the two, so that
+// the numbers being multiplied are always about the same size.  That takes
+// O(M(N) log N) for a product of N bits, instead of the O(N^2) of multiplying
+// the factors in one at a time.
+//
+class binary_splitting
+{
+public:
+	static void calculate_product(mpz_ptr x, const std::function<long (long)> & f, long j0, long j1);
+};
+
+//
+// factor_table keeps the factors a_i that a series multiplies its terms by,
+// when a_0 is an integer times 2^e and each a_i is a_(i - 1) * p_i / q_i for
+// integers p_i and q_i such that a_i is still an integer times 2^e.  That's
+// the case for the factorials and Pochhammer symbols in the sums for N, F,
+// and the c_2k's, whose a_0's are worked out with calculate_product.
+//
+// The integer part is kept exactly, so each factor is rounded once, when
+// it's put in the table, instead of every step of the recurrence adding its
+// own rounding, and a step is a multiplication and an exact division of an
+// integer by a word instead of a full-precision division.
+//
+// begin starts the table over with a_0 = first * 2^e, and ratio(p, q, i) sets
+// p and q to p_i and q_i (with q_i > 0).  The table grows whenever a factor
+// that's not in it yet is asked for, and the factors are kept in a deque, so
+// the references that get returns stay good while it grows.
+//
+template <class real>
+class factor_table
+{
+public:
+	typedef std::function<void (long & p, unsigned long & q, long i)> ratio_function;
+	
+	factor_table();
+	~factor_table();
+	void begin(mpz_srcptr first, long ee, const ratio_function & rratio);
+	const real & get(long i);
+	
+private:
+	std::deque<real> factors;
+	mpz_t a;
+	long e;
+	ratio_function ratio;
+	
+	factor_table(const factor_table & table);
+	factor_table & operator =(const factor_table & table);
+};
+
+#endif
@@ -0,0 +1,150 @@
+//
+// Copyright (c) 2014, Ross Adelman, Nail A. Gumerov, and Ramani Duraiswami
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include "binary_splitting.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <gmp.h>
+#include <iostream>
+#include "real.hpp"
+#include <string>
+#include <vector>
+
+static double time_recurrence(std::vector<real> & a, int m, int r0, int n_dr);
+static double time_table(std::vector<real> & a, int m, int r0, int n_dr);
+
+//
+// Works out the factors (2m + r)! / r!, for r = r0, r0 + 2, ..., up to n_dr,
+// the way the sums for N and F used to, with a full-precision multiplication
+// and division for each, and returns how long it took (in seconds).
+//
+static double time_recurrence(std::vector<real> & a, int m, int r0, int n_dr)
+{
+	std::chrono::steady_clock::time_point start;
+	real x;
+	
+	start = std::chrono::steady_clock::now();
+	a.clear();
+	for (real r = real(r0); r <= real(n_dr - 1); r += 2)
+	{
+		if (r > real(r0))
+		{
+			x *= ((2 * real(m) + r - 1) * (2 * real(m) + r)) / ((r - 1) * r);
+		}
+		else
+		{
+			x = factorial(2 * real(m) + r);
+		}
+		a.push_back(x);
+	}
+	return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+//
+// Works out the same factors with a factor_table (see binary_splitting.hpp),
+// and returns how long it took (in seconds).
+//
+static double time_table(std::vector<real> & a, int m, int r0, int n_dr)
+{
+	std::chrono::steady_clock::time_point start;
+	factor_table<real> table;
+	mpz_t a0;
+	
+	start = std::chrono::steady_clock::now();
+	mpz_init(a0);
+	binary_splitting::calculate_product(a0, [](long j) { return j; }, 1, 2 * m + r0 + 1);
+	table.begin(a0, 0, [=](long & p, unsigned long & q, long i)
+	{
+		long r;
+		
+		r = r0 + 2 * i;
+		p = (2 * (long)m + r - 1) * (2 * (long)m + r);
+		q = (unsigned long)((r - 1) * r);
+	});
+	mpz_clear(a0);
+	a.clear();
+	for (int i = 0; r0 + 2 * i <= n_dr - 1; ++i)
+	{
+		a.push_back(table.get(i));
+	}
+	return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+//
+// This times the factors of the sums for N and F, (2m + r)! / r!, worked out
+// with the old recurrence and with a factor_table, for m up to 100, both
+// parities of n - m, and n_dr in the thousands, at the precision given by
+// -precision.  It also prints the largest relative difference between the
+// two, which is the rounding error that the recurrence built up, since the
+// table's factors are only rounded once.
+//
+int main(int argc, char **argv)
+{
+	const int MS[] = {0, 10, 50, 100};
+	std::string argument;
+	std::string value;
+	int precision;
+	int m;
+	std::vector<real> a_recurrence;
+	std::vector<real> a_table;
+	double t_recurrence;
+	double t_table;
+	real max_diff;
+	
+	precision = 500;
+	for (int i = 1; i < argc; i = i + 2)
+	{
+		argument = std::string(argv[i]);
+		value = std::string(argv[i + 1]);
+		if (argument == "-precision")
+		{
+			precision = std::atoi(value.c_str());
+		}
+	}
+	real_context context(precision, -1);
+	std::printf("%5s %5s %7s %12s %12s %8s %12s\n", "m", "n - m", "n_dr", "recurrence", "table", "speedup", "difference");
+	for (int i = 0; i < (int)(sizeof(MS) / sizeof(MS[0])); ++i)
+	{
+		m = MS[i];
+		for (int r0 = 0; r0 <= 1; ++r0)
+		{
+			for (int n_dr = 1000; n_dr <= 8000; n_dr = n_dr * 2)
+			{
+				t_recurrence = time_recurrence(a_recurrence, m, r0, n_dr);
+				t_table = time_table(a_table, m, r0, n_dr);
+				max_diff = real::ZERO;
+				for (int j = 0; j < (int)a_table.size(); ++j)
+				{
+					max_diff = max(max_diff, abs((a_recurrence[j] - a_table[j]) / a_table[j]));
+				}
+				std::printf("%5d %5s %7d %10.3fms %10.3fms %8.2f %12s\n", m, r0 == 0 ? "even" : "odd", n_dr, 1000.0 * t_recurrence, 1000.0 * t_table, t_recurrence / t_table, max_diff.get_string(3).c_str());
+			}
+		}
+	}
+	return 0;
+}
@@ -0,0 +1,134 @@
+//
+// Copyright (c) 2014, Ross Adelman, Nail A. Gumerov, and Ramani Duraiswami
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include "coefficient_table.hpp"
+#include "common_spheroidal.hpp"
+#include <deque>
+#include "real.hpp"
+#include "real_types.hpp"
+
+template <class real>
+static real calculate_alphar(const real & c, const real & m, const real & r);
+template <class real>
+static real calculate_betar(const real & c, const real & m, const real & r);
+template <class real>
+static real calculate_gammar(const real & c, const real & m, const real & r);
+
+template <class real>
+static real calculate_alphar(const real & c, const real & m, const real & r)
+{
+	return (((2 * m + r + 2) * (2 * m + r + 1)) / ((2 * m + 2 * r + 5) * (2 * m + 2 * r + 3))) * calculate_c_squared(c);
+}
+
+template <class real>
+static real calculate_betar(const real & c, const real & m, const real & r)
+{
+	return (m + r) * (m + r + 1) + ((2 * (m + r) * (m + r + 1) - 2 * m * m - 1) / ((2 * m + 2 * r - 1) * (2 * m + 2 * r + 3))) * calculate_c_squared(c);
+}
+
+template <class real>
+static real calculate_gammar(const real & c, const real & m, const real & r)
+{
+	return ((r * (r - 1)) / ((2 * m + 2 * r - 3) * (2 * m + 2 * r - 1))) * calculate_c_squared(c);
+}
+
+template <class real>
+coefficient_table<real>::coefficient_table(const real & cc, const real & mm) : c(cc), m(mm)
+{
+}
+
+template <class real>
+const real & coefficient_table<real>::get_alphar(const real & r)
+{
+	return get_entry(r).alphar;
+}
+
+template <class real>
+const real & coefficient_table<real>::get_betar(const real & r)
+{
+	return get_entry(r).betar;
+}
+
+template <class real>
+const real & coefficient_table<real>::get_gammar(const real & r)
+{
+	return get_entry(r).gammar;
+}
+
+template <class real>
+const real & coefficient_table<real>::get_betarm(const real & r)
+{
+	return get_entry(r).betarm;
+}
+
+template <class real>
+const real & coefficient_table<real>::get_gammarm(const real & r)
+{
+	return get_entry(r).betar;
+}
+
+template <class real>
+const typename coefficient_table<real>::entry & coefficient_table<real>::get_entry(const real & r)
+{
+	if (r >= real::ZERO)
+	{
+		while ((int)entries.size() <= gzbi(r))
+		{
+			entries.push_back(entry());
+			calculate_entry(entries.back(), real((int)entries.size() - 1));
+		}
+		return entries[gzbi(r)];
+	}
+	else
+	{
+		while ((int)neg_entries.size() <= gnobi(r))
+		{
+			neg_entries.push_back(entry());
+			calculate_entry(neg_entries.back(), real(-(int)neg_entries.size()));
+		}
+		return neg_entries[gnobi(r)];
+	}
+}
+
+//
+// beta_r^m is gamma_r * alpha_(r - 2), which is worked out from scratch
+// instead of from the table, since alpha_(r - 2) might be on the other side
+// of r = 0.
+//
+template <class real>
+void coefficient_table<real>::calculate_entry(entry & e, const real & r)
+{
+	e.alphar = calculate_alphar<real>(c, m, r);
+	e.betar = calculate_betar<real>(c, m, r);
+	e.gammar = calculate_gammar<real>(c, m, r);
+	e.betarm = e.gammar * calculate_alphar<real>(c, m, r - 2);
+}
+
+#define INSTANTIATE_COEFFICIENT_TABLE(real) \
+	template class coefficient_table<real>;
+
+FOR_EACH_REAL_TYPE(INSTANTIATE_COEFFICIENT_TABLE)
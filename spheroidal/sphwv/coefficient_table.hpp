@@ -0,0 +1,75 @@
+//
+// Copyright (c) 2014, Ross Adelman, Nail A. Gumerov, and Ramani Duraiswami
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#ifndef COEFFICIENT_TABLE_HPP
+#define COEFFICIENT_TABLE_HPP
+
+#include <deque>
+
+//
+// coefficient_table keeps alpha_r, beta_r, gamma_r, and beta_r^m (the
+// coefficients of the recurrence for the d_r's) for one c and m, so that
+// they're only worked out once, no matter how many times they're needed.
+// calculate_lambdamn, for example, works out U for dozens of lambdas, and
+// only lambda changes between them.  (gamma_r^m is beta_r, so get_gammarm is
+// get_betar.)
+//
+// The table starts out empty, and grows (in either direction from r = 0)
+// whenever a coefficient that's not in it yet is asked for.  The coefficients
+// are kept in deques, so the references that the getters return stay good
+// while the table grows.
+//
+template <class real>
+class coefficient_table
+{
+public:
+	coefficient_table(const real & cc, const real & mm);
+	const real & get_alphar(const real & r);
+	const real & get_betar(const real & r);
+	const real & get_gammar(const real & r);
+	const real & get_betarm(const real & r);
+	const real & get_gammarm(const real & r);
+	
+private:
+	struct entry
+	{
+		real alphar;
+		real betar;
+		real gammar;
+		real betarm;
+	};
+	
+	real c;
+	real m;
+	std::deque<entry> entries;
+	std::deque<entry> neg_entries;
+	
+	const entry & get_entry(const real & r);
+	void calculate_entry(entry & e, const real & r);
+};
+
+#endif
@@ -25,13 +25,29 @@
 // POSSIBILITY OF SUCH DAMAGE.
 //
 
+#include "acceleration.hpp"
+#include "adder.hpp"
+#include "allocator.hpp"
 #include "common_main.hpp"
 #include "common_spheroidal.hpp"
+#include "complex.hpp"
 #include "io.hpp"
 #include <iostream>
+#include "mixed_precision.hpp"
 #include "real.hpp"
+#include "real_types.hpp"
+#include "root_finding.hpp"
 #include <string>
 
+template <class real>
+static int run(int argc, char **argv);
+
+//
+// lambda starts from the value in the lambda_approx file, if there is one
+// (from pro_ or obl_calculate_lambdamn_approx.m), and otherwise from
+// calculate_lambdamn_approx.
+//
+template <class real>
 bool save_lambdamn(bool verbose, const real & c, const real & m, const real & n)
 {
 	real lambda_approx;
@@ -39,8 +55,7 @@ bool save_lambdamn(bool verbose, const real & c, const real & m, const real & n)
 	
 	if (!open_data(lambda_approx, generate_name(c, m, n, "lambda_approx")))
 	{
-		std::cout << "can't open lambda_approx..." << std::endl;
-		return false;
+		lambda_approx = calculate_lambdamn_approx(verbose, c, m, n);
 	}
 	calculate_lambdamn(lambda, verbose, c, m, n, lambda_approx);
 	if (!save_data(generate_name(c, m, n, "lambda"), lambda))
@@ -56,6 +71,30 @@ bool save_lambdamn(bool verbose, const real & c, const real & m, const real & n)
 	return true;
 }
 
+//
+// lambda_all holds lambda for n = m, m + 1, ..., m + n_max - 1, all worked out
+// in one go by calculate_lambdamn_all.  It's named as if n were m.
+//
+template <class real>
+bool save_lambdamn_all(bool verbose, const real & c, const real & m, const real & n_max)
+{
+	std::vector<real> lambda;
+	
+	calculate_lambdamn_all(lambda, verbose, c, m, n_max);
+	if (!save_data(generate_name(c, m, m, "lambda_all"), lambda))
+	{
+		std::cout << "can't save lambda_all..." << std::endl;
+		return false;
+	}
+	if (!save_log_abs_data(generate_name(c, m, m, "log_abs_lambda_all"), lambda))
+	{
+		std::cout << "can't save log_abs_lambda_all..." << std::endl;
+		return false;
+	}
+	return true;
+}
+
+template <class real>
 bool open_lambdamn(real & lambda, const real & c, const real & m, const real & n)
 {
 	if (!open_data(lambda, generate_name(c, m, n, "lambda")))
@@ -66,6 +105,7 @@ bool open_lambdamn(real & lambda, const real & c, const real & m, const real & n
 	return true;
 }
 
+template <class real>
 bool save_drmn(bool verbose, const real & c, const real & m, const real & n, real & n_dr, const real & dr_min)
 {
 	real lambda;
@@ -89,6 +129,7 @@ bool save_drmn(bool verbose, const real & c, const real & m, const real & n, rea
 	return true;
 }
 
+template <class real>
 bool open_drmn(real & n_dr, std::vector<real> & dr, const real & c, const real & m, const real & n)
 {
 	if (!open_data(dr, generate_name(c, m, n, "dr")))
@@ -100,6 +141,7 @@ bool open_drmn(real & n_dr, std::vector<real> & dr, const real & c, const real &
 	return true;
 }
 
+template <class real>
 bool save_drmn_neg(bool verbose, const real & c, const real & m, const real & n, real & n_dr_neg, const real & dr_neg_min)
 {
 	real lambda;
@@ -126,6 +168,7 @@ bool save_drmn_neg(bool verbose, const real & c, const real & m, const real & n,
 	return true;
 }
 
+template <class real>
 bool open_drmn_neg(real & n_dr_neg, std::vector<real> & dr_neg, const real & c, const real & m, const real & n)
 {
 	if (!open_data(dr_neg, generate_name(c, m, n, "dr_neg")))
@@ -137,6 +180,7 @@ bool open_drmn_neg(real & n_dr_neg, std::vector<real> & dr_neg, const real & c,
 	return true;
 }
 
+template <class real>
 bool save_Nmn(bool verbose, const real & c, const real & m, const real & n)
 {
 	real lambda;
@@ -163,6 +207,7 @@ bool save_Nmn(bool verbose, const real & c, const real & m, const real & n)
 	return true;
 }
 
+template <class real>
 bool open_Nmn(real & N, const real & c, const real & m, const real & n)
 {
 	if (!open_data(N, generate_name(c, m, n, "N")))
@@ -173,6 +218,7 @@ bool open_Nmn(real & N, const real & c, const real & m, const real & n)
 	return true;
 }
 
+template <class real>
 bool save_Fmn(bool verbose, const real & c, const real & m, const real & n)
 {
 	real lambda;
@@ -199,6 +245,7 @@ bool save_Fmn(bool verbose, const real & c, const real & m, const real & n)
 	return true;
 }
 
+template <class real>
 bool open_Fmn(real & F, const real & c, const real & m, const real & n)
 {
 	if (!open_data(F, generate_name(c, m, n, "F")))
@@ -209,6 +256,7 @@ bool open_Fmn(real & F, const real & c, const real & m, const real & n)
 	return true;
 }
 
+template <class real>
 bool save_kmn1(bool verbose, const real & c, const real & m, const real & n)
 {
 	real n_dr;
@@ -235,6 +283,7 @@ bool save_kmn1(bool verbose, const real & c, const real & m, const real & n)
 	return true;
 }
 
+template <class real>
 bool open_kmn1(real & k1, const real & c, const real & m, const real & n)
 {
 	if (!open_data(k1, generate_name(c, m, n, "k1")))
@@ -245,6 +294,7 @@ bool open_kmn1(real & k1, const real & c, const real & m, const real & n)
 	return true;
 }
 
+template <class real>
 bool save_kmn2(bool verbose, const real & c, const real & m, const real & n)
 {
 	real lambda;
@@ -276,6 +326,7 @@ bool save_kmn2(bool verbose, const real & c, const real & m, const real & n)
 	return true;
 }
 
+template <class real>
 bool open_kmn2(real & k2, const real & c, const real & m, const real & n)
 {
 	if (!open_data(k2, generate_name(c, m, n, "k2")))
@@ -286,6 +337,7 @@ bool open_kmn2(real & k2, const real & c, const real & m, const real & n)
 	return true;
 }
 
+template <class real>
 bool save_c2kmn(bool verbose, const real & c, const real & m, const real & n, real & n_c2k, const real & c2k_min)
 {
 	real lambda;
@@ -313,6 +365,7 @@ bool save_c2kmn(bool verbose, const real & c, const real & m, const real & n, re
 	return true;
 }
 
+template <class real>
 bool open_c2kmn(real & n_c2k, std::vector<real> & c2k, const real & c, const real & m, const real & n)
 {
 	if (!open_data(c2k, generate_name(c, m, n, "c2k")))
@@ -324,6 +377,7 @@ bool open_c2kmn(real & n_c2k, std::vector<real> & c2k, const real & c, const rea
 	return true;
 }
 
+template <class real>
 bool save_Smn1(bool verbose, const real & c, const real & m, const real & n, const real & a, const real & b, const real & d, const std::string & arg_type, int p)
 {
 	real n_dr;
@@ -356,11 +410,11 @@ bool save_Smn1(bool verbose, const real & c, const real & m, const real & n, con
 			eta = cos(i * real::PI);
 		}
 		calculate_Smn1_1(S1_1, S1p_1, verbose, c, m, n, n_dr, dr, eta);
-		S1_1 = S1_1 / pow(N, real::ONE / real::TWO);
-		S1p_1 = S1p_1 / pow(N, real::ONE / real::TWO);
+		S1_1 = S1_1 / sqrt(N);
+		S1p_1 = S1p_1 / sqrt(N);
 		calculate_Smn1_2(S1_2, S1p_2, verbose, c, m, n, n_c2k, c2k, eta);
-		S1_2 = S1_2 / pow(N, real::ONE / real::TWO);
-		S1p_2 = S1p_2 / pow(N, real::ONE / real::TWO);
+		S1_2 = S1_2 / sqrt(N);
+		S1p_2 = S1p_2 / sqrt(N);
 		S1_log_abs_difference = log(abs(S1_1 - S1_2));
 		S1p_log_abs_difference = log(abs(S1p_1 - S1p_2));
 		std::cout << i.get_string(p) << ","
@@ -372,12 +426,57 @@ bool save_Smn1(bool verbose, const real & c, const real & m, const real & n, con
 	return true;
 }
 
+//
+// Works out the constants of a fixed_real, and then does everything with it.
+//
+template <class real>
+static int run(int argc, char **argv)
+{
+	real::begin();
+	complex<real>::begin();
+	return parse_args<real>(argc, argv);
+}
+
 //
 // This is the main entrypoint of the program, both for pro_sphwv and
-// obl_sphwv.  It sets the default precision in MPFR and the maximum number of
-// reals that can be used at any one time based on the -max_memory argument.
-// At the end, it calls parse_args, which is defined differently for pro_sphwv
-// and obl_sphwv.
+// obl_sphwv.  It makes the main thread's context (see real_context in
+// real.hpp), with the precision and the maximum number of reals that can be
+// used at any one time based on the -max_memory argument.  At the end, it
+// calls parse_args, which is defined differently for pro_sphwv and obl_sphwv.
+//
+// Everything is done with the fixed_real (see real_types.hpp) whose precision
+// is exactly the one that was asked for, and with the usual reals if there
+// isn't one, so a run is never done at more bits than it asked for.
+//
+// -allocator picks where the limbs of the reals come from (see
+// allocator.hpp), and is system by default.  With -verbose y, the allocation
+// counts are printed at the end.
+//
+// -backend picks what the reals are made of.  It's mpfr by default, which
+// does the above, and double, long_double, float128, double_double, or
+// extended_double uses a native_real (see native_real.hpp) of that type
+// instead, whose precision is fixed and ignores -precision.
+//
+// -n_threads is how many threads the sums (see adder.hpp) are split across.
+// It's 1 by default, and doesn't change the results.
+//
+// -acceleration picks the sequence acceleration (see acceleration.hpp) that
+// the slowly converging series and continued fractions use, and is none by
+// default.  wynn, levin_u, or levin_t can stop them early, and, with
+// -verbose y, how many terms that saved is printed at the end.
+//
+// -mixed_precision y rounds the products in the tails of the series (see
+// mixed_precision.hpp) to only the bits that can still change their sums.
+// It's n by default.
+//
+// -root_finder picks how lambda is narrowed down once it's bracketed (see
+// root_finding.hpp), and is false_position by default.  illinois or
+// anderson_bjorck usually need fewer evaluations of U, and, with -verbose y,
+// how many there were is printed at the end.
+//
+// -precision_ladder y finds lambda at 106 bits, then 212, 424, and so on,
+// before the full precision (see root_finding.hpp), so that only the last
+// few evaluations of U are at the full precision.  It's n by default.
 //
 int main(int argc, char **argv)
 {
@@ -387,9 +486,16 @@ int main(int argc, char **argv)
 	bool max_memory_entered;
 	int precision;
 	bool precision_entered;
+	int allocator;
+	std::string backend;
+	bool verbose;
+	int result;
 	
 	max_memory_entered = false;
 	precision_entered = false;
+	allocator = limb_allocator::SYSTEM;
+	backend = "mpfr";
+	verbose = false;
 	for (int i = 1; i < argc; i = i + 2)
 	{
 		argument = std::string(argv[i]);
@@ -404,13 +510,138 @@ int main(int argc, char **argv)
 			precision = std::atoi(value.c_str());
 			precision_entered = true;
 		}
+		else if (argument == "-allocator")
+		{
+			if (!limb_allocator::parse(allocator, value))
+			{
+				std::cout << "unknown allocator " << value << "..." << std::endl;
+				return 1;
+			}
+		}
+		else if (argument == "-backend")
+		{
+			if (value != "mpfr" && value != "double" && value != "long_double" && value != "float128" && value != "double_double" && value != "extended_double")
+			{
+				std::cout << "unknown backend " << value << "..." << std::endl;
+				return 1;
+			}
+			backend = value;
+		}
+		else if (argument == "-n_threads")
+		{
+			if (!reduction::parse(reduction::n_threads, value))
+			{
+				std::cout << "invalid number of threads " << value << "..." << std::endl;
+				return 1;
+			}
+		}
+		else if (argument == "-acceleration")
+		{
+			if (!acceleration::parse(acceleration::method, value))
+			{
+				std::cout << "unknown acceleration " << value << "..." << std::endl;
+				return 1;
+			}
+		}
+		else if (argument == "-mixed_precision")
+		{
+			mixed_precision::enabled = value == "y";
+		}
+		else if (argument == "-root_finder")
+		{
+			if (!root_finding::parse(root_finding::method, value))
+			{
+				std::cout << "unknown root finder " << value << "..." << std::endl;
+				return 1;
+			}
+		}
+		else if (argument == "-precision_ladder")
+		{
+			root_finding::precision_ladder = value == "y";
+		}
+		else if (argument == "-verbose")
+		{
+			verbose = value == "y";
+		}
 	}
 	if (!max_memory_entered || !precision_entered)
 	{
 		std::cout << "no value of max_memory and/or precision was entered..." << std::endl;
 		return 1;
 	}
-	real::begin(precision, (int)((double)max_memory * (8000000.0 / (double)precision)));
-	complex::begin();
-	return parse_args(argc, argv);
+	limb_allocator::begin(allocator);
+	real_context context(precision, (int)((double)max_memory * (8000000.0 / (double)precision)));
+	complex<real>::begin();
+	if (backend == "double")
+	{
+		result = run<native_real<double> >(argc, argv);
+	}
+	else if (backend == "long_double")
+	{
+		result = run<native_real<long double> >(argc, argv);
+	}
+	else if (backend == "float128")
+	{
+		result = run<native_real<__float128> >(argc, argv);
+	}
+	else if (backend == "double_double")
+	{
+		result = run<native_real<double_double> >(argc, argv);
+	}
+	else if (backend == "extended_double")
+	{
+		result = run<native_real<extended_double> >(argc, argv);
+	}
+	else if (precision == 300)
+	{
+		result = run<fixed_real<300> >(argc, argv);
+	}
+	else if (precision == 500)
+	{
+		result = run<fixed_real<500> >(argc, argv);
+	}
+	else if (precision == 1000)
+	{
+		result = run<fixed_real<1000> >(argc, argv);
+	}
+	else
+	{
+		result = parse_args<real>(argc, argv);
+	}
+	if (verbose)
+	{
+		limb_allocator::print_statistics();
+		if (acceleration::method != acceleration::NONE)
+		{
+			acceleration::print_statistics();
+		}
+		if (mixed_precision::enabled)
+		{
+			mixed_precision::print_statistics();
+		}
+		root_finding::print_statistics();
+	}
+	return result;
 }
+
+#define INSTANTIATE_COMMON_MAIN(real) \
+	template bool save_lambdamn<real>(bool verbose, const real & c, const real & m, const real & n); \
+	template bool open_lambdamn<real>(real & lambda, const real & c, const real & m, const real & n); \
+	template bool save_lambdamn_all<real>(bool verbose, const real & c, const real & m, const real & n_max); \
+	template bool save_drmn<real>(bool verbose, const real & c, const real & m, const real & n, real & n_dr, const real & dr_min); \
+	template bool open_drmn<real>(real & n_dr, std::vector<real> & dr, const real & c, const real & m, const real & n); \
+	template bool save_drmn_neg<real>(bool verbose, const real & c, const real & m, const real & n, real & n_dr_neg, const real & dr_neg_min); \
+	template bool open_drmn_neg<real>(real & n_dr_neg, std::vector<real> & dr_neg, const real & c, const real & m, const real & n); \
+	template bool save_Nmn<real>(bool verbose, const real & c, const real & m, const real & n); \
+	template bool open_Nmn<real>(real & N, const real & c, const real & m, const real & n); \
+	template bool save_Fmn<real>(bool verbose, const real & c, const real & m, const real & n); \
+	template bool open_Fmn<real>(real & F, const real & c, const real & m, const real & n); \
+	template bool save_kmn1<real>(bool verbose, const real & c, const real & m, const real & n); \
+	template bool open_kmn1<real>(real & k1, const real & c, const real & m, const real & n); \
+	template bool save_kmn2<real>(bool verbose, const real & c, const real & m, const real & n); \
+	template bool open_kmn2<real>(real & k2, const real & c, const real & m, const real & n); \
+	template bool save_c2kmn<real>(bool verbose, const real & c, const real & m, const real & n, real & n_c2k, const real & c2k_min); \
+	template bool open_c2kmn<real>(real & n_c2k, std::vector<real> & c2k, const real & c, const real & m, const real & n); \
+	template bool save_Smn1<real>(bool verbose, const real & c, const real & m, const real & n, const real & a, const real & b, const real & d, const std::string & arg_type, int p);
+
+FOR_EACH_REAL_TYPE(INSTANTIATE_COMMON_MAIN)
@@ -32,24 +32,45 @@
 #include <string>
 #include <vector>
 
+template <class real>
 std::string generate_name(const real & c, const real & m, const real & n, const std::string & name);
+template <class real>
 bool save_lambdamn(bool verbose, const real & c, const real & m, const real & n);
+template <class real>
 bool open_lambdamn(real & lambda, const real & c, const real & m, const real & n);
+template <class real>
+bool save_lambdamn_all(bool verbose, const real & c, const real & m, const real & n_max);
+template <class real>
 bool save_drmn(bool verbose, const real & c, const real & m, const real & n, real & n_dr, const real & dr_min);
+template <class real>
 bool open_drmn(real & n_dr, std::vector<real> & dr, const real & c, const real & m, const real & n);
+template <class real>
 bool save_drmn_neg(bool verbose, const real & c, const real & m, const real & n, real & n_dr_neg, const real & dr_neg_min);
+template <class real>
 bool open_drmn_neg(real & n_dr_neg, std::vector<real> & dr_neg, const real & c, const real & m, const real & n);
+template <class real>
 bool save_Nmn(bool verbose, const real & c, const real & m, const real & n);
+template <class real>
 bool open_Nmn(real & N, const real & c, const real & m, const real & n);
+template <class real>
 bool save_Fmn(bool verbose, const real & c, const real & m, const real & n);
+template <class real>
 bool open_Fmn(real & N, const real & c, const real & m, const real & n);
+template <class real>
 bool save_kmn1(bool verbose, const real & c, const real & m, const real & n);
+template <class real>
 bool open_kmn1(real & k1, const real & c, const real & m, const real & n);
+template <class real>
 bool save_kmn2(bool verbose, const real & c, const real & m, const real & n);
+template <class real>
 bool open_kmn2(real & k2, const real & c, const real & m, const real & n);
+template <class real>
 bool save_c2kmn(bool verbose, const real & c, const real & m, const real & n, real & n_c2k, const real & c2k_min);
+template <class real>
 bool open_c2kmn(real & n_c2k, std::vector<real> & c2k, const real & c, const real & m, const real & n);
+template <class real>
 bool save_Smn1(bool verbose, const real & c, const real & m, const real & n, const real & a, const real & b, const real & d, const std::string & arg_type, int p);
+template <class real>
 int parse_args(int argc, char **argv);
 
 #endif
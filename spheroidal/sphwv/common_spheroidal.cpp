@@ -25,117 +25,90 @@
 // POSSIBILITY OF SUCH DAMAGE.
 //
 
+#include "acceleration.hpp"
 #include "adder.hpp"
+#include <algorithm>
+#include "binary_splitting.hpp"
+#include "coefficient_table.hpp"
 #include "common_spheroidal.hpp"
+#include "continued_fraction.hpp"
 #include <iostream>
+#include "minimal_solution.hpp"
+#include "mixed_precision.hpp"
 #include "real.hpp"
+#include "real_types.hpp"
+#include "root_finding.hpp"
+#include <string>
 #include <vector>
 
-static real calculate_alphar(const real & c, const real & m, const real & r);
-static real calculate_betar(const real & c, const real & m, const real & r);
-static real calculate_gammar(const real & c, const real & m, const real & r);
-static real calculate_betarm(const real & c, const real & m, const real & r);
-static real calculate_gammarm(const real & c, const real & m, const real & r);
-static real calculate_U(bool verbose, const real & c, const real & m, const real & n, const real & lambda);
-static void calculate_zero(real & x, real & Ux, bool verbose, const real & c, const real & m, const real & n, real a, real Ua, real b, real Ub);
-static real calculate_Nrm(bool verbose, const real & c, const real & m, const real & r, const real & lambda);
-static real calculate_Arm(const real & c, const real & m, const real & r);
-static real calculate_Brm(const real & c, const real & m, const real & lambda, const real & r);
-static real calculate_Crm(const real & c, const real & m, const real & r);
+static int count_eigenvalues_below(const std::vector<double> & d, const std::vector<double> & e2, double x);
+template <class real>
+static void calculate_tridiagonal(std::vector<double> & d, std::vector<double> & e2, coefficient_table<real> & table, const real & r0, int size);
+static void calculate_gershgorin_bounds(double & lo, double & hi, const std::vector<double> & d, const std::vector<double> & e2);
+static double calculate_eigenvalue(const std::vector<double> & d, const std::vector<double> & e2, int index, double lo, double hi);
+template <class real>
+static real calculate_U(bool verbose, coefficient_table<real> & table, const real & m, const real & n, const real & lambda);
+template <class real>
+static void refine_lambdamn(real & lambda, bool verbose, coefficient_table<real> & table, const real & m, const real & n, const real & lambda_approx, int accuracy, real lower, real upper);
+template <class real>
+static real climb_precision_ladder(bool verbose, const real & c, const real & m, const real & n, const real & lambda_approx, int & accuracy, const real & lower, const real & upper);
+static void refine_lambdamn_at(std::string & lambda, bool verbose, const std::string & c, const std::string & m, const std::string & n, int precision, int accuracy, const std::string & lower, const std::string & upper);
+template <class real>
+static void calculate_zero(real & x, real & Ux, bool verbose, coefficient_table<real> & table, const real & m, const real & n, real a, real Ua, real b, real Ub);
+template <class real>
 static real get_dr(bool verbose, const real & c, const real & m, const real & n, const real & lambda, real & n_dr, std::vector<real> & dr, const real & r);
+template <class real>
 static real get_dr_neg(bool verbose, const real & c, const real & m, const real & n, const real & lambda, const real & n_dr, const std::vector<real> & dr, real & n_dr_neg, std::vector<real> & dr_neg, const real & r);
+template <class real>
+static void begin_Fmn_factors(factor_table<real> & a, const real & m, const real & n);
+template <class real>
+static void begin_c2kmn_factors(factor_table<real> & a, const real & m, const real & n, const real & k);
 
-static real calculate_alphar(const real & c, const real & m, const real & r)
-{
-	return (((real::TWO * m + r + real::TWO) * (real::TWO * m + r + real::ONE)) / ((real::TWO * m + real::TWO * r + real::FIVE) * (real::TWO * m + real::TWO * r + real::THREE))) * calculate_c_squared(c);
-}
-
-static real calculate_betar(const real & c, const real & m, const real & r)
-{
-	return (m + r) * (m + r + real::ONE) + ((real::TWO * (m + r) * (m + r + real::ONE) - real::TWO * m * m - real::ONE) / ((real::TWO * m + real::TWO * r - real::ONE) * (real::TWO * m + real::TWO * r + real::THREE))) * calculate_c_squared(c);
-}
-
-static real calculate_gammar(const real & c, const real & m, const real & r)
-{
-	return ((r * (r - real::ONE)) / ((real::TWO * m + real::TWO * r - real::THREE) * (real::TWO * m + real::TWO * r - real::ONE))) * calculate_c_squared(c);
-}
-
-static real calculate_betarm(const real & c, const real & m, const real & r)
-{
-	return calculate_gammar(c, m, r) * calculate_alphar(c, m, r - real::TWO);
-}
-
-static real calculate_gammarm(const real & c, const real & m, const real & r)
-{
-	return calculate_betar(c, m, r);
-}
-
-real calculate_continued_fraction(const real & b0, const std::vector<real> & a, const std::vector<real> & b)
-{
-	real x;
-	
-	x = real::ZERO;
-	if ((int)a.size() < (int)b.size())
-	{
-		for (int i = (int)a.size() - 1; i >= 0; --i)
-		{
-			x = a[i] / (b[i] - x);
-		}
-	}
-	else
-	{
-		for (int i = (int)b.size() - 1; i >= 0; --i)
-		{
-			x = a[i] / (b[i] - x);
-		}
-	}
-	x = b0 - x;
-	return x;
-}
-
-static real calculate_U(bool verbose, const real & c, const real & m, const real & n, const real & lambda)
+template <class real>
+static real calculate_U(bool verbose, coefficient_table<real> & table, const real & m, const real & n, const real & lambda)
 {
 	real r;
-	real b0;
-	std::vector<real> a;
-	std::vector<real> b;
+	real x;
 	real U1;
+	continued_fraction<real> U2_fraction;
+	accelerator<real> U2_accelerator;
 	real prev_U2;
 	real U2;
 	real U;
 	
+	++root_finding::n_evaluations;
+	++root_finding::n_thread_evaluations;
 	r = n - m;
-	b0 = calculate_gammarm(c, m, r) - lambda;
-	a.clear();
-	b.clear();
+	x = real::ZERO;
 	if (remainder(n - m, real::TWO) == real::ZERO)
 	{
-		for (real i = r; i >= real::TWO; i = i - real::TWO)
+		for (real i = real::TWO; i <= r; i += 2)
 		{
-			a.push_back(calculate_betarm(c, m, i));
-			b.push_back(calculate_gammarm(c, m, i - real::TWO) - lambda);
+			x = table.get_betarm(i) / (table.get_gammarm(i - 2) - lambda - x);
 		}
 	}
 	else
 	{
-		for (real i = r; i >= real::THREE; i = i - real::TWO)
+		for (real i = real::THREE; i <= r; i += 2)
 		{
-			a.push_back(calculate_betarm(c, m, i));
-			b.push_back(calculate_gammarm(c, m, i - real::TWO) - lambda);
+			x = table.get_betarm(i) / (table.get_gammarm(i - 2) - lambda - x);
 		}
 	}
-	U1 = calculate_continued_fraction(b0, a, b);
-	b0 = real::ZERO;
-	a.clear();
-	b.clear();
+	U1 = table.get_gammarm(r) - lambda - x;
+	U2_fraction.clear(real::ZERO);
 	prev_U2 = real::NAN;
-	for (real i = r + real::TWO; ; i = i + real::TWO)
+	for (real i = r + 2; ; i += 2)
 	{
-		a.push_back(calculate_betarm(c, m, i));
-		b.push_back(calculate_gammarm(c, m, i) - lambda);
-		if (remainder(i - (r + real::TWO), real("100.0")) == real::ZERO)
+		U2_fraction.add(table.get_betarm(i), table.get_gammarm(i) - lambda);
+		U2_accelerator.add(U2_fraction.get_value());
+		if (U2_accelerator.has_converged())
+		{
+			U2 = U2_accelerator.get_value();
+			break;
+		}
+		if (remainder(i - (r + 2), 100) == real::ZERO)
 		{
-			U2 = calculate_continued_fraction(b0, a, b);
+			U2 = U2_fraction.get_value();
 			if (prev_U2 == prev_U2)
 			{
 				if (abs((U2 - prev_U2) / prev_U2) < real::SMALL_ENOUGH)
@@ -150,46 +123,70 @@ static real calculate_U(bool verbose, const real & c, const real & m, const real
 			prev_U2 = U2;
 		}
 	}
+	// U2 is only checked every 50 terms (and it takes two checks), so that's
+	// the soonest that plain summation could've stopped.
+	U2_accelerator.report(verbose, "calculate_U", std::max(50 * ((U2_fraction.get_n_terms() + 48) / 50) + 1, 51));
 	U = U1 + U2;
 	return U;
 }
 
-static void calculate_zero(real & x, real & Ux, bool verbose, const real & c, const real & m, const real & n, real a, real Ua, real b, real Ub)
+template <class real>
+static void calculate_zero(real & x, real & Ux, bool verbose, coefficient_table<real> & table, const real & m, const real & n, real a, real Ua, real b, real Ub)
 {
 	real prev_x;
+	int side;
+	int prev_side;
+	real U_replaced;
+	real scale;
 	
+	++root_finding::n_zeros;
+	prev_side = 0;
 	for (int i = 0; ; ++i)
 	{
 		x = a - (Ua / (Ub - Ua)) * (b - a);
-		Ux = calculate_U(verbose, c, m, n, x);
+		Ux = calculate_U(verbose, table, m, n, x);
+		++root_finding::n_iterations;
 		if (Ux != real::ZERO)
 		{
-			if (Ua < real::ZERO && Ub > real::ZERO)
+			if ((Ux < real::ZERO) == (Ua < real::ZERO))
 			{
-				if (Ux < real::ZERO)
-				{
-					a = x;
-					Ua = Ux;
-				}
-				else
-				{
-					b = x;
-					Ub = Ux;
-				}
+				U_replaced = Ua;
+				a = x;
+				Ua = Ux;
+				side = -1;
 			}
 			else
 			{
-				if (Ux > real::ZERO)
+				U_replaced = Ub;
+				b = x;
+				Ub = Ux;
+				side = 1;
+			}
+			//
+			// The same end was replaced twice in a row, so the other one is
+			// stuck (see root_finding.hpp).
+			//
+			if (root_finding::method != root_finding::FALSE_POSITION && side == prev_side)
+			{
+				scale = real::ONE / real::TWO;
+				if (root_finding::method == root_finding::ANDERSON_BJORCK)
+				{
+					scale = real::ONE - Ux / U_replaced;
+					if (scale <= real::ZERO)
+					{
+						scale = real::ONE / real::TWO;
+					}
+				}
+				if (side == -1)
 				{
-					a = x;
-					Ua = Ux;
+					Ub *= scale;
 				}
 				else
 				{
-					b = x;
-					Ub = Ux;
+					Ua *= scale;
 				}
 			}
+			prev_side = side;
 		}
 		else
 		{
@@ -211,7 +208,182 @@ static void calculate_zero(real & x, real & Ux, bool verbose, const real & c, co
 	}
 }
 
-void calculate_lambdamn(real & lambda, bool verbose, const real & c, const real & m, const real & n, const real & lambda_approx)
+//
+// Returns how many eigenvalues of the symmetric tridiagonal matrix with
+// diagonal d and squared off-diagonal e2 are less than x.  That's the number
+// of negative pivots in the LDL^T factorization of the matrix minus x (the
+// Sturm sequence), and a pivot that comes out exactly zero is nudged to
+// TINY, so that the next one doesn't divide by it.
+//
+static int count_eigenvalues_below(const std::vector<double> & d, const std::vector<double> & e2, double x)
+{
+	const double TINY = 1.0e-300;
+	int count;
+	double q;
+	
+	count = 0;
+	q = 1.0;
+	for (int i = 0; i < (int)d.size(); ++i)
+	{
+		if (i > 0)
+		{
+			q = d[i] - x - e2[i - 1] / q;
+		}
+		else
+		{
+			q = d[i] - x;
+		}
+		if (q == 0.0)
+		{
+			q = TINY;
+		}
+		if (q < 0.0)
+		{
+			++count;
+		}
+	}
+	return count;
+}
+
+//
+// Sets d and e2 to the diagonal and the squared off-diagonal of the
+// size-by-size truncation of the tridiagonal matrix whose rows are gamma_r,
+// beta_r, and alpha_r, for r = r0, r0 + 2, ....  Its eigenvalues are the
+// lambdas for n - m = r0, r0 + 2, ..., from the smallest up.  alpha_r *
+// gamma_(r + 2) is always positive, so the matrix is similar to a symmetric
+// one, whose off-diagonal is the square root of it, and e2 is all that the
+// Sturm counts (see count_eigenvalues_below) need.
+//
+template <class real>
+static void calculate_tridiagonal(std::vector<double> & d, std::vector<double> & e2, coefficient_table<real> & table, const real & r0, int size)
+{
+	d.clear();
+	e2.clear();
+	for (int i = 0; i < size; ++i)
+	{
+		d.push_back(table.get_betar(r0 + 2 * i).get_double());
+		if (i < size - 1)
+		{
+			e2.push_back((table.get_alphar(r0 + 2 * i) * table.get_gammar(r0 + 2 * i + 2)).get_double());
+		}
+	}
+}
+
+//
+// Sets lo and hi to the Gershgorin bounds of the eigenvalues.
+//
+static void calculate_gershgorin_bounds(double & lo, double & hi, const std::vector<double> & d, const std::vector<double> & e2)
+{
+	double radius;
+	
+	lo = d[0];
+	hi = d[0];
+	for (int i = 0; i < (int)d.size(); ++i)
+	{
+		radius = 0.0;
+		if (i > 0)
+		{
+			radius += __builtin_sqrt(__builtin_fabs(e2[i - 1]));
+		}
+		if (i < (int)d.size() - 1)
+		{
+			radius += __builtin_sqrt(__builtin_fabs(e2[i]));
+		}
+		if (d[i] - radius < lo)
+		{
+			lo = d[i] - radius;
+		}
+		if (d[i] + radius > hi)
+		{
+			hi = d[i] + radius;
+		}
+	}
+}
+
+//
+// Returns the index-th smallest eigenvalue, by bisection on the Sturm count,
+// to the last bit of a double.  There have to be fewer than index
+// eigenvalues less than lo, and at least index less than hi.
+//
+static double calculate_eigenvalue(const std::vector<double> & d, const std::vector<double> & e2, int index, double lo, double hi)
+{
+	double mid;
+	
+	while (true)
+	{
+		mid = 0.5 * (lo + hi);
+		if (mid <= lo || mid >= hi)
+		{
+			break;
+		}
+		if (count_eigenvalues_below(d, e2, mid) >= index)
+		{
+			hi = mid;
+		}
+		else
+		{
+			lo = mid;
+		}
+	}
+	return mid;
+}
+
+//
+// Works out an approximation of lambda, good to about double precision, for
+// calculate_lambdamn to start from.  Like pro_ and
+// obl_calculate_lambdamn_approx.m, it takes the (m + n + 200)-by-(m + n +
+// 200) truncation of the tridiagonal matrix (see calculate_tridiagonal), and
+// the lambda that's wanted is its ((n - m) / 2 + 1)-th (or ((n - m + 1) /
+// 2)-th) smallest eigenvalue.  It's found by bisection, starting from the
+// Gershgorin bounds, which is O(N) for each step, instead of the O(N^3) of a
+// dense eigensolver, and needs no MATLAB.
+//
+template <class real>
+real calculate_lambdamn_approx(bool verbose, const real & c, const real & m, const real & n)
+{
+	coefficient_table<real> table(c, m);
+	real r0;
+	int index;
+	std::vector<double> d;
+	std::vector<double> e2;
+	double lo;
+	double hi;
+	double x;
+	
+	if (remainder(n - m, real::TWO) == real::ZERO)
+	{
+		r0 = real::ZERO;
+		index = ((n - m) / 2).get_int() + 1;
+	}
+	else
+	{
+		r0 = real::ONE;
+		index = ((n - m + 1) / 2).get_int();
+	}
+	calculate_tridiagonal(d, e2, table, r0, (m + n).get_int() + 200);
+	calculate_gershgorin_bounds(lo, hi, d, e2);
+	x = calculate_eigenvalue(d, e2, index, lo, hi);
+	if (verbose)
+	{
+		std::cout << "calculate_lambdamn_approx: " << real(x).get_string(17) << std::endl;
+	}
+	return real(x);
+}
+
+//
+// Finds the root of U near lambda_approx.  beta_r^m is always positive, so
+// U is decreasing in lambda wherever it's finite (each level of either
+// continued fraction is), and the root is above lambda_approx if U is
+// positive there, and below it if U is negative.  So the bracket is only
+// grown in that direction: the far end starts out 2^-accuracy *
+// lambda_approx away, where accuracy is how many bits lambda_approx is
+// thought to be good to (46 for a double-precision eigenvalue), and moves
+// out 16 times further each time, with the near end following it whenever
+// U hasn't changed sign yet.  The far end never goes below lower or
+// above upper, and if it gets there without a sign change, they're dropped.
+//
+template <class real>
+static void refine_lambdamn(real & lambda, bool verbose, coefficient_table<real> & table, const real & m, const real & n, const real & lambda_approx, int accuracy, real lower, real upper)
 {
 	real x;
 	real Ux;
@@ -222,14 +394,45 @@ void calculate_lambdamn(real & lambda, bool verbose, const real & c, const real
 	real Ub;
 	
 	x = lambda_approx;
-	Ux = calculate_U(verbose, c, m, n, x);
-	d = pow(real::TWO, -real("100.0")) * x;
+	Ux = calculate_U(verbose, table, m, n, x);
+	if (Ux == real::ZERO)
+	{
+		lambda = x;
+		return;
+	}
+	d = pow(real::TWO, -accuracy) * abs(x);
+	if (d == real::ZERO)
+	{
+		d = pow(real::TWO, -accuracy);
+	}
+	a = x;
+	Ua = Ux;
+	b = x;
+	Ub = Ux;
 	while (true)
 	{
-		a = x - d;
-		Ua = calculate_U(verbose, c, m, n, a);
-		b = x + d;
-		Ub = calculate_U(verbose, c, m, n, b);
+		if (Ux > real::ZERO)
+		{
+			a = b;
+			Ua = Ub;
+			b = x + d;
+			if (b > upper)
+			{
+				b = upper;
+			}
+			Ub = calculate_U(verbose, table, m, n, b);
+		}
+		else
+		{
+			b = a;
+			Ub = Ua;
+			a = x - d;
+			if (a < lower)
+			{
+				a = lower;
+			}
+			Ua = calculate_U(verbose, table, m, n, a);
+		}
 		if (verbose)
 		{
 			std::cout << "calculate_lambdamn: " << Ua.get_string(10) << ", " << Ub.get_string(10) << std::endl;
@@ -238,62 +441,162 @@ void calculate_lambdamn(real & lambda, bool verbose, const real & c, const real
 		{
 			break;
 		}
-		d = real::TWO * d;
+		if (a == lower || b == upper)
+		{
+			if (verbose)
+			{
+				std::cout << "calculate_lambdamn: warning: no sign change before the neighbor..." << std::endl;
+			}
+			lower = -real::INF;
+			upper = real::INF;
+		}
+		d *= 16;
 	}
-	calculate_zero(x, Ux, verbose, c, m, n, a, Ua, b, Ub);
+	calculate_zero(x, Ux, verbose, table, m, n, a, Ua, b, Ub);
 	lambda = x;
 }
 
-static real calculate_Nrm(bool verbose, const real & c, const real & m, const real & r, const real & lambda)
+//
+// With root_finding::precision_ladder, lambda_approx is refined with reals of
+// 106 bits first, then 212, 424, and so on, for as long as that's less than
+// the precision of real, each time starting from the last one, and accuracy
+// is set to how many bits the last one is good to (16 less than it was
+// worked out with, to be safe).  That way, most of the evaluations of U are
+// cheap, and refine_lambdamn only has to take the last few steps at the full
+// precision.  Each step is done with the usual reals, in a real_context of
+// its own (see refine_lambdamn_at), so the values go back and forth as
+// strings, which are exact.  The ladder's evaluations are counted on this
+// thread only (see root_finding.hpp), since they're all done on it.
+//
+template <class real>
+static real climb_precision_ladder(bool verbose, const real & c, const real & m, const real & n, const real & lambda_approx, int & accuracy, const real & lower, const real & upper)
 {
-	real b0;
-	std::vector<real> a;
-	std::vector<real> b;
-	real N;
-	real prev_N;
+	std::string lambda;
+	long n_evaluations;
+	
+	lambda = lambda_approx.get_string(0);
+	n_evaluations = root_finding::n_thread_evaluations;
+	for (int precision = 2 * 53; precision < lambda_approx.get_precision(); precision *= 2)
+	{
+		refine_lambdamn_at(lambda, verbose, c.get_string(0), m.get_string(0), n.get_string(0), precision, accuracy, lower.get_string(0), upper.get_string(0));
+		accuracy = precision - 16;
+	}
+	root_finding::n_ladder_evaluations += root_finding::n_thread_evaluations - n_evaluations;
+	return real(lambda);
+}
+
+//
+// The context is made first, so that it's destroyed last, after every real
+// that was made in it.
+//
+static void refine_lambdamn_at(std::string & lambda, bool verbose, const std::string & c, const std::string & m, const std::string & n, int precision, int accuracy, const std::string & lower, const std::string & upper)
+{
+	real_context context(precision, -1);
+	coefficient_table<real> table((real(c)), real(m));
+	real x;
+	
+	refine_lambdamn(x, verbose, table, real(m), real(n), real(lambda), accuracy, real(lower), real(upper));
+	lambda = x.get_string(0);
+}
+
+template <class real>
+void calculate_lambdamn(real & lambda, bool verbose, const real & c, const real & m, const real & n, const real & lambda_approx)
+{
+	coefficient_table<real> table(c, m);
+	int accuracy;
+	real x;
+	
+	accuracy = 46;
+	x = lambda_approx;
+	if (root_finding::precision_ladder)
+	{
+		x = climb_precision_ladder(verbose, c, m, n, x, accuracy, real(-real::INF), real(real::INF));
+	}
+	refine_lambdamn(lambda, verbose, table, m, n, x, accuracy, real(-real::INF), real(real::INF));
+}
+
+//
+// Works out lambda for n = m, m + 1, ..., m + n_max - 1 (lambda[i] is the one
+// for n = m + i), with one coefficient_table for all of them.  The lambdas of
+// each parity of n - m are the eigenvalues of one tridiagonal matrix (see
+// calculate_tridiagonal), in order, so they're approximated together, each
+// one's bisection starting from the one below it.  Then each is refined by
+// refine_lambdamn, which keeps it between the midpoints to its neighbors'
+// approximations, so that it can't wander off to one of theirs.
+//
+template <class real>
+void calculate_lambdamn_all(std::vector<real> & lambda, bool verbose, const real & c, const real & m, const real & n_max)
+{
+	coefficient_table<real> table(c, m);
+	int size;
+	std::vector<double> approx;
+	std::vector<double> d;
+	std::vector<double> e2;
+	double lo;
+	double hi;
+	real lower;
+	real upper;
+	int accuracy;
+	real x;
 	
-	b0 = real::ZERO;
-	a.clear();
-	b.clear();
-	for (real i = r; ; i = i + real::TWO)
+	size = n_max.get_int();
+	approx.assign(size, 0.0);
+	for (int parity = 0; parity <= 1; ++parity)
 	{
-		a.push_back(calculate_betarm(c, m, i));
-		b.push_back(calculate_gammarm(c, m, i) - lambda);
-		N = -calculate_continued_fraction(b0, a, b);
-		if (i > r)
+		calculate_tridiagonal(d, e2, table, real(parity), 2 * m.get_int() + size + 200);
+		calculate_gershgorin_bounds(lo, hi, d, e2);
+		for (int i = parity; i < size; i += 2)
 		{
-			if (abs((N - prev_N) / prev_N) < real::SMALL_ENOUGH)
+			approx[i] = calculate_eigenvalue(d, e2, i / 2 + 1, i >= 2 ? approx[i - 2] : lo, hi);
+			if (verbose)
 			{
-				if (verbose)
-				{
-					std::cout << "calculate_Nrm: " << ((N - prev_N) / prev_N).get_string(10) << std::endl;
-				}
-				break;
+				std::cout << "calculate_lambdamn_all: n = " << m.get_int() + i << ": " << real(approx[i]).get_string(17) << std::endl;
 			}
 		}
-		prev_N = N;
 	}
-	return N;
+	lambda.clear();
+	for (int i = 0; i < size; ++i)
+	{
+		lower = i >= 2 ? real(0.5 * (approx[i - 2] + approx[i])) : real(-real::INF);
+		upper = i + 2 < size ? real(0.5 * (approx[i] + approx[i + 2])) : real(real::INF);
+		accuracy = 46;
+		x = real(approx[i]);
+		if (root_finding::precision_ladder)
+		{
+			x = climb_precision_ladder(verbose, c, m, real(m + i), x, accuracy, lower, upper);
+		}
+		lambda.push_back(real::ZERO);
+		refine_lambdamn(lambda[i], verbose, table, m, real(m + i), x, accuracy, lower, upper);
+	}
 }
 
+template <class real>
 void calculate_drmn(std::vector<real> & dr, bool verbose, const real & c, const real & m, const real & n, const real & lambda, real & n_dr, const real & dr_min)
 {
 	real n_dr_orig;
-	real N;
+	coefficient_table<real> table(c, m);
+	minimal_solution<real, real> dr_solution;
+	typename minimal_solution<real, real>::coefficients get_coefficients;
 	bool converged;
 	real x;
-	adder x_adder;
+	adder<real> x_adder;
 	real a;
 	real change;
 	real s;
 	real remove_where;
 	
 	n_dr_orig = n_dr;
-	for ( ; ; n_dr = real::TWO * n_dr)
+	get_coefficients = [&](real & a_r, real & b_r, real & c_r, const real & r)
+	{
+		a_r = -table.get_gammar(r);
+		b_r = table.get_gammarm(r) - lambda;
+		c_r = -table.get_alphar(r);
+	};
+	for ( ; ; n_dr *= 2)
 	{
 		if (n_dr > n_dr_orig)
 		{
-			for (real r = n_dr / real::TWO; r <= n_dr - real::ONE; r = r + real::ONE)
+			for (real r = n_dr / 2; r <= n_dr - 1; r += 1)
 			{
 				dr.push_back(real::ZERO);
 			}
@@ -301,43 +604,32 @@ void calculate_drmn(std::vector<real> & dr, bool verbose, const real & c, const
 		else
 		{
 			dr.clear();
-			for (real r = real::ZERO; r <= n_dr_orig - real::ONE; r = r + real::ONE)
+			for (real r = real::ZERO; r <= n_dr_orig - 1; r += 1)
 			{
 				dr.push_back(real::ZERO);
 			}
 		}
 		if (remainder(n - m, real::TWO) == real::ZERO)
 		{
-			dr[gzbi(n_dr - real::TWO)] = real::ONE;
-			for (real r = n_dr - real::TWO; r >= real::TWO; r = r - real::TWO)
-			{
-				if (r < n_dr - real::TWO)
-				{
-					N = calculate_betarm(c, m, r) / (calculate_gammarm(c, m, r) - lambda - N);
-				}
-				else
-				{
-					N = calculate_Nrm(verbose, c, m, r, lambda);
-				}
-				dr[gzbi(r - real::TWO)] = -(calculate_alphar(c, m, r - real::TWO) / N) * dr[gzbi(r)];
-			}
+			dr_solution.calculate_ratios(verbose, "calculate_drmn", get_coefficients, real::ZERO, n_dr - 2, real::TWO, real::INF, minimal_solution<real, real>::EVERY_TERM);
+			dr_solution.calculate_backward(dr);
 			converged = false;
 			x = real::ZERO;
 			x_adder.clear();
-			for (real r = real::ZERO; r <= n_dr - real::TWO; r = r + real::TWO)
+			for (real r = real::ZERO; r <= n_dr - 2; r += 2)
 			{
 				if (r > real::ZERO)
 				{
-					a = a * ((-real::ONE * (real::TWO * m + r - real::ONE) * (real::TWO * m + r)) / (real::FOUR * (m + r / real::TWO) * (r / real::TWO)));
+					a *= (-real::ONE * (2 * m + r - 1) * (2 * m + r)) / (4 * (m + r / 2) * (r / 2));
 				}
 				else
 				{
-					a = factorial(real::TWO * m) / factorial(m);
+					a = factorial(2 * m) / factorial(m);
 				}
 				change = dr[gzbi(r)] * a;
-				x = x + change;
+				x += change;
 				x_adder.add(change);
-				if (r > real::ZERO && abs(change) > real::ZERO && abs(change / x) < real::SMALL_ENOUGH)
+				if (r > real::ZERO && is_negligible(change, x))
 				{
 					converged = true;
 					if (verbose)
@@ -355,48 +647,34 @@ void calculate_drmn(std::vector<real> & dr, bool verbose, const real & c, const
 					std::cout << "calculate_drmn: warning: x did not converge" << std::endl;
 				}
 			}
-			s = ((pow(-real::ONE, (n - m) / real::TWO) * factorial(n + m)) / (pow(real::TWO, n - m) * factorial((n + m) / real::TWO) * factorial((n - m) / real::TWO))) / x;
-			for (real r = real::ZERO; r <= n_dr - real::TWO; r = r + real::TWO)
-			{
-				dr[gzbi(r)] = s * dr[gzbi(r)];
-			}
-			if (converged && (dr_min == real::ZERO || abs(dr[gzbi(n_dr - real::TWO)]) < dr_min))
+			s = ((sign_pow((n - m) / 2) * factorial(n + m)) / (pow(real::TWO, n - m) * factorial((n + m) / 2) * factorial((n - m) / 2))) / x;
+			dr_solution.scale(dr, s);
+			if (converged && (dr_min == real::ZERO || abs(dr[gzbi(n_dr - 2)]) < dr_min))
 			{
 				break;
 			}
 		}
 		else
 		{
-			dr[gzbi(n_dr - real::ONE)] = real::ONE;
-			for (real r = n_dr - real::ONE; r >= real::THREE; r = r - real::TWO)
-			{
-				if (r < n_dr - real::ONE)
-				{
-					N = calculate_betarm(c, m, r) / (calculate_gammarm(c, m, r) - lambda - N);
-				}
-				else
-				{
-					N = calculate_Nrm(verbose, c, m, r, lambda);
-				}
-				dr[gzbi(r - real::TWO)] = -(calculate_alphar(c, m, r - real::TWO) / N) * dr[gzbi(r)];
-			}
+			dr_solution.calculate_ratios(verbose, "calculate_drmn", get_coefficients, real::ONE, n_dr - 1, real::TWO, real::INF, minimal_solution<real, real>::EVERY_TERM);
+			dr_solution.calculate_backward(dr);
 			converged = false;
 			x = real::ZERO;
 			x_adder.clear();
-			for (real r = real::ONE; r <= n_dr - real::ONE; r = r + real::TWO)
+			for (real r = real::ONE; r <= n_dr - 1; r += 2)
 			{
 				if (r > real::ONE)
 				{
-					a = a * ((-real::ONE * (real::TWO * m + r) * (real::TWO * m + r + real::ONE)) / (real::FOUR * (m + r / real::TWO + real::ONE / real::TWO) * (r / real::TWO - real::ONE / real::TWO)));
+					a *= (-real::ONE * (2 * m + r) * (2 * m + r + 1)) / (4 * (m + r / real::TWO + real::ONE / real::TWO) * (r / real::TWO - real::ONE / real::TWO));
 				}
 				else
 				{
-					a = factorial(real::TWO * m + real::TWO) / (real::TWO * factorial(m + real::ONE));
+					a = factorial(2 * m + 2) / (2 * factorial(m + 1));
 				}
 				change = dr[gzbi(r)] * a;
-				x = x + change;
+				x += change;
 				x_adder.add(change);
-				if (r > real::ZERO && abs(change) > real::ZERO && abs(change / x) < real::SMALL_ENOUGH)
+				if (r > real::ZERO && is_negligible(change, x))
 				{
 					converged = true;
 					if (verbose)
@@ -414,27 +692,28 @@ void calculate_drmn(std::vector<real> & dr, bool verbose, const real & c, const
 					std::cout << "calculate_drmn: warning: x did not converge" << std::endl;
 				}
 			}
-			s = ((pow(-real::ONE, (n - m - real::ONE) / real::TWO) * factorial(n + m + real::ONE)) / (pow(real::TWO, n - m) * factorial((n + m + real::ONE) / real::TWO) * factorial((n - m - real::ONE) / real::TWO))) / x;
-			for (real r = real::ONE; r <= n_dr - real::ONE; r = r + real::TWO)
-			{
-				dr[gzbi(r)] = s * dr[gzbi(r)];
-			}
-			if (converged && (dr_min == real::ZERO || abs(dr[gzbi(n_dr - real::ONE)]) < dr_min))
+			s = ((sign_pow((n - m - 1) / 2) * factorial(n + m + 1)) / (pow(real::TWO, n - m) * factorial((n + m + 1) / 2) * factorial((n - m - 1) / 2))) / x;
+			dr_solution.scale(dr, s);
+			if (converged && (dr_min == real::ZERO || abs(dr[gzbi(n_dr - 1)]) < dr_min))
 			{
 				break;
 			}
 		}
 	}
+	if (verbose)
+	{
+		dr_solution.print_times("calculate_drmn");
+	}
 	if (dr_min > real::ZERO)
 	{
 		if (remainder(n - m, real::TWO) == real::ZERO)
 		{
-			for (real r = n_dr - real::TWO; r >= real::ZERO; r = r - real::TWO)
+			for (real r = n_dr - 2; r >= real::ZERO; r -= 2)
 			{
 				if (abs(dr[gzbi(r)]) >= dr_min)
 				{
-					remove_where = r + real::FOUR;
-					if (remove_where >= n_dr_orig && remove_where <= n_dr - real::TWO)
+					remove_where = r + 4;
+					if (remove_where >= n_dr_orig && remove_where <= n_dr - 2)
 					{
 						dr.erase(dr.begin() + gzbi(remove_where), dr.end());
 						n_dr = real((int)dr.size());
@@ -445,12 +724,12 @@ void calculate_drmn(std::vector<real> & dr, bool verbose, const real & c, const
 		}
 		else
 		{
-			for (real r = n_dr - real::ONE; r >= real::ONE; r = r - real::TWO)
+			for (real r = n_dr - 1; r >= real::ONE; r -= 2)
 			{
 				if (abs(dr[gzbi(r)]) >= dr_min)
 				{
-					remove_where = r + real::THREE;
-					if (remove_where >= n_dr_orig && remove_where <= n_dr - real::TWO)
+					remove_where = r + 3;
+					if (remove_where >= n_dr_orig && remove_where <= n_dr - 2)
 					{
 						dr.erase(dr.begin() + gzbi(remove_where), dr.end());
 						n_dr = real((int)dr.size());
@@ -462,38 +741,23 @@ void calculate_drmn(std::vector<real> & dr, bool verbose, const real & c, const
 	}
 }
 
-static real calculate_Arm(const real & c, const real & m, const real & r)
-{
-	return calculate_alphar(c, m, r - real::TWO);
-}
-
-static real calculate_Brm(const real & c, const real & m, const real & lambda, const real & r)
-{
-	return calculate_betar(c, m, r) - lambda;
-}
-
-static real calculate_Crm(const real & c, const real & m, const real & r)
-{
-	return calculate_gammar(c, m, r + real::TWO);
-}
-
+template <class real>
 void calculate_drmn_neg(std::vector<real> & dr_neg, bool verbose, const real & c, const real & m, const real & n, const real & lambda, const real & n_dr, const std::vector<real> & dr, real & n_dr_neg, const real & dr_neg_min)
 {
 	real n_dr_neg_orig;
-	real b0;
-	std::vector<real> a;
-	std::vector<real> b;
+	coefficient_table<real> table(c, m);
+	real first_a;
+	continued_fraction<real> N_fraction;
 	real N;
-	real prev_N;
 	real s;
 	real remove_where;
 	
 	n_dr_neg_orig = n_dr_neg;
-	for ( ; ; n_dr_neg = real::TWO * n_dr_neg)
+	for ( ; ; n_dr_neg *= 2)
 	{
 		if (n_dr_neg > n_dr_neg_orig)
 		{
-			for (real r = -n_dr_neg / real::TWO - real::ONE; r >= -n_dr_neg; r = r - real::ONE)
+			for (real r = -n_dr_neg / real::TWO - real::ONE; r >= -n_dr_neg; r -= 1)
 			{
 				dr_neg.push_back(real::ZERO);
 			}
@@ -501,7 +765,7 @@ void calculate_drmn_neg(std::vector<real> & dr_neg, bool verbose, const real & c
 		else
 		{
 			dr_neg.clear();
-			for (real r = -real::ONE; r >= -n_dr_neg_orig; r = r - real::ONE)
+			for (real r = -real::ONE; r >= -n_dr_neg_orig; r -= 1)
 			{
 				dr_neg.push_back(real::ZERO);
 			}
@@ -509,65 +773,58 @@ void calculate_drmn_neg(std::vector<real> & dr_neg, bool verbose, const real & c
 		if (remainder(n - m, real::TWO) == real::ZERO)
 		{
 			dr_neg[gnobi(-n_dr_neg)] = real::ONE;
-			for (real r = -n_dr_neg; r <= -real::TWO; r = r + real::TWO)
+			for (real r = -n_dr_neg; r <= -real::TWO; r += 2)
 			{
 				if (r > -n_dr_neg)
 				{
-					if (r != -real::TWO * m - real::TWO)
+					if (r != -2 * m - 2)
 					{
-						N = -calculate_Arm(c, m, r + real::TWO) / (calculate_Brm(c, m, lambda, r) + calculate_Crm(c, m, r - real::TWO) * N);
+						N = -table.get_alphar(r) / (table.get_betar(r) - lambda + table.get_gammar(r) * N);
 					}
 					else
 					{
-						N = (calculate_c_squared(c) / ((real::TWO * m - real::ONE) * (real::TWO * m + real::ONE))) / (calculate_Brm(c, m, lambda, r) + calculate_Crm(c, m, r - real::TWO) * N);
+						N = (calculate_c_squared(c) / ((2 * m - 1) * (2 * m + 1))) / (table.get_betar(r) - lambda + table.get_gammar(r) * N);
 					}
 				}
 				else
 				{
-					b0 = real::ZERO;
-					a.clear();
-					b.clear();
-					if (r != -real::TWO * m - real::TWO)
+					if (r != -2 * m - 2)
 					{
-						a.push_back(calculate_Arm(c, m, r + real::TWO));
+						first_a = table.get_alphar(r);
 					}
 					else
 					{
-						a.push_back(-calculate_c_squared(c) / ((real::TWO * m - real::ONE) * (real::TWO * m + real::ONE)));
+						first_a = -calculate_c_squared(c) / ((2 * m - 1) * (2 * m + 1));
 					}
-					b.push_back(calculate_Brm(c, m, lambda, r));
-					for (real i = r - real::TWO; ; i = i - real::TWO)
+					N_fraction.clear(real::ZERO);
+					N_fraction.add(first_a, table.get_betar(r) - lambda);
+					for (real i = r - 2; ; i -= 2)
 					{
-						a.push_back(calculate_Crm(c, m, i) * calculate_Arm(c, m, i + real::TWO));
-						b.push_back(calculate_Brm(c, m, lambda, i));
-						N = calculate_continued_fraction(b0, a, b);
-						if (i < r - real::TWO)
+						N_fraction.add(table.get_betarm(i + 2), table.get_betar(i) - lambda);
+						if (i < r - 2 && N_fraction.has_converged())
 						{
-							if (abs((N - prev_N) / prev_N) < real::SMALL_ENOUGH)
+							if (verbose)
 							{
-								if (verbose)
-								{
-									std::cout << "calculate_drmn_neg: " << ((N - prev_N) / prev_N).get_string(10) << std::endl;
-								}
-								break;
+								std::cout << "calculate_drmn_neg: " << N_fraction.get_change().get_string(10) << std::endl;
 							}
+							break;
 						}
-						prev_N = N;
 					}
+					N = N_fraction.get_value();
 				}
 				if (r < -real::TWO)
 				{
-					dr_neg[gnobi(r + real::TWO)] = dr_neg[gnobi(r)] / N;
-					if (r == -real::TWO * m - real::TWO)
+					dr_neg[gnobi(r + 2)] = dr_neg[gnobi(r)] / N;
+					if (r == -2 * m - 2)
 					{
 						N = real::ZERO;
 					}
 				}
 			}
 			s = dr[gzbi(real::ZERO)] / (dr_neg[gnobi(-real::TWO)] / N);
-			for (real r = -n_dr_neg; r <= -real::TWO; r = r + real::TWO)
+			for (real r = -n_dr_neg; r <= -real::TWO; r += 2)
 			{
-				dr_neg[gnobi(r)] = s * dr_neg[gnobi(r)];
+				dr_neg[gnobi(r)] *= s;
 			}
 			if (dr_neg_min == real::ZERO || abs(dr_neg[gnobi(-n_dr_neg)]) < dr_neg_min)
 			{
@@ -576,68 +833,61 @@ void calculate_drmn_neg(std::vector<real> & dr_neg, bool verbose, const real & c
 		}
 		else
 		{
-			dr_neg[gnobi(-n_dr_neg + real::ONE)] = real::ONE;
-			for (real r = -n_dr_neg + real::ONE; r <= -real::ONE; r = r + real::TWO)
+			dr_neg[gnobi(-n_dr_neg + 1)] = real::ONE;
+			for (real r = -n_dr_neg + 1; r <= -real::ONE; r += 2)
 			{
-				if (r > -n_dr_neg + real::ONE)
+				if (r > -n_dr_neg + 1)
 				{
-					if (r != -real::TWO * m - real::ONE)
+					if (r != -2 * m - 1)
 					{
-						N = -calculate_Arm(c, m, r + real::TWO) / (calculate_Brm(c, m, lambda, r) + calculate_Crm(c, m, r - real::TWO) * N);
+						N = -table.get_alphar(r) / (table.get_betar(r) - lambda + table.get_gammar(r) * N);
 					}
 					else
 					{
-						N = -(calculate_c_squared(c) / ((real::TWO * m - real::ONE) * (real::TWO * m - real::THREE))) / (calculate_Brm(c, m, lambda, r) + calculate_Crm(c, m, r - real::TWO) * N);
+						N = -(calculate_c_squared(c) / ((2 * m - 1) * (2 * m - 3))) / (table.get_betar(r) - lambda + table.get_gammar(r) * N);
 					}
 				}
 				else
 				{
-					b0 = real::ZERO;
-					a.clear();
-					b.clear();
-					if (r != -real::TWO * m - real::ONE)
+					if (r != -2 * m - 1)
 					{
-						a.push_back(calculate_Arm(c, m, r + real::TWO));
+						first_a = table.get_alphar(r);
 					}
 					else
 					{
-						a.push_back(calculate_c_squared(c) / ((real::TWO * m - real::ONE) * (real::TWO * m - real::THREE)));
+						first_a = calculate_c_squared(c) / ((2 * m - 1) * (2 * m - 3));
 					}
-					b.push_back(calculate_Brm(c, m, lambda, r));
-					for (real i = r - real::TWO; ; i = i - real::TWO)
+					N_fraction.clear(real::ZERO);
+					N_fraction.add(first_a, table.get_betar(r) - lambda);
+					for (real i = r - 2; ; i -= 2)
 					{
-						a.push_back(calculate_Crm(c, m, i) * calculate_Arm(c, m, i + real::TWO));
-						b.push_back(calculate_Brm(c, m, lambda, i));
-						N = calculate_continued_fraction(b0, a, b);
-						if (i < r - real::TWO)
+						N_fraction.add(table.get_betarm(i + 2), table.get_betar(i) - lambda);
+						if (i < r - 2 && N_fraction.has_converged())
 						{
-							if (abs((N - prev_N) / prev_N) < real::SMALL_ENOUGH)
+							if (verbose)
 							{
-								if (verbose)
-								{
-									std::cout << "calculate_drmn_neg: " << ((N - prev_N) / prev_N).get_string(10) << std::endl;
-								}
-								break;
+								std::cout << "calculate_drmn_neg: " << N_fraction.get_change().get_string(10) << std::endl;
 							}
+							break;
 						}
-						prev_N = N;
 					}
+					N = N_fraction.get_value();
 				}
 				if (r < -real::ONE)
 				{
-					dr_neg[gnobi(r + real::TWO)] = dr_neg[gnobi(r)] / N;
-					if (r == -real::TWO * m - real::ONE)
+					dr_neg[gnobi(r + 2)] = dr_neg[gnobi(r)] / N;
+					if (r == -2 * m - 1)
 					{
 						N = real::ZERO;
 					}
 				}
 			}
 			s = dr[gzbi(real::ONE)] / (dr_neg[gnobi(-real::ONE)] / N);
-			for (real r = -n_dr_neg + real::ONE; r <= -real::ONE; r = r + real::TWO)
+			for (real r = -n_dr_neg + 1; r <= -real::ONE; r += 2)
 			{
-				dr_neg[gnobi(r)] = s * dr_neg[gnobi(r)];
+				dr_neg[gnobi(r)] *= s;
 			}
-			if (dr_neg_min == real::ZERO || abs(dr_neg[gnobi(-n_dr_neg + real::ONE)]) < dr_neg_min)
+			if (dr_neg_min == real::ZERO || abs(dr_neg[gnobi(-n_dr_neg + 1)]) < dr_neg_min)
 			{
 				break;
 			}
@@ -647,12 +897,12 @@ void calculate_drmn_neg(std::vector<real> & dr_neg, bool verbose, const real & c
 	{
 		if (remainder(n - m, real::TWO) == real::ZERO)
 		{
-			for (real r = -n_dr_neg; r <= -real::TWO; r = r + real::TWO)
+			for (real r = -n_dr_neg; r <= -real::TWO; r += 2)
 			{
 				if (abs(dr_neg[gnobi(r)]) >= dr_neg_min)
 				{
-					remove_where = r - real::THREE;
-					if (remove_where <= -n_dr_neg_orig - real::ONE && remove_where >= -n_dr_neg + real::ONE)
+					remove_where = r - 3;
+					if (remove_where <= -n_dr_neg_orig - 1 && remove_where >= -n_dr_neg + 1)
 					{
 						dr_neg.erase(dr_neg.begin() + gnobi(remove_where), dr_neg.end());
 						n_dr_neg = real((int)dr_neg.size());
@@ -663,12 +913,12 @@ void calculate_drmn_neg(std::vector<real> & dr_neg, bool verbose, const real & c
 		}
 		else
 		{
-			for (real r = -n_dr_neg + real::ONE; r <= -real::ONE; r = r + real::TWO)
+			for (real r = -n_dr_neg + 1; r <= -real::ONE; r += 2)
 			{
 				if (abs(dr_neg[gnobi(r)]) >= dr_neg_min)
 				{
-					remove_where = r - real::FOUR;
-					if (remove_where <= -n_dr_neg_orig - real::ONE && remove_where >= -n_dr_neg + real::ONE)
+					remove_where = r - 4;
+					if (remove_where <= -n_dr_neg_orig - 1 && remove_where >= -n_dr_neg + 1)
 					{
 						dr_neg.erase(dr_neg.begin() + gnobi(remove_where), dr_neg.end());
 						n_dr_neg = real((int)dr_neg.size());
@@ -680,44 +930,39 @@ void calculate_drmn_neg(std::vector<real> & dr_neg, bool verbose, const real & c
 	}
 }
 
+template <class real>
 static real get_dr(bool verbose, const real & c, const real & m, const real & n, const real & lambda, real & n_dr, std::vector<real> & dr, const real & r)
 {
 	if (r >= n_dr)
 	{
 		while (r >= n_dr)
 		{
-			n_dr = real::TWO * n_dr;
+			n_dr *= 2;
 		}
-		calculate_drmn(dr, verbose, c, m, n, lambda, n_dr, real::ZERO);
+		calculate_drmn<real>(dr, verbose, c, m, n, lambda, n_dr, real::ZERO);
 	}
 	return dr[gzbi(r)];
 }
 
+template <class real>
 real calculate_Nmn(bool verbose, const real & c, const real & m, const real & n, const real & lambda, real & n_dr, std::vector<real> & dr)
 {
 	real N;
-	adder N_adder;
-	real a;
+	adder<real> N_adder;
+	factor_table<real> a;
 	real change;
 	
 	N = real::ZERO;
 	N_adder.clear();
+	begin_Fmn_factors(a, m, n);
 	if (remainder(n - m, real::TWO) == real::ZERO)
 	{
-		for (real r = real::ZERO; ; r = r + real::TWO)
+		for (real r = real::ZERO; ; r += 2)
 		{
-			if (r > real::ZERO)
-			{
-				a = a * (((real::TWO * m + r - real::ONE) * (real::TWO * m + r)) / ((r - real::ONE) * r));
-			}
-			else
-			{
-				a = factorial(real::TWO * m);
-			}
-			change = get_dr(verbose, c, m, n, lambda, n_dr, dr, r) * get_dr(verbose, c, m, n, lambda, n_dr, dr, r) * (a / (real::TWO * m + real::TWO * r + real::ONE));
-			N = N + change;
+			change = get_dr<real>(verbose, c, m, n, lambda, n_dr, dr, r) * get_dr<real>(verbose, c, m, n, lambda, n_dr, dr, r) * (a.get(r.get_int() / 2) / (2 * m + 2 * r + 1));
+			N += change;
 			N_adder.add(change);
-			if (r > real::ZERO && abs(change) > real::ZERO && abs(change / N) < real::SMALL_ENOUGH)
+			if (r > real::ZERO && is_negligible(change, N))
 			{
 				if (verbose)
 				{
@@ -729,20 +974,12 @@ real calculate_Nmn(bool verbose, const real & c, const real & m, const real & n,
 	}
 	else
 	{
-		for (real r = real::ONE; ; r = r + real::TWO)
+		for (real r = real::ONE; ; r += 2)
 		{
-			if (r > real::ONE)
-			{
-				a = a * (((real::TWO * m + r - real::ONE) * (real::TWO * m + r)) / ((r - real::ONE) * r));
-			}
-			else
-			{
-				a = factorial(real::TWO * m + real::ONE);
-			}
-			change = get_dr(verbose, c, m, n, lambda, n_dr, dr, r) * get_dr(verbose, c, m, n, lambda, n_dr, dr, r) * (a / (real::TWO * m + real::TWO * r + real::ONE));
-			N = N + change;
+			change = get_dr<real>(verbose, c, m, n, lambda, n_dr, dr, r) * get_dr<real>(verbose, c, m, n, lambda, n_dr, dr, r) * (a.get(r.get_int() / 2) / (2 * m + 2 * r + 1));
+			N += change;
 			N_adder.add(change);
-			if (r > real::ONE && abs(change) > real::ZERO && abs(change / N) < real::SMALL_ENOUGH)
+			if (r > real::ONE && is_negligible(change, N))
 			{
 				if (verbose)
 				{
@@ -753,35 +990,29 @@ real calculate_Nmn(bool verbose, const real & c, const real & m, const real & n,
 		}
 	}
 	N = N_adder.calculate_sum();
-	N = real::TWO * N;
+	N *= 2;
 	return N;
 }
 
+template <class real>
 real calculate_Fmn(bool verbose, const real & c, const real & m, const real & n, const real & lambda, real & n_dr, std::vector<real> & dr)
 {
 	real F;
-	adder F_adder;
-	real a;
+	adder<real> F_adder;
+	factor_table<real> a;
 	real change;
 	
 	F = real::ZERO;
 	F_adder.clear();
+	begin_Fmn_factors(a, m, n);
 	if (remainder(n - m, real::TWO) == real::ZERO)
 	{
-		for (real r = real::ZERO; ; r = r + real::TWO)
+		for (real r = real::ZERO; ; r += 2)
 		{
-			if (r > real::ZERO)
-			{
-				a = a * (((real::TWO * m + r - real::ONE) * (real::TWO * m + r)) / ((r - real::ONE) * r));
-			}
-			else
-			{
-				a = factorial(real::TWO * m);
-			}
-			change = get_dr(verbose, c, m, n, lambda, n_dr, dr, r) * a;
-			F = F + change;
+			change = get_dr<real>(verbose, c, m, n, lambda, n_dr, dr, r) * a.get(r.get_int() / 2);
+			F += change;
 			F_adder.add(change);
-			if (r > real::ZERO && abs(change) > real::ZERO && abs(change / F) < real::SMALL_ENOUGH)
+			if (r > real::ZERO && is_negligible(change, F))
 			{
 				if (verbose)
 				{
@@ -793,20 +1024,12 @@ real calculate_Fmn(bool verbose, const real & c, const real & m, const real & n,
 	}
 	else
 	{
-		for (real r = real::ONE; ; r = r + real::TWO)
+		for (real r = real::ONE; ; r += 2)
 		{
-			if (r > real::ONE)
-			{
-				a = a * (((real::TWO * m + r - real::ONE) * (real::TWO * m + r)) / ((r - real::ONE) * r));
-			}
-			else
-			{
-				a = factorial(real::TWO * m + real::ONE);
-			}
-			change = get_dr(verbose, c, m, n, lambda, n_dr, dr, r) * a;
-			F = F + change;
+			change = get_dr<real>(verbose, c, m, n, lambda, n_dr, dr, r) * a.get(r.get_int() / 2);
+			F += change;
 			F_adder.add(change);
-			if (r > real::ONE && abs(change) > real::ZERO && abs(change / F) < real::SMALL_ENOUGH)
+			if (r > real::ONE && is_negligible(change, F))
 			{
 				if (verbose)
 				{
@@ -824,34 +1047,37 @@ real calculate_Fmn(bool verbose, const real & c, const real & m, const real & n,
 // In the oblate case, there's an implicit factor of 1i ^ m when n - m is even
 // and 1i ^ (m + 1) when n - m is odd.
 //
+template <class real>
 real calculate_kmn1(bool verbose, const real & c, const real & m, const real & n, const real & n_dr, const std::vector<real> & dr, const real & F)
 {
 	real k1;
 	
 	if (remainder(n - m, real::TWO) == real::ZERO)
 	{
-		k1 = ((real::TWO * m + real::ONE) * factorial(m + n) * F) / (pow(real::TWO, m + n) * dr[gzbi(real::ZERO)] * pow(c, m) * factorial(m) * factorial((n - m) / real::TWO) * factorial((m + n) / real::TWO));
+		k1 = ((2 * m + 1) * factorial(m + n) * F) / (pow(real::TWO, m + n) * dr[gzbi(real::ZERO)] * pow(c, m) * factorial(m) * factorial((n - m) / 2) * factorial((m + n) / 2));
 	}
 	else
 	{
-		k1 = ((real::TWO * m + real::THREE) * factorial(m + n + real::ONE) * F) / (pow(real::TWO, m + n) * dr[gzbi(real::ONE)] * pow(c, m + real::ONE) * factorial(m) * factorial((n - m - real::ONE) / real::TWO) * factorial((m + n + real::ONE) / real::TWO));
+		k1 = ((2 * m + 3) * factorial(m + n + 1) * F) / (pow(real::TWO, m + n) * dr[gzbi(real::ONE)] * pow(c, m + 1) * factorial(m) * factorial((n - m - 1) / 2) * factorial((m + n + 1) / 2));
 	}
 	return k1;
 }
 
+template <class real>
 static real get_dr_neg(bool verbose, const real & c, const real & m, const real & n, const real & lambda, const real & n_dr, const std::vector<real> & dr, real & n_dr_neg, std::vector<real> & dr_neg, const real & r)
 {
-	if (r <= -n_dr_neg - real::ONE)
+	if (r <= -n_dr_neg - 1)
 	{
-		while (r <= -n_dr_neg - real::ONE)
+		while (r <= -n_dr_neg - 1)
 		{
-			n_dr_neg = real::TWO * n_dr_neg;
+			n_dr_neg *= 2;
 		}
-		calculate_drmn_neg(dr_neg, verbose, c, m, n, lambda, n_dr, dr, n_dr_neg, real::ZERO);
+		calculate_drmn_neg<real>(dr_neg, verbose, c, m, n, lambda, n_dr, dr, n_dr_neg, real::ZERO);
 	}
 	return dr_neg[gnobi(r)];
 }
 
+template <class real>
 real calculate_kmn2(bool verbose, const real & c, const real & m, const real & n, const real & lambda, const real & n_dr, const std::vector<real> & dr, real & n_dr_neg, std::vector<real> & dr_neg, const real & F)
 {
 	real dr1;
@@ -859,79 +1085,152 @@ real calculate_kmn2(bool verbose, const real & c, const real & m, const real & n
 	
 	if (remainder(n - m, real::TWO) == real::ZERO)
 	{
-		if (-real::TWO * m < real::ZERO)
+		if (-2 * m < real::ZERO)
 		{
-			dr1 = get_dr_neg(verbose, c, m, n, lambda, n_dr, dr, n_dr_neg, dr_neg, -real::TWO * m);
+			dr1 = get_dr_neg<real>(verbose, c, m, n, lambda, n_dr, dr, n_dr_neg, dr_neg, -2 * m);
 		}
 		else
 		{
 			dr1 = dr[gzbi(real::ZERO)];
 		}
-		k2 = (pow(real::TWO, n - m) * factorial(real::TWO * m) * factorial((n - m) / real::TWO) * factorial((m + n) / real::TWO) * dr1 * F) / ((real::TWO * m - real::ONE) * factorial(m) * factorial(m + n) * pow(c, m - real::ONE));
+		k2 = (pow(real::TWO, n - m) * factorial(2 * m) * factorial((n - m) / 2) * factorial((m + n) / 2) * dr1 * F) / ((2 * m - 1) * factorial(m) * factorial(m + n) * pow(c, m - 1));
 	}
 	else
 	{
-		if (-real::TWO * m + real::ONE < real::ONE)
+		if (-2 * m + 1 < real::ONE)
 		{
-			dr1 = get_dr_neg(verbose, c, m, n, lambda, n_dr, dr, n_dr_neg, dr_neg, -real::TWO * m + real::ONE);
+			dr1 = get_dr_neg<real>(verbose, c, m, n, lambda, n_dr, dr, n_dr_neg, dr_neg, -2 * m + 1);
 		}
 		else
 		{
 			dr1 = dr[gzbi(real::ONE)];
 		}
-		k2 = -((pow(real::TWO, n - m) * factorial(real::TWO * m) * factorial((n - m - real::ONE) / real::TWO) * factorial((m + n + real::ONE) / real::TWO) * dr1 * F) / ((real::TWO * m - real::THREE) * (real::TWO * m - real::ONE) * factorial(m) * factorial(m + n + real::ONE) * pow(c, m - real::TWO)));
+		k2 = -((pow(real::TWO, n - m) * factorial(2 * m) * factorial((n - m - 1) / 2) * factorial((m + n + 1) / 2) * dr1 * F) / ((2 * m - 3) * (2 * m - 1) * factorial(m) * factorial(m + n + 1) * pow(c, m - 2)));
 	}
 	return k2;
 }
 
+//
+// Starts a with the factors of the sums for N and F, (2m + r)! / r!, for r =
+// 0, 2, 4, ... when n - m is even, and r = 1, 3, 5, ... when it's odd.
+//
+template <class real>
+static void begin_Fmn_factors(factor_table<real> & a, const real & m, const real & n)
+{
+	long mm;
+	long r0;
+	mpz_t a0;
+	
+	mm = m.get_int();
+	r0 = remainder(n - m, real::TWO) == real::ZERO ? 0 : 1;
+	mpz_init(a0);
+	binary_splitting::calculate_product(a0, [](long j) { return j; }, 1, 2 * mm + r0 + 1);
+	a.begin(a0, 0, [=](long & p, unsigned long & q, long i)
+	{
+		long r;
+		
+		r = r0 + 2 * i;
+		p = (2 * mm + r - 1) * (2 * mm + r);
+		q = (unsigned long)((r - 1) * r);
+	});
+	mpz_clear(a0);
+}
+
+//
+// Starts a with the factors of the sum for c_2k.  When n - m is even, they're
+// (2m + r)! / r! * (-r / 2)_k * (m + r / 2 + 1 / 2)_k, for r = 2k, 2k + 2,
+// ..., and when it's odd, they're (2m + r)! / r! * (-(r - 1) / 2)_k * (m + r
+// / 2 + 1)_k, for r = 2k + 1, 2k + 3, ....  The second Pochhammer symbol is k
+// odd (or even) numbers over 2^k, so the rest is an integer.
+//
+template <class real>
+static void begin_c2kmn_factors(factor_table<real> & a, const real & m, const real & n, const real & k)
+{
+	long mm;
+	long kk;
+	long r0;
+	long s;
+	mpz_t a0;
+	
+	mm = m.get_int();
+	kk = k.get_int();
+	if (remainder(n - m, real::TWO) == real::ZERO)
+	{
+		r0 = 2 * kk;
+		s = 1;
+	}
+	else
+	{
+		r0 = 2 * kk + 1;
+		s = 2;
+	}
+	mpz_init(a0);
+	binary_splitting::calculate_product(a0, [=](long j)
+	{
+		if (j < 2 * mm)
+		{
+			return r0 + 1 + j;
+		}
+		else if (j < 2 * mm + kk)
+		{
+			return -(j - 2 * mm + 1);
+		}
+		else
+		{
+			return 2 * mm + r0 + s + 2 * (j - 2 * mm - kk);
+		}
+	}, 0, 2 * mm + 2 * kk);
+	a.begin(a0, -kk, [=](long & p, unsigned long & q, long i)
+	{
+		long r;
+		
+		r = r0 + 2 * i;
+		if (s == 1)
+		{
+			p = (2 * mm + r) * (r / 2) * (2 * mm + r + 2 * kk - 1);
+			q = (unsigned long)(r * (r - 1) * (r / 2 - kk));
+		}
+		else
+		{
+			p = (2 * mm + r - 1) * ((r - 1) / 2) * (2 * mm + r + 2 * kk);
+			q = (unsigned long)(r * (r - 1) * ((r - 1) / 2 - kk));
+		}
+	});
+	mpz_clear(a0);
+}
+
+template <class real>
 void calculate_c2kmn(std::vector<real> & c2k, bool verbose, const real & c, const real & m, const real & n, const real & lambda, real & n_dr, std::vector<real> & dr, real & n_c2k, const real & c2k_min)
 {
 	real n_c2k_orig;
 	real prev_n_c2k;
-	adder c2k_adder;
-	real a;
-	real a0;
+	adder<real> c2k_adder;
+	series_tail<real> c2k_tail;
+	factor_table<real> a;
 	real change;
 	real remove_where;
 	
 	n_c2k_orig = n_c2k;
-	for (prev_n_c2k = real((int)c2k.size()); ; prev_n_c2k = n_c2k, n_c2k = real::TWO * n_c2k)
+	for (prev_n_c2k = real((int)c2k.size()); ; prev_n_c2k = n_c2k, n_c2k = 2 * n_c2k)
 	{
-		for (real k = prev_n_c2k; k <= n_c2k - real::ONE; k = k + real::ONE)
+		for (real k = prev_n_c2k; k <= n_c2k - 1; k += 1)
 		{
 			c2k.push_back(real::ZERO);
 		}
-		for (real k = prev_n_c2k; k <= n_c2k - real::ONE; k = k + real::ONE)
+		for (real k = prev_n_c2k; k <= n_c2k - 1; k += 1)
 		{
 			c2k[gzbi(k)] = real::ZERO;
 			c2k_adder.clear();
+			c2k_tail.clear();
+			begin_c2kmn_factors(a, m, n, k);
 			if (remainder(n - m, real::TWO) == real::ZERO)
 			{
-				for (real r = real::TWO * k; ; r = r + real::TWO)
+				for (real r = 2 * k; ; r += 2)
 				{
-					if (r > real::TWO * k)
-					{
-						a = a * (((real::TWO * m + r - real::ONE) * (real::TWO * m + r) * (-r / real::TWO) * (m + r / real::TWO + k - real::ONE / real::TWO)) / ((r - real::ONE) * r * (-r / real::TWO + k) * (m + r / real::TWO - real::ONE / real::TWO)));
-						if (r == real::TWO * k + real::TWO)
-						{
-							a0 = a;
-						}
-					}
-					else
-					{
-						if (k > prev_n_c2k)
-						{
-							a = a0 * (-real::ONE) * (m + real::TWO * k - real::ONE / real::TWO);
-						}
-						else
-						{
-							a = (factorial(real::TWO * m + r) / factorial(r)) * pochhammer(-r / real::TWO, prev_n_c2k) * pochhammer(m + r / real::TWO + real::ONE / real::TWO, prev_n_c2k);
-						}
-					}
-					change = get_dr(verbose, c, m, n, lambda, n_dr, dr, r) * a;
-					c2k[gzbi(k)] = c2k[gzbi(k)] + change;
+					c2k_tail.multiply(change, get_dr<real>(verbose, c, m, n, lambda, n_dr, dr, r), a.get((r - 2 * k).get_int() / 2), c2k[gzbi(k)]);
+					c2k[gzbi(k)] += change;
 					c2k_adder.add(change);
-					if (r > real::TWO * k && abs(change) > real::ZERO && abs(change / c2k[gzbi(k)]) < real::SMALL_ENOUGH)
+					if (r > 2 * k && is_negligible(change, c2k[gzbi(k)]))
 					{
 						if (verbose)
 						{
@@ -943,31 +1242,12 @@ void calculate_c2kmn(std::vector<real> & c2k, bool verbose, const real & c, cons
 			}
 			else
 			{
-				for (real r = real::TWO * k + real::ONE; ; r = r + real::TWO)
+				for (real r = 2 * k + 1; ; r += 2)
 				{
-					if (r > real::TWO * k + real::ONE)
-					{
-						a = a * (((real::TWO * m + r - real::ONE) * (real::TWO * m + r) * (-r / real::TWO + real::ONE / real::TWO) * (m + r / real::TWO + k)) / ((r - real::ONE) * r * (-r / real::TWO + k + real::ONE / real::TWO) * (m + r / real::TWO)));
-						if (r == real::TWO * k + real::THREE)
-						{
-							a0 = a;
-						}
-					}
-					else
-					{
-						if (k > prev_n_c2k)
-						{
-							a = a0 * (-real::ONE) * (m + real::TWO * k + real::ONE / real::TWO);
-						}
-						else
-						{
-							a = (factorial(real::TWO * m + r) / factorial(r)) * pochhammer(-(r - real::ONE) / real::TWO, prev_n_c2k) * pochhammer(m + r / real::TWO + real::ONE, prev_n_c2k);
-						}
-					}
-					change = get_dr(verbose, c, m, n, lambda, n_dr, dr, r) * a;
-					c2k[gzbi(k)] = c2k[gzbi(k)] + change;
+					c2k_tail.multiply(change, get_dr<real>(verbose, c, m, n, lambda, n_dr, dr, r), a.get((r - 2 * k).get_int() / 2), c2k[gzbi(k)]);
+					c2k[gzbi(k)] += change;
 					c2k_adder.add(change);
-					if (r > real::TWO * k + real::ONE && abs(change) > real::ZERO && abs(change / c2k[gzbi(k)]) < real::SMALL_ENOUGH)
+					if (r > 2 * k + 1 && is_negligible(change, c2k[gzbi(k)]))
 					{
 						if (verbose)
 						{
@@ -977,22 +1257,23 @@ void calculate_c2kmn(std::vector<real> & c2k, bool verbose, const real & c, cons
 					}
 				}
 			}
+			c2k_tail.report(verbose, "calculate_c2kmn");
 			c2k[gzbi(k)] = c2k_adder.calculate_sum();
-			c2k[gzbi(k)] = (real::ONE / (pow(real::TWO, m) * factorial(m + k) * factorial(k))) * c2k[gzbi(k)];
+			c2k[gzbi(k)] *= 1 / (pow(real::TWO, m) * factorial(m + k) * factorial(k));
 		}
-		if (c2k_min == real::ZERO || abs(c2k[gzbi(n_c2k - real::ONE)]) < c2k_min)
+		if (c2k_min == real::ZERO || abs(c2k[gzbi(n_c2k - 1)]) < c2k_min)
 		{
 			break;
 		}
 	}
 	if (c2k_min > real::ZERO)
 	{
-		for (real k = n_c2k - real::ONE; k >= real::ZERO; k = k - real::ONE)
+		for (real k = n_c2k - 1; k >= real::ZERO; k -= 1)
 		{
 			if (abs(c2k[gzbi(k)]) >= c2k_min)
 			{
-				remove_where = k + real::TWO;
-				if (remove_where >= n_c2k_orig && remove_where <= n_c2k - real::ONE)
+				remove_where = k + 2;
+				if (remove_where >= n_c2k_orig && remove_where <= n_c2k - 1)
 				{
 					c2k.erase(c2k.begin() + gzbi(remove_where), c2k.end());
 					n_c2k = real((int)c2k.size());
@@ -1003,10 +1284,13 @@ void calculate_c2kmn(std::vector<real> & c2k, bool verbose, const real & c, cons
 	}
 }
 
+template <class real>
 void calculate_Smn1_1(real & S1, real & S1p, bool verbose, const real & c, const real & m, const real & n, const real & n_dr, const std::vector<real> & dr, const real & eta)
 {
-	adder S1_adder;
-	adder S1p_adder;
+	adder<real> S1_adder;
+	series_tail<real> S1_tail;
+	adder<real> S1p_adder;
+	series_tail<real> S1p_tail;
 	real P0;
 	real P1;
 	real P0p;
@@ -1019,23 +1303,23 @@ void calculate_Smn1_1(real & S1, real & S1p, bool verbose, const real & c, const
 	S1p = real::ZERO;
 	S1p_adder.clear();
 	P0 = real::ONE;
-	for (real v = real::ONE; v <= m; v = v + real::ONE)
+	for (real v = real::ONE; v <= m; v += 1)
 	{
-		P0 = -(real::TWO * v - real::ONE) * pow(real::ONE - eta * eta, real::ONE / real::TWO) * P0;
+		P0 = -(2 * v - 1) * sqrt(1 - eta * eta) * P0;
 	}
-	P1 = (real::TWO * m + real::ONE) * eta * P0;
+	P1 = (2 * m + 1) * eta * P0;
 	if (remainder(n - m, real::TWO) == real::ZERO)
 	{
-		for (real r = real::ZERO; r <= n_dr - real::TWO; r = r + real::TWO)
+		for (real r = real::ZERO; r <= n_dr - 2; r += 2)
 		{
 			if (r > real::ZERO)
 			{
-				P0 = (real::ONE / r) * (-(real::TWO * m + r - real::ONE) * P0 + (real::TWO * m + real::TWO * r - real::ONE) * eta * P1);
-				P1 = (real::ONE / (r + real::ONE)) * (-(real::TWO * m + r) * P1 + (real::TWO * m + real::TWO * r + real::ONE) * eta * P0);
+				P0 = (1 / r) * (-(2 * m + r - 1) * P0 + (2 * m + 2 * r - 1) * eta * P1);
+				P1 = (1 / (r + 1)) * (-(2 * m + r) * P1 + (2 * m + 2 * r + 1) * eta * P0);
 			}
 			if (abs(eta) < real::ONE)
 			{
-				P0p = (real::ONE / (real::ONE - eta * eta)) * ((m + r + real::ONE) * eta * P0 - (r + real::ONE) * P1);
+				P0p = (1 / (1 - eta * eta)) * ((m + r + 1) * eta * P0 - (r + 1) * P1);
 			}
 			else
 			{
@@ -1045,7 +1329,7 @@ void calculate_Smn1_1(real & S1, real & S1p, bool verbose, const real & c, const
 				}
 				else if (m > real::ONE)
 				{
-					P0p = -((m + r - real::ONE) * (m + r) * (m + r + real::ONE) * (m + r + real::TWO)) / real::FOUR;
+					P0p = -((m + r - 1) * (m + r) * (m + r + 1) * (m + r + 2)) / 4;
 				}
 				else if (m > real::ZERO)
 				{
@@ -1053,20 +1337,20 @@ void calculate_Smn1_1(real & S1, real & S1p, bool verbose, const real & c, const
 				}
 				else
 				{
-					P0p = ((m + r) * (m + r + real::ONE)) / real::TWO;
+					P0p = ((m + r) * (m + r + 1)) / 2;
 				}
 				if (eta == -real::ONE)
 				{
 					P0p = -P0p;
 				}
 			}
-			change = dr[gzbi(r)] * P0;
-			S1 = S1 + change;
+			S1_tail.multiply(change, dr[gzbi(r)], P0, S1);
+			S1 += change;
 			S1_adder.add(change);
-			changep = dr[gzbi(r)] * P0p;
-			S1p = S1p + changep;
+			S1p_tail.multiply(changep, dr[gzbi(r)], P0p, S1p);
+			S1p += changep;
 			S1p_adder.add(changep);
-			if (r > real::ZERO && abs(change) > real::ZERO && abs(change / S1) < real::SMALL_ENOUGH && abs(changep) > real::ZERO && abs(changep / S1p) < real::SMALL_ENOUGH)
+			if (r > real::ZERO && is_negligible(change, S1) && is_negligible(changep, S1p))
 			{
 				if (verbose)
 				{
@@ -1078,16 +1362,16 @@ void calculate_Smn1_1(real & S1, real & S1p, bool verbose, const real & c, const
 	}
 	else
 	{
-		for (real r = real::ONE; r <= n_dr - real::ONE; r = r + real::TWO)
+		for (real r = real::ONE; r <= n_dr - 1; r += 2)
 		{
 			if (r > real::ONE)
 			{
-				P0 = (real::ONE / (r - real::ONE)) * (-(real::TWO * m + r - real::TWO) * P0 + (real::TWO * m + real::TWO * r - real::THREE) * eta * P1);
-				P1 = (real::ONE / r) * (-(real::TWO * m + r - real::ONE) * P1 + (real::TWO * m + real::TWO * r - real::ONE) * eta * P0);
+				P0 = (1 / (r - 1)) * (-(2 * m + r - 2) * P0 + (2 * m + 2 * r - 3) * eta * P1);
+				P1 = (1 / r) * (-(2 * m + r - 1) * P1 + (2 * m + 2 * r - 1) * eta * P0);
 			}
 			if (abs(eta) < real::ONE)
 			{
-				P1p = (real::ONE / (real::ONE - eta * eta)) * ((real::TWO * m + r) * P0 - (m + r) * eta * P1);
+				P1p = (1 / (1 - eta * eta)) * ((2 * m + r) * P0 - (m + r) * eta * P1);
 			}
 			else
 			{
@@ -1097,7 +1381,7 @@ void calculate_Smn1_1(real & S1, real & S1p, bool verbose, const real & c, const
 				}
 				else if (m > real::ONE)
 				{
-					P1p = -((m + r - real::ONE) * (m + r) * (m + r + real::ONE) * (m + r + real::TWO)) / real::FOUR;
+					P1p = -((m + r - 1) * (m + r) * (m + r + 1) * (m + r + 2)) / 4;
 				}
 				else if (m > real::ZERO)
 				{
@@ -1105,16 +1389,16 @@ void calculate_Smn1_1(real & S1, real & S1p, bool verbose, const real & c, const
 				}
 				else
 				{
-					P1p = ((m + r) * (m + r + real::ONE)) / real::TWO;
+					P1p = ((m + r) * (m + r + 1)) / 2;
 				}
 			}
-			change = dr[gzbi(r)] * P1;
-			S1 = S1 + change;
+			S1_tail.multiply(change, dr[gzbi(r)], P1, S1);
+			S1 += change;
 			S1_adder.add(change);
-			changep = dr[gzbi(r)] * P1p;
-			S1p = S1p + changep;
+			S1p_tail.multiply(changep, dr[gzbi(r)], P1p, S1p);
+			S1p += changep;
 			S1p_adder.add(changep);
-			if (r > real::ONE && abs(change) > real::ZERO && abs(change / S1) < real::SMALL_ENOUGH && abs(changep) > real::ZERO && abs(changep / S1p) < real::SMALL_ENOUGH)
+			if (r > real::ONE && is_negligible(change, S1) && is_negligible(changep, S1p))
 			{
 				if (verbose)
 				{
@@ -1124,35 +1408,38 @@ void calculate_Smn1_1(real & S1, real & S1p, bool verbose, const real & c, const
 			}
 		}
 	}
+	S1_tail.report(verbose, "calculate_Smn1_1");
+	S1p_tail.report(verbose, "calculate_Smn1_1");
 	S1 = S1_adder.calculate_sum();
 	S1p = S1p_adder.calculate_sum();
 }
 
+template <class real>
 void calculate_Smn1_2(real & S1, real & S1p, bool verbose, const real & c, const real & m, const real & n, const real & n_c2k, const std::vector<real> & c2k, const real & eta)
 {
-	adder S1_adder;
+	adder<real> S1_adder;
 	real a;
 	real change;
-	adder S1p_adder;
+	adder<real> S1p_adder;
 	real ap;
 	real changep;
 	
 	S1 = real::ZERO;
 	S1_adder.clear();
-	for (real k = real::ZERO; k <= n_c2k - real::ONE; k = k + real::ONE)
+	for (real k = real::ZERO; k <= n_c2k - 1; k += 1)
 	{
 		if (k > real::ZERO)
 		{
-			a = a * (real::ONE - eta * eta);
+			a *= 1 - eta * eta;
 		}
 		else
 		{
 			a = real::ONE;
 		}
 		change = c2k[gzbi(k)] * a;
-		S1 = S1 + change;
+		S1 += change;
 		S1_adder.add(change);
-		if (k > real::ZERO && abs(change) > real::ZERO && abs(change / S1) < real::SMALL_ENOUGH)
+		if (k > real::ZERO && is_negligible(change, S1))
 		{
 			if (verbose)
 			{
@@ -1164,20 +1451,20 @@ void calculate_Smn1_2(real & S1, real & S1p, bool verbose, const real & c, const
 	S1 = S1_adder.calculate_sum();
 	S1p = real::ZERO;
 	S1p_adder.clear();
-	for (real k = real::ONE; k <= n_c2k - real::ONE; k = k + real::ONE)
+	for (real k = real::ONE; k <= n_c2k - 1; k += 1)
 	{
 		if (k > real::ONE)
 		{
-			ap = ap * (real::ONE - eta * eta);
+			ap *= 1 - eta * eta;
 		}
 		else
 		{
 			ap = real::ONE;
 		}
-		changep = c2k[gzbi(k)] * k * ap * (-real::TWO * eta);
-		S1p = S1p + changep;
+		changep = c2k[gzbi(k)] * k * ap * (-2 * eta);
+		S1p += changep;
 		S1p_adder.add(changep);
-		if (k > real::ONE && abs(changep) > real::ZERO && abs(changep / S1p) < real::SMALL_ENOUGH)
+		if (k > real::ONE && is_negligible(changep, S1p))
 		{
 			if (verbose)
 			{
@@ -1191,104 +1478,77 @@ void calculate_Smn1_2(real & S1, real & S1p, bool verbose, const real & c, const
 	{
 		if (m > real::ZERO)
 		{
-			S1p = pow(-real::ONE, m) * (m / real::TWO) * pow(real::ONE - eta * eta, m / real::TWO - real::ONE) * (-real::TWO * eta) * S1 + pow(-real::ONE, m) * pow(real::ONE - eta * eta, m / real::TWO) * S1p;
+			S1p = sign_pow(m) * (m / 2) * pow(1 - eta * eta, m / real::TWO - real::ONE) * (-2 * eta) * S1 + sign_pow(m) * pow(1 - eta * eta, m / 2) * S1p;
 		}
 		else
 		{
-			S1p = pow(-real::ONE, m) * S1p;
+			S1p *= sign_pow(m);
 		}
-		S1 = pow(-real::ONE, m) * pow(real::ONE - eta * eta, m / real::TWO) * S1;
+		S1 = sign_pow(m) * pow(1 - eta * eta, m / 2) * S1;
 	}
 	else
 	{
 		if (m > real::ZERO)
 		{
-			S1p = pow(-real::ONE, m) * pow(real::ONE - eta * eta, m / real::TWO) * S1 + pow(-real::ONE, m) * eta * (m / real::TWO) * pow(real::ONE - eta * eta, m / real::TWO - real::ONE) * (-real::TWO * eta) * S1 + pow(-real::ONE, m) * eta * pow(real::ONE - eta * eta, m / real::TWO) * S1p;
+			S1p = sign_pow(m) * pow(1 - eta * eta, m / 2) * S1 + sign_pow(m) * eta * (m / 2) * pow(1 - eta * eta, m / real::TWO - real::ONE) * (-2 * eta) * S1 + sign_pow(m) * eta * pow(1 - eta * eta, m / 2) * S1p;
 		}
 		else
 		{
-			S1p = pow(-real::ONE, m) * S1 + pow(-real::ONE, m) * eta * S1p;
+			S1p = sign_pow(m) * S1 + sign_pow(m) * eta * S1p;
 		}
-		S1 = pow(-real::ONE, m) * eta * pow(real::ONE - eta * eta, m / real::TWO) * S1;
+		S1 = sign_pow(m) * eta * pow(1 - eta * eta, m / 2) * S1;
 	}
 }
 
+template <class real>
 void calculate_Rmn1_1_shared(real & R1, real & R1p, bool verbose, const real & c, const real & m, const real & n, const real & n_dr, const std::vector<real> & dr, const real & xi)
 {
 	std::vector<real> jn;
-	real b0;
-	std::vector<real> a;
-	std::vector<real> b;
-	real N;
-	real prev_N;
-	real s;
+	minimal_solution<real, real> jn_solution;
 	std::vector<real> jnp;
-	adder R1_adder;
-	adder R1p_adder;
+	adder<real> R1_adder;
+	series_tail<real> R1_tail;
+	adder<real> R1p_adder;
+	series_tail<real> R1p_tail;
 	real d;
+	real ddr;
 	real change;
 	real changep;
 	
 	if (xi > real::ZERO)
 	{
 		jn.clear();
-		for (real v = real::ZERO; v <= m + n_dr; v = v + real::ONE)
+		for (real v = real::ZERO; v <= m + n_dr; v += 1)
 		{
 			jn.push_back(real::ZERO);
 		}
-		jn[gzbi(m + n_dr)] = real::ONE;
-		for (real v = m + n_dr; v >= real::ONE; v = v - real::ONE)
+		jn_solution.calculate_ratios(verbose, "calculate_Rmn1_1", [&](real & a_v, real & b_v, real & c_v, const real & v)
 		{
-			if (v < m + n_dr)
-			{
-				N = real::ONE / ((real::TWO * v + real::ONE) / (c * xi) - N);
-			}
-			else
-			{
-				b0 = real::ZERO;
-				a.clear();
-				b.clear();
-				for (real i = v; i < v + real("10000.0"); i = i + real::ONE)
-				{
-					a.push_back(real::ONE);
-					b.push_back((real::TWO * i + real::ONE) / (c * xi));
-					N = -calculate_continued_fraction(b0, a, b);
-					if (i > v)
-					{
-						if (abs((N - prev_N) / prev_N) < real::SMALL_ENOUGH)
-						{
-							if (verbose)
-							{
-								std::cout << "calculate_Rmn1_1: " << ((N - prev_N) / prev_N).get_string(10) << std::endl;
-							}
-							break;
-						}
-					}
-					prev_N = N;
-				}
-			}
-			jn[gzbi(v - real::ONE)] = jn[gzbi(v)] / N;
-		}
-		s = (sin(c * xi) / (c * xi)) / jn[gzbi(real::ZERO)];
-		for (real v = real::ZERO; v <= m + n_dr; v = v + real::ONE)
+			a_v = real::ONE;
+			b_v = (2 * v + 1) / (c * xi);
+			c_v = real::ONE;
+		}, real::ZERO, m + n_dr, real::ONE, real(10000), minimal_solution<real, real>::EVERY_TERM);
+		jn_solution.calculate_backward(jn);
+		jn_solution.scale(jn, (sin(c * xi) / (c * xi)) / jn[gzbi(real::ZERO)]);
+		if (verbose)
 		{
-			jn[gzbi(v)] = s * jn[gzbi(v)];
+			jn_solution.print_times("calculate_Rmn1_1");
 		}
 		jnp.clear();
-		for (real v = real::ZERO; v <= m + n_dr - real::ONE; v = v + real::ONE)
+		for (real v = real::ZERO; v <= m + n_dr - 1; v += 1)
 		{
 			jnp.push_back(real::ZERO);
 		}
-		for (real v = real::ZERO; v <= m + n_dr - real::ONE; v = v + real::ONE)
+		for (real v = real::ZERO; v <= m + n_dr - 1; v += 1)
 		{
-			jnp[gzbi(v)] = (v / (c * xi)) * jn[gzbi(v)] - jn[gzbi(v + real::ONE)];
+			jnp[gzbi(v)] = (v / (c * xi)) * jn[gzbi(v)] - jn[gzbi(v + 1)];
 		}
 	}
 	else
 	{
 		jn.clear();
 		jnp.clear();
-		for (real v = real::ZERO; v <= m + n_dr - real::ONE; v = v + real::ONE)
+		for (real v = real::ZERO; v <= m + n_dr - 1; v += 1)
 		{
 			jn.push_back(real::ZERO);
 			jnp.push_back(real::ZERO);
@@ -1302,23 +1562,24 @@ void calculate_Rmn1_1_shared(real & R1, real & R1p, bool verbose, const real & c
 	R1p_adder.clear();
 	if (remainder(n - m, real::TWO) == real::ZERO)
 	{
-		for (real r = real::ZERO; r <= n_dr - real::TWO; r = r + real::TWO)
+		for (real r = real::ZERO; r <= n_dr - 2; r += 2)
 		{
 			if (r > real::ZERO)
 			{
-				d = d * -real::ONE * (((real::TWO * m + r - real::ONE) * (real::TWO * m + r)) / ((r - real::ONE) * r));
+				d *= -real::ONE * (((2 * m + r - 1) * (2 * m + r)) / ((r - 1) * r));
 			}
 			else
 			{
-				d = pow(-real::ONE, -(n - m) / real::TWO) * factorial(real::TWO * m);
+				d = sign_pow(-(n - m) / 2) * factorial(2 * m);
 			}
-			change = d * dr[gzbi(r)] * jn[gzbi(m + r)];
-			R1 = R1 + change;
+			ddr = d * dr[gzbi(r)];
+			R1_tail.multiply(change, ddr, jn[gzbi(m + r)], R1);
+			R1 += change;
 			R1_adder.add(change);
-			changep = d * dr[gzbi(r)] * jnp[gzbi(m + r)] * c;
-			R1p = R1p + changep;
+			R1p_tail.multiply(changep, ddr, jnp[gzbi(m + r)], c, R1p);
+			R1p += changep;
 			R1p_adder.add(changep);
-			if (r > real::ZERO && abs(change) > real::ZERO && abs(change / R1) < real::SMALL_ENOUGH && abs(changep) > real::ZERO && abs(changep / R1p) < real::SMALL_ENOUGH)
+			if (r > real::ZERO && is_negligible(change, R1) && is_negligible(changep, R1p))
 			{
 				if (verbose)
 				{
@@ -1330,23 +1591,24 @@ void calculate_Rmn1_1_shared(real & R1, real & R1p, bool verbose, const real & c
 	}
 	else
 	{
-		for (real r = real::ONE; r <= n_dr - real::ONE; r = r + real::TWO)
+		for (real r = real::ONE; r <= n_dr - 1; r += 2)
 		{
 			if (r > real::ONE)
 			{
-				d = d * -real::ONE * (((real::TWO * m + r - real::ONE) * (real::TWO * m + r)) / ((r - real::ONE) * r));
+				d *= -real::ONE * (((2 * m + r - 1) * (2 * m + r)) / ((r - 1) * r));
 			}
 			else
 			{
-				d = pow(-real::ONE, (real::ONE - (n - m)) / real::TWO) * factorial(real::TWO * m + real::ONE);
+				d = sign_pow((1 - (n - m)) / 2) * factorial(2 * m + 1);
 			}
-			change = d * dr[gzbi(r)] * jn[gzbi(m + r)];
-			R1 = R1 + change;
+			ddr = d * dr[gzbi(r)];
+			R1_tail.multiply(change, ddr, jn[gzbi(m + r)], R1);
+			R1 += change;
 			R1_adder.add(change);
-			changep = d * dr[gzbi(r)] * jnp[gzbi(m + r)] * c;
-			R1p = R1p + changep;
+			R1p_tail.multiply(changep, ddr, jnp[gzbi(m + r)], c, R1p);
+			R1p += changep;
 			R1p_adder.add(changep);
-			if (r > real::ONE && abs(change) > real::ZERO && abs(change / R1) < real::SMALL_ENOUGH && abs(changep) > real::ZERO && abs(changep / R1p) < real::SMALL_ENOUGH)
+			if (r > real::ONE && is_negligible(change, R1) && is_negligible(changep, R1p))
 			{
 				if (verbose)
 				{
@@ -1356,17 +1618,20 @@ void calculate_Rmn1_1_shared(real & R1, real & R1p, bool verbose, const real & c
 			}
 		}
 	}
+	R1_tail.report(verbose, "calculate_Rmn1_1");
+	R1p_tail.report(verbose, "calculate_Rmn1_1");
 	R1 = R1_adder.calculate_sum();
 	R1p = R1p_adder.calculate_sum();
 }
 
+template <class real>
 void calculate_Rmn2_1_shared(real & R2, real & R2p, bool verbose, const real & c, const real & m, const real & n, const real & n_dr, const std::vector<real> & dr, const real & xi)
 {
 	real y0;
 	real y1;
 	real y2;
-	adder R2_adder;
-	adder R2p_adder;
+	adder<real> R2_adder;
+	adder<real> R2p_adder;
 	real a;
 	real y0p;
 	real change;
@@ -1375,9 +1640,9 @@ void calculate_Rmn2_1_shared(real & R2, real & R2p, bool verbose, const real & c
 	
 	y0 = -cos(c * xi) / (c * xi);
 	y1 = -cos(c * xi) / ((c * xi) * (c * xi)) - sin(c * xi) / (c * xi);
-	for (real v = real::ZERO; v <= m - real::ONE; v = v + real::ONE)
+	for (real v = real::ZERO; v <= m - 1; v += 1)
 	{
-		y2 = -y0 + ((real::TWO * v + real::THREE) / (c * xi)) * y1;
+		y2 = -y0 + ((2 * v + 3) / (c * xi)) * y1;
 		y0 = y1;
 		y1 = y2;
 	}
@@ -1387,24 +1652,24 @@ void calculate_Rmn2_1_shared(real & R2, real & R2p, bool verbose, const real & c
 	R2p_adder.clear();
 	if (remainder(n - m, real::TWO) == real::ZERO)
 	{
-		for (real r = real::ZERO; r <= n_dr - real::TWO; r = r + real::TWO)
+		for (real r = real::ZERO; r <= n_dr - 2; r += 2)
 		{
 			if (r > real::ZERO)
 			{
-				a = a * -real::ONE * (((real::TWO * m + r - real::ONE) * (real::TWO * m + r)) / ((r - real::ONE) * r));
+				a *= -real::ONE * (((2 * m + r - 1) * (2 * m + r)) / ((r - 1) * r));
 			}
 			else
 			{
-				a = pow(-real::ONE, -(n - m) / real::TWO) * factorial(real::TWO * m);
+				a = sign_pow(-(n - m) / 2) * factorial(2 * m);
 			}
 			y0p = ((m + r) / (c * xi)) * y0 - y1;
 			change = a * dr[gzbi(r)] * y0;
-			R2 = R2 + change;
+			R2 += change;
 			R2_adder.add(change);
 			changep = a * dr[gzbi(r)] * y0p * c;
-			R2p = R2p + changep;
+			R2p += changep;
 			R2p_adder.add(changep);
-			if (r > real::ZERO && abs(change) > real::ZERO && abs(change / R2) < real::SMALL_ENOUGH && abs(changep) > real::ZERO && abs(changep / R2p) < real::SMALL_ENOUGH)
+			if (r > real::ZERO && is_negligible(change, R2) && is_negligible(changep, R2p))
 			{
 				if (verbose)
 				{
@@ -1412,30 +1677,30 @@ void calculate_Rmn2_1_shared(real & R2, real & R2p, bool verbose, const real & c
 				}
 				break;
 			}
-			y0 = -y0 + ((real::TWO * (m + r) + real::THREE) / (c * xi)) * y1;
-			y1 = -y1 + ((real::TWO * (m + r + real::ONE) + real::THREE) / (c * xi)) * y0;
+			y0 = -y0 + ((2 * (m + r) + 3) / (c * xi)) * y1;
+			y1 = -y1 + ((2 * (m + r + 1) + 3) / (c * xi)) * y0;
 		}
 	}
 	else
 	{
-		for (real r = real::ONE; r <= n_dr - real::ONE; r = r + real::TWO)
+		for (real r = real::ONE; r <= n_dr - 1; r += 2)
 		{
 			if (r > real::ONE)
 			{
-				a = a * -real::ONE * (((real::TWO * m + r - real::ONE) * (real::TWO * m + r)) / ((r - real::ONE) * r));
+				a *= -real::ONE * (((2 * m + r - 1) * (2 * m + r)) / ((r - 1) * r));
 			}
 			else
 			{
-				a = pow(-real::ONE, (real::ONE - (n - m)) / real::TWO) * factorial(real::TWO * m + real::ONE);
+				a = sign_pow((1 - (n - m)) / 2) * factorial(2 * m + 1);
 			}
-			y1p = y0 - ((m + r + real::ONE) / (c * xi)) * y1;
+			y1p = y0 - ((m + r + 1) / (c * xi)) * y1;
 			change = a * dr[gzbi(r)] * y1;
-			R2 = R2 + change;
+			R2 += change;
 			R2_adder.add(change);
 			changep = a * dr[gzbi(r)] * y1p * c;
-			R2p = R2p + changep;
+			R2p += changep;
 			R2p_adder.add(changep);
-			if (r > real::ONE && abs(change) > real::ZERO && abs(change / R2) < real::SMALL_ENOUGH && abs(changep) > real::ZERO && abs(changep / R2p) < real::SMALL_ENOUGH)
+			if (r > real::ONE && is_negligible(change, R2) && is_negligible(changep, R2p))
 			{
 				if (verbose)
 				{
@@ -1443,10 +1708,28 @@ void calculate_Rmn2_1_shared(real & R2, real & R2p, bool verbose, const real & c
 				}
 				break;
 			}
-			y0 = -y0 + ((real::TWO * (m + r - real::ONE) + real::THREE) / (c * xi)) * y1;
-			y1 = -y1 + ((real::TWO * (m + r) + real::THREE) / (c * xi)) * y0;
+			y0 = -y0 + ((2 * (m + r - 1) + 3) / (c * xi)) * y1;
+			y1 = -y1 + ((2 * (m + r) + 3) / (c * xi)) * y0;
 		}
 	}
 	R2 = R2_adder.calculate_sum();
 	R2p = R2p_adder.calculate_sum();
 }
+
+#define INSTANTIATE_COMMON_SPHEROIDAL(real) \
+	template real calculate_lambdamn_approx<real>(bool verbose, const real & c, const real & m, const real & n); \
+	template void calculate_lambdamn<real>(real & lambda, bool verbose, const real & c, const real & m, const real & n, const real & lambda_approx); \
+	template void calculate_lambdamn_all<real>(std::vector<real> & lambda, bool verbose, const real & c, const real & m, const real & n_max); \
+	template void calculate_drmn<real>(std::vector<real> & dr, bool verbose, const real & c, const real & m, const real & n, const real & lambda, real & n_dr, const real & dr_min); \
+	template void calculate_drmn_neg<real>(std::vector<real> & dr_neg, bool verbose, const real & c, const real & m, const real & n, const real & lambda, const real & n_dr, const std::vector<real> & dr, real & n_dr_neg, const real & dr_neg_min); \
+	template real calculate_Nmn<real>(bool verbose, const real & c, const real & m, const real & n, const real & lambda, real & n_dr, std::vector<real> & dr); \
+	template real calculate_Fmn<real>(bool verbose, const real & c, const real & m, const real & n, const real & lambda, real & n_dr, std::vector<real> & dr); \
+	template real calculate_kmn1<real>(bool verbose, const real & c, const real & m, const real & n, const real & n_dr, const std::vector<real> & dr, const real & F); \
+	template real calculate_kmn2<real>(bool verbose, const real & c, const real & m, const real & n, const real & lambda, const real & n_dr, const std::vector<real> & dr, real & n_dr_neg, std::vector<real> & dr_neg, const real & F); \
+	template void calculate_c2kmn<real>(std::vector<real> & c2k, bool verbose, const real & c, const real & m, const real & n, const real & lambda, real & n_dr, std::vector<real> & dr, real & n_c2k, const real & c2k_min); \
+	template void calculate_Smn1_1<real>(real & S1, real & S1p, bool verbose, const real & c, const real & m, const real & n, const real & n_dr, const std::vector<real> & dr, const real & eta); \
+	template void calculate_Smn1_2<real>(real & S1, real & S1p, bool verbose, const real & c, const real & m, const real & n, const real & n_c2k, const std::vector<real> & c2k, const real & eta); \
+	template void calculate_Rmn1_1_shared<real>(real & R1, real & R1p, bool verbose, const real & c, const real & m, const real & n, const real & n_dr, const std::vector<real> & dr, const real & xi); \
+	template void calculate_Rmn2_1_shared<real>(real & R2, real & R2p, bool verbose, const real & c, const real & m, const real & n, const real & n_dr, const std::vector<real> & dr, const real & xi);
+
+FOR_EACH_REAL_TYPE(INSTANTIATE_COMMON_SPHEROIDAL)
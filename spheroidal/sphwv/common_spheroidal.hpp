@@ -37,20 +37,36 @@
 // -c ^ 2 is used.  For that, there's a function called calculate_c_squared,
 // which is defined differently in pro_ and obl_spheroidal.cpp.
 //
+template <class real>
 real calculate_c_squared(const real & c);
 
-real calculate_continued_fraction(const real & b0, const std::vector<real> & a, const std::vector<real> & b);
+template <class real>
+real calculate_lambdamn_approx(bool verbose, const real & c, const real & m, const real & n);
+template <class real>
 void calculate_lambdamn(real & lambda, bool verbose, const real & c, const real & m, const real & n, const real & lambda_approx);
+template <class real>
+void calculate_lambdamn_all(std::vector<real> & lambda, bool verbose, const real & c, const real & m, const real & n_max);
+template <class real>
 void calculate_drmn(std::vector<real> & dr, bool verbose, const real & c, const real & m, const real & n, const real & lambda, real & n_dr, const real & dr_min);
+template <class real>
 void calculate_drmn_neg(std::vector<real> & dr_neg, bool verbose, const real & c, const real & m, const real & n, const real & lambda, const real & n_dr, const std::vector<real> & dr, real & n_dr_neg, const real & dr_neg_min);
+template <class real>
 real calculate_Nmn(bool verbose, const real & c, const real & m, const real & n, const real & lambda, real & n_dr, std::vector<real> & dr);
+template <class real>
 real calculate_Fmn(bool verbose, const real & c, const real & m, const real & n, const real & lambda, real & n_dr, std::vector<real> & dr);
+template <class real>
 real calculate_kmn1(bool verbose, const real & c, const real & m, const real & n, const real & n_dr, const std::vector<real> & dr, const real & F);
+template <class real>
 real calculate_kmn2(bool verbose, const real & c, const real & m, const real & n, const real & lambda, const real & n_dr, const std::vector<real> & dr, real & n_dr_neg, std::vector<real> & dr_neg, const real & F);
+template <class real>
 void calculate_c2kmn(std::vector<real> & c2k, bool verbose, const real & c, const real & m, const real & n, const real & lambda, real & n_dr, std::vector<real> & dr, real & n_c2k, const real & c2k_min);
+template <class real>
 void calculate_Smn1_1(real & S1, real & S1p, bool verbose, const real & c, const real & m, const real & n, const real & n_dr, const std::vector<real> & dr, const real & eta);
+template <class real>
 void calculate_Smn1_2(real & S1, real & S1p, bool verbose, const real & c, const real & m, const real & n, const real & n_c2k, const std::vector<real> & c2k, const real & eta);
+template <class real>
 void calculate_Rmn1_1_shared(real & R1, real & R1p, bool verbose, const real & c, const real & m, const real & n, const real & n_dr, const std::vector<real> & dr, const real & xi);
+template <class real>
 void calculate_Rmn2_1_shared(real & R2, real & R2p, bool verbose, const real & c, const real & m, const real & n, const real & n_dr, const std::vector<real> & dr, const real & xi);
 
 #endif
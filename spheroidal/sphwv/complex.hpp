@@ -0,0 +1,357 @@
+//
+// Copyright (c) 2014, Ross Adelman, Nail A. Gumerov, and Ramani Duraiswami
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#ifndef COMPLEX_HPP
+#define COMPLEX_HPP
+
+#include "real.hpp"
+#include <string>
+#include <type_traits>
+#include <utility>
+
+//
+// A complex number made of two reals of whichever kind real is.  The
+// operators and functions are friends defined in the class, so that they're
+// found through the complex itself, and reals and expressions still convert
+// to complexes where they're mixed with them.  A real (or an expression)
+// times or divided by a complex only takes two real operations, not a full
+// complex one, and multiplying by a power of I (see times_I) takes none.
+//
+// A product of two complexes is four real products below GAUSS_PRECISION
+// bits, and three (Gauss's trick, at the cost of three more additions) at or
+// above it, which is where a multiplication gets expensive enough compared to
+// an addition for that to pay off.
+//
+template <class real>
+class complex
+{
+public:
+	static const int GAUSS_PRECISION = 2000;
+	
+	static complex I;
+	
+	static void begin();
+	
+	real a;
+	real b;
+	
+	complex() : a(), b()
+	{
+	}
+	
+	complex(const complex & aa) : a(aa.a), b(aa.b)
+	{
+	}
+	
+	complex(complex && aa) : a(std::move(aa.a)), b(std::move(aa.b))
+	{
+	}
+	
+	complex(const real & aa) : a(aa), b()
+	{
+	}
+	
+	template <class E, class = typename std::enable_if<std::is_same<typename E::value_type, real>::value>::type>
+	complex(const real_expr<E> & aa) : a(aa.self()), b()
+	{
+	}
+	
+	complex(const real & aa, const real & bb) : a(aa), b(bb)
+	{
+	}
+	
+	complex & operator =(const real & aa)
+	{
+		a = aa;
+		b = real::ZERO;
+		return *this;
+	}
+	
+	template <class E>
+	complex & operator =(const real_expr<E> & aa)
+	{
+		a = aa;
+		b = real::ZERO;
+		return *this;
+	}
+	
+	complex & operator =(const complex & aa)
+	{
+		a = aa.a;
+		b = aa.b;
+		return *this;
+	}
+	
+	complex & operator =(complex && aa)
+	{
+		a = std::move(aa.a);
+		b = std::move(aa.b);
+		return *this;
+	}
+	
+	complex & operator +=(const complex & aa)
+	{
+		a += aa.a;
+		b += aa.b;
+		return *this;
+	}
+	
+	complex & operator -=(const complex & aa)
+	{
+		a -= aa.a;
+		b -= aa.b;
+		return *this;
+	}
+	
+	complex & operator *=(const complex & aa)
+	{
+		*this = *this * aa;
+		return *this;
+	}
+	
+	complex & operator /=(const complex & aa)
+	{
+		*this = *this / aa;
+		return *this;
+	}
+	
+	//
+	// Adds aa * bb in place, with each of the real products fused into the
+	// sum, so nothing is rounded twice and there are no temporaries.  Neither
+	// aa nor bb can be this complex.
+	//
+	complex & add_product(const complex & aa, const complex & bb)
+	{
+		a += aa.a * bb.a;
+		a -= aa.b * bb.b;
+		b += aa.a * bb.b;
+		b += aa.b * bb.a;
+		return *this;
+	}
+	
+	complex & add_product(const real & aa, const complex & bb)
+	{
+		a += aa * bb.a;
+		b += aa * bb.b;
+		return *this;
+	}
+	
+	template <class E, class = typename std::enable_if<std::is_same<typename E::value_type, real>::value>::type>
+	complex & add_product(const real_expr<E> & aa, const complex & bb)
+	{
+		return add_product(real(aa.self()), bb);
+	}
+	
+	complex times_I() const
+	{
+		return complex(-b, a);
+	}
+	
+	//
+	// Returns this complex times I^n, where n is an integer, which only
+	// swaps and negates the parts.
+	//
+	complex times_I(const real & n) const
+	{
+		switch (((n.get_int() % 4) + 4) % 4)
+		{
+		case 1:
+			return complex(-b, a);
+		case 2:
+			return complex(-a, -b);
+		case 3:
+			return complex(b, -a);
+		default:
+			return *this;
+		}
+	}
+	
+	std::string get_string(int p) const
+	{
+		return a.get_string(p) + " + i * " + b.get_string(p);
+	}
+	
+	friend complex operator +(const complex & a, const complex & b)
+	{
+		complex x;
+		
+		x.a = a.a + b.a;
+		x.b = a.b + b.b;
+		return x;
+	}
+	
+	friend complex operator -(const complex & a, const complex & b)
+	{
+		complex x;
+		
+		x.a = a.a - b.a;
+		x.b = a.b - b.b;
+		return x;
+	}
+	
+	friend complex operator *(const complex & a, const complex & b)
+	{
+		real t;
+		real u;
+		complex x;
+		
+		if (a.a.get_precision() < GAUSS_PRECISION)
+		{
+			x.a = a.a * b.a;
+			t = a.b * b.b;
+			x.a -= t;
+			x.b = a.a * b.b;
+			t = a.b * b.a;
+			x.b += t;
+		}
+		else
+		{
+			t = b.a * (a.a + a.b);
+			u = a.a * (b.b - b.a);
+			x.a = a.b * (b.a + b.b);
+			x.a = t - x.a;
+			x.b = t + u;
+		}
+		return x;
+	}
+	
+	friend complex operator *(const real & a, const complex & b)
+	{
+		complex x;
+		
+		x.a = a * b.a;
+		x.b = a * b.b;
+		return x;
+	}
+	
+	friend complex operator *(const complex & a, const real & b)
+	{
+		return b * a;
+	}
+	
+	template <class E, class = typename std::enable_if<std::is_same<typename E::value_type, real>::value>::type>
+	friend complex operator *(const real_expr<E> & a, const complex & b)
+	{
+		return real(a.self()) * b;
+	}
+	
+	template <class E, class = typename std::enable_if<std::is_same<typename E::value_type, real>::value>::type>
+	friend complex operator *(const complex & a, const real_expr<E> & b)
+	{
+		return real(b.self()) * a;
+	}
+	
+	friend complex operator /(const complex & a, const complex & b)
+	{
+		real r;
+		complex x;
+		
+		r = b.a * b.a + b.b * b.b;
+		x.a = (a.a * b.a + a.b * b.b) / r;
+		x.b = (a.b * b.a - a.a * b.b) / r;
+		return x;
+	}
+	
+	friend complex operator /(const complex & a, const real & b)
+	{
+		complex x;
+		
+		x.a = a.a / b;
+		x.b = a.b / b;
+		return x;
+	}
+	
+	template <class E, class = typename std::enable_if<std::is_same<typename E::value_type, real>::value>::type>
+	friend complex operator /(const complex & a, const real_expr<E> & b)
+	{
+		return a / real(b.self());
+	}
+	
+	friend complex operator -(const complex & a)
+	{
+		complex x;
+		
+		x.a = -a.a;
+		x.b = -a.b;
+		return x;
+	}
+	
+	friend real abs(const complex & a)
+	{
+		return sqrt(a.a * a.a + a.b * a.b);
+	}
+	
+	friend bool is_negligible(const complex & change, const complex & x)
+	{
+		return abs(change) > real::ZERO && abs(change / x) < real::SMALL_ENOUGH;
+	}
+	
+	//
+	// Returns the value on the principal branch.  log(abs(a)) is half the log
+	// of abs(a)^2, so there's no square root.
+	//
+	friend complex log(const complex & a)
+	{
+		complex x;
+		
+		x.a = log(a.a * a.a + a.b * a.b) / real::TWO;
+		x.b = atan2(a.b, a.a);
+		return x;
+	}
+	
+	//
+	// Returns the value on the principal branch.  Like log, abs(a)^b is
+	// (abs(a)^2)^(b / 2), and the angle is only worked out once.
+	//
+	friend complex pow(const complex & a, const real & b)
+	{
+		real r;
+		real angle;
+		complex x;
+		
+		r = pow(a.a * a.a + a.b * a.b, b / real::TWO);
+		angle = b * atan2(a.b, a.a);
+		x.a = r * cos(angle);
+		x.b = r * sin(angle);
+		return x;
+	}
+};
+
+template <class real>
+complex<real> complex<real>::I;
+
+//
+// For the usual reals, I is made before there's any context (see
+// real_context in real.hpp), so it's empty until it's assigned here.
+//
+template <class real>
+void complex<real>::begin()
+{
+	I = complex(real::ZERO, real::ONE);
+}
+
+#endif
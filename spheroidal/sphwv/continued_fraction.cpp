@@ -0,0 +1,177 @@
+//
+// Copyright (c) 2014, Ross Adelman, Nail A. Gumerov, and Ramani Duraiswami
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include "continued_fraction.hpp"
+#include "real.hpp"
+#include "real_types.hpp"
+
+template <class real>
+continued_fraction<real>::continued_fraction()
+{
+	clear(real::ZERO);
+}
+
+template <class real>
+void continued_fraction<real>::clear(const real & b0)
+{
+	value = b0;
+	change = real::NAN;
+	n_terms = 0;
+}
+
+template <class real>
+void continued_fraction<real>::add(const real & a, const real & b)
+{
+	real prev_value;
+	
+	if (n_terms == 0)
+	{
+		D = b;
+		delta = -a;
+	}
+	else
+	{
+		delta *= a;
+		delta *= D;
+		D = b - a * D;
+	}
+	if (D == real::ZERO)
+	{
+		D = get_tiny();
+	}
+	D = real::ONE / D;
+	delta *= D;
+	++n_terms;
+	prev_value = value;
+	value += delta;
+	change = (value - prev_value) / prev_value;
+}
+
+template <class real>
+int continued_fraction<real>::get_n_terms() const
+{
+	return n_terms;
+}
+
+template <class real>
+const real & continued_fraction<real>::get_value() const
+{
+	return value;
+}
+
+template <class real>
+real continued_fraction<real>::get_change() const
+{
+	return change;
+}
+
+template <class real>
+bool continued_fraction<real>::has_converged() const
+{
+	return n_terms > 1 && abs(change) < real::SMALL_ENOUGH;
+}
+
+//
+// Anything much smaller than the precision will do.
+//
+template <class real>
+real continued_fraction<real>::get_tiny()
+{
+	return real::SMALL_ENOUGH * real::SMALL_ENOUGH * real::SMALL_ENOUGH;
+}
+
+template <class real>
+complex_continued_fraction<real>::complex_continued_fraction()
+{
+	clear(real::ZERO);
+}
+
+template <class real>
+void complex_continued_fraction<real>::clear(const complex<real> & b0)
+{
+	value = b0;
+	change = real::NAN;
+	n_terms = 0;
+}
+
+template <class real>
+void complex_continued_fraction<real>::add(const complex<real> & a, const complex<real> & b)
+{
+	complex<real> prev_value;
+	
+	if (n_terms == 0)
+	{
+		D = b;
+		delta = -a;
+	}
+	else
+	{
+		delta *= a;
+		delta *= D;
+		D = b - a * D;
+	}
+	if (D.a == real::ZERO && D.b == real::ZERO)
+	{
+		D = continued_fraction<real>::get_tiny();
+	}
+	D = real::ONE / D;
+	delta *= D;
+	++n_terms;
+	prev_value = value;
+	value += delta;
+	change = (value - prev_value) / prev_value;
+}
+
+template <class real>
+int complex_continued_fraction<real>::get_n_terms() const
+{
+	return n_terms;
+}
+
+template <class real>
+const complex<real> & complex_continued_fraction<real>::get_value() const
+{
+	return value;
+}
+
+template <class real>
+complex<real> complex_continued_fraction<real>::get_change() const
+{
+	return change;
+}
+
+template <class real>
+bool complex_continued_fraction<real>::has_converged() const
+{
+	return n_terms > 1 && abs(change) < real::SMALL_ENOUGH;
+}
+
+#define INSTANTIATE_CONTINUED_FRACTION(real) \
+	template class continued_fraction<real>; \
+	template class complex_continued_fraction<real>;
+
+FOR_EACH_REAL_TYPE(INSTANTIATE_CONTINUED_FRACTION)
@@ -0,0 +1,100 @@
+//
+// Copyright (c) 2014, Ross Adelman, Nail A. Gumerov, and Ramani Duraiswami
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#ifndef CONTINUED_FRACTION_HPP
+#define CONTINUED_FRACTION_HPP
+
+#include "complex.hpp"
+
+//
+// continued_fraction works out b0 - a1 / (b1 - a2 / (b2 - ...)) forward,
+// one term (a pair of a and b) at a time, with Steed's method.  Working it
+// out from the bottom would mean going through every term again whenever one
+// is added, but here adding a term is a constant amount of work.
+//
+// Each term adds delta to the value, where delta is the difference between
+// the last two approximations (the convergents), and D is the ratio of their
+// denominators.  Since the value is a sum, it stops changing at all once the
+// deltas are too small to make a difference, just like a fraction that's
+// worked out from the bottom.  (The modified Lentz method keeps the value as
+// a product instead, which keeps changing in the last bit or so, so it never
+// passes a convergence test as tight as SMALL_ENOUGH.)  If the denominator
+// of D is ever zero, it's replaced by a tiny number, the way the Lentz
+// method does, instead of dividing by zero.  get_tiny is that number, and
+// it's public so that other fractions can use the same one.
+//
+// clear starts over with no terms and the given b0.
+//
+// change is the relative change in the value from the last term, and the
+// fraction has converged once there have been at least two terms, and the
+// change is smaller than SMALL_ENOUGH.
+//
+// complex_continued_fraction is the same, but for complex numbers.
+//
+template <class real>
+class continued_fraction
+{
+public:
+	continued_fraction();
+	void clear(const real & b0);
+	void add(const real & a, const real & b);
+	int get_n_terms() const;
+	const real & get_value() const;
+	real get_change() const;
+	bool has_converged() const;
+	
+	static real get_tiny();
+	
+private:
+	real D;
+	real delta;
+	real value;
+	real change;
+	int n_terms;
+};
+
+template <class real>
+class complex_continued_fraction
+{
+public:
+	complex_continued_fraction();
+	void clear(const complex<real> & b0);
+	void add(const complex<real> & a, const complex<real> & b);
+	int get_n_terms() const;
+	const complex<real> & get_value() const;
+	complex<real> get_change() const;
+	bool has_converged() const;
+	
+private:
+	complex<real> D;
+	complex<real> delta;
+	complex<real> value;
+	complex<real> change;
+	int n_terms;
+};
+
+#endif
@@ -0,0 +1,190 @@
+//
+// Copyright (c) 2014, Ross Adelman, Nail A. Gumerov, and Ramani Duraiswami
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#ifndef DOUBLE_DOUBLE_HPP
+#define DOUBLE_DOUBLE_HPP
+
+#include <quadmath.h>
+
+//
+// A number stored as the unevaluated sum of two doubles, hi + lo, with
+// |lo| <= ulp(hi) / 2, which gives about 106 bits of precision with
+// nothing but hardware arithmetic.  The arithmetic uses the usual error-free
+// transformations (two_sum and two_prod, the latter with an fma).  The
+// functions that aren't simple arithmetic, like log and pow, go through
+// __float128 instead, which has a few more bits than a double_double.
+//
+class double_double
+{
+public:
+	double hi;
+	double lo;
+	
+	double_double() : hi(0.0), lo(0.0)
+	{
+	}
+	
+	double_double(double a) : hi(a), lo(0.0)
+	{
+	}
+	
+	double_double(double hhi, double llo) : hi(hhi), lo(llo)
+	{
+	}
+	
+	explicit double_double(__float128 a)
+	{
+		hi = (double)a;
+		lo = __builtin_isfinite(hi) ? (double)(a - hi) : 0.0;
+	}
+	
+	explicit operator __float128() const
+	{
+		return (__float128)hi + lo;
+	}
+	
+	static void two_sum(double a, double b, double & s, double & e)
+	{
+		double bb;
+		
+		s = a + b;
+		bb = s - a;
+		e = (a - (s - bb)) + (b - bb);
+	}
+	
+	static void quick_two_sum(double a, double b, double & s, double & e)
+	{
+		s = a + b;
+		e = b - (s - a);
+	}
+	
+	static void two_prod(double a, double b, double & p, double & e)
+	{
+		p = a * b;
+		e = __builtin_fma(a, b, -p);
+	}
+};
+
+inline double_double operator +(const double_double & a, const double_double & b)
+{
+	double s;
+	double e;
+	double t;
+	double f;
+	
+	double_double::two_sum(a.hi, b.hi, s, e);
+	if (!__builtin_isfinite(s))
+	{
+		return double_double(s, 0.0);
+	}
+	double_double::two_sum(a.lo, b.lo, t, f);
+	e = e + t;
+	double_double::quick_two_sum(s, e, s, e);
+	e = e + f;
+	double_double::quick_two_sum(s, e, s, e);
+	return double_double(s, e);
+}
+
+inline double_double operator -(const double_double & a)
+{
+	return double_double(-a.hi, -a.lo);
+}
+
+inline double_double operator -(const double_double & a, const double_double & b)
+{
+	return a + (-b);
+}
+
+inline double_double operator *(const double_double & a, const double_double & b)
+{
+	double p;
+	double e;
+	
+	double_double::two_prod(a.hi, b.hi, p, e);
+	if (!__builtin_isfinite(p))
+	{
+		return double_double(p, 0.0);
+	}
+	e = e + (a.hi * b.lo + a.lo * b.hi);
+	double_double::quick_two_sum(p, e, p, e);
+	return double_double(p, e);
+}
+
+//
+// Long division, with a third partial quotient for the last few bits.
+//
+inline double_double operator /(const double_double & a, const double_double & b)
+{
+	double q1;
+	double q2;
+	double q3;
+	double_double r;
+	
+	q1 = a.hi / b.hi;
+	if (!__builtin_isfinite(q1) || b.hi == 0.0)
+	{
+		return double_double(q1, 0.0);
+	}
+	r = a - double_double(q1) * b;
+	q2 = r.hi / b.hi;
+	r = r - double_double(q2) * b;
+	q3 = r.hi / b.hi;
+	double_double::quick_two_sum(q1, q2, q1, q2);
+	return double_double(q1, q2) + double_double(q3);
+}
+
+inline bool operator >(const double_double & a, const double_double & b)
+{
+	return a.hi > b.hi || (a.hi == b.hi && a.lo > b.lo);
+}
+
+inline bool operator >=(const double_double & a, const double_double & b)
+{
+	return a.hi > b.hi || (a.hi == b.hi && a.lo >= b.lo);
+}
+
+inline bool operator <(const double_double & a, const double_double & b)
+{
+	return a.hi < b.hi || (a.hi == b.hi && a.lo < b.lo);
+}
+
+inline bool operator <=(const double_double & a, const double_double & b)
+{
+	return a.hi < b.hi || (a.hi == b.hi && a.lo <= b.lo);
+}
+
+inline bool operator ==(const double_double & a, const double_double & b)
+{
+	return a.hi == b.hi && a.lo == b.lo;
+}
+
+inline bool operator !=(const double_double & a, const double_double & b)
+{
+	return !(a == b);
+}
+
+#endif
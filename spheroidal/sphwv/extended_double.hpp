@@ -0,0 +1,191 @@
+//
+// Copyright (c) 2014, Ross Adelman, Nail A. Gumerov, and Ramani Duraiswami
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#ifndef EXTENDED_DOUBLE_HPP
+#define EXTENDED_DOUBLE_HPP
+
+//
+// A double with its own (64-bit) exponent: m * 2^e, where the mantissa m is
+// a double in [0.5, 1) (or 0, an inf, or a nan, in which case e is 0).  It
+// has a double's precision but practically no limit on its range, so the
+// coefficients that overflow or underflow a double for large m and n, like
+// dr, c2k, k1, and k2, fit in one without needing MPFR.  It's plain old
+// data, two words and no pointers, so arrays of them are contiguous and
+// the operations are short, branch-light sequences of double arithmetic.
+//
+class extended_double
+{
+public:
+	double m;
+	long e;
+	
+	extended_double() : m(0.0), e(0)
+	{
+	}
+	
+	extended_double(double a) : m(a), e(0)
+	{
+		normalize();
+	}
+	
+	extended_double(double mm, long ee) : m(mm), e(ee)
+	{
+		normalize();
+	}
+	
+	//
+	// The closest double, which is 0 or an inf if it's out of a double's
+	// range.
+	//
+	double get_double() const
+	{
+		if (e > 2000)
+		{
+			return m * __builtin_inf();
+		}
+		else if (e < -2000)
+		{
+			return m * 0.0;
+		}
+		return __builtin_ldexp(m, (int)e);
+	}
+	
+	bool finite() const
+	{
+		return __builtin_isfinite(m);
+	}
+	
+	//
+	// Compares a and b as if they were doubles.  Only when they're both
+	// finite, nonzero, and of the same sign do the exponents matter.
+	//
+	static bool less(const extended_double & a, const extended_double & b)
+	{
+		if (a.e == b.e || a.m == 0.0 || b.m == 0.0 || !a.finite() || !b.finite() || (a.m < 0.0) != (b.m < 0.0))
+		{
+			return a.m < b.m;
+		}
+		return a.m < 0.0 ? a.e > b.e : a.e < b.e;
+	}
+	
+private:
+	void normalize()
+	{
+		int i;
+		
+		if (m == 0.0 || !__builtin_isfinite(m))
+		{
+			e = 0;
+			return;
+		}
+		m = __builtin_frexp(m, &i);
+		e = e + i;
+	}
+};
+
+inline extended_double operator +(const extended_double & a, const extended_double & b)
+{
+	long d;
+	
+	if (!a.finite() || !b.finite())
+	{
+		return extended_double(a.m + b.m);
+	}
+	else if (b.m == 0.0)
+	{
+		return a;
+	}
+	else if (a.m == 0.0)
+	{
+		return b;
+	}
+	d = b.e - a.e;
+	if (d <= 0)
+	{
+		return d < -64 ? a : extended_double(a.m + __builtin_ldexp(b.m, (int)d), a.e);
+	}
+	else
+	{
+		return d > 64 ? b : extended_double(__builtin_ldexp(a.m, (int)-d) + b.m, b.e);
+	}
+}
+
+inline extended_double operator -(const extended_double & a)
+{
+	extended_double x;
+	
+	x.m = -a.m;
+	x.e = a.e;
+	return x;
+}
+
+inline extended_double operator -(const extended_double & a, const extended_double & b)
+{
+	return a + (-b);
+}
+
+inline extended_double operator *(const extended_double & a, const extended_double & b)
+{
+	return extended_double(a.m * b.m, a.e + b.e);
+}
+
+inline extended_double operator /(const extended_double & a, const extended_double & b)
+{
+	return extended_double(a.m / b.m, a.e - b.e);
+}
+
+inline bool operator >(const extended_double & a, const extended_double & b)
+{
+	return extended_double::less(b, a);
+}
+
+inline bool operator >=(const extended_double & a, const extended_double & b)
+{
+	return extended_double::less(b, a) || (a.m == b.m && a.e == b.e);
+}
+
+inline bool operator <(const extended_double & a, const extended_double & b)
+{
+	return extended_double::less(a, b);
+}
+
+inline bool operator <=(const extended_double & a, const extended_double & b)
+{
+	return extended_double::less(a, b) || (a.m == b.m && a.e == b.e);
+}
+
+inline bool operator ==(const extended_double & a, const extended_double & b)
+{
+	return a.m == b.m && a.e == b.e;
+}
+
+inline bool operator !=(const extended_double & a, const extended_double & b)
+{
+	return !(a == b);
+}
+
+#endif
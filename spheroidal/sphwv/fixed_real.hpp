@@ -0,0 +1,543 @@
+//
+// Copyright (c) 2014, Ross Adelman, Nail A. Gumerov, and Ramani Duraiswami
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#ifndef FIXED_REAL_HPP
+#define FIXED_REAL_HPP
+
+#include <gmp.h>
+#include <mpfr.h>
+#include "real.hpp"
+#include <string>
+#include <type_traits>
+
+//
+// A real whose precision, bits, is fixed at compile time.  Its limbs are
+// stored inline, right next to its mpfr_t (using MPFR's custom interface),
+// instead of being allocated on the heap, so creating, copying, and
+// destroying one never touches the allocator, and a vector of them is a
+// single contiguous block.  It still counts against the context's max_reals,
+// by its size (see real_context in real.hpp).  Otherwise, it works the same
+// as a real, and the same expressions can be built out of it, so the code
+// that calculates the coefficients and the functions can be instantiated for
+// it directly.  Since real is already the name of the usual kind of real,
+// this one is called fixed_real.
+//
+template <int bits>
+class fixed_scratch;
+
+template <int bits>
+class fixed_real : public real_expr<fixed_real<bits> >
+{
+public:
+	typedef fixed_real value_type;
+	typedef fixed_scratch<bits> scratch;
+	
+	static const int n_limbs = (bits + GMP_NUMB_BITS - 1) / GMP_NUMB_BITS;
+	
+	static fixed_real NAN;
+	static fixed_real INF;
+	static fixed_real ZERO;
+	static fixed_real ONE;
+	static fixed_real TWO;
+	static fixed_real THREE;
+	static fixed_real FOUR;
+	static fixed_real FIVE;
+	static fixed_real PI;
+	static fixed_real EPS;
+	static fixed_real SMALL_ENOUGH;
+	
+	static void begin();
+	
+	mpfr_t r;
+	
+	fixed_real()
+	{
+		init();
+	}
+	
+	fixed_real(const fixed_real & a)
+	{
+		init();
+		mpfr_set(r, a.r, MPFR_RNDN);
+	}
+	
+	~fixed_real()
+	{
+		real_context::remove_bytes(sizeof(fixed_real));
+	}
+	
+	fixed_real(int a)
+	{
+		init();
+		mpfr_set_si(r, a, MPFR_RNDZ);
+	}
+	
+	fixed_real(double a)
+	{
+		init();
+		mpfr_set_d(r, a, MPFR_RNDN);
+	}
+	
+	fixed_real(const std::string & a)
+	{
+		init();
+		mpfr_set_str(r, a.c_str(), 10, MPFR_RNDN);
+	}
+	
+	template <class E, class = typename std::enable_if<std::is_same<typename E::value_type, fixed_real>::value>::type>
+	fixed_real(const real_expr<E> & a)
+	{
+		init();
+		a.self().eval(r);
+	}
+	
+	fixed_real & operator =(const fixed_real & a)
+	{
+		mpfr_set(r, a.r, MPFR_RNDN);
+		return *this;
+	}
+	
+	fixed_real & operator =(int a)
+	{
+		mpfr_set_si(r, a, MPFR_RNDN);
+		return *this;
+	}
+	
+	fixed_real & operator =(double a)
+	{
+		mpfr_set_d(r, a, MPFR_RNDN);
+		return *this;
+	}
+	
+	fixed_real & operator =(const std::string & a)
+	{
+		mpfr_set_str(r, a.c_str(), 10, MPFR_RNDN);
+		return *this;
+	}
+	
+	//
+	// The limbs can't be swapped in like they are for a real, since they
+	// belong to the temporary, so it's copied instead.
+	//
+	template <class E>
+	fixed_real & operator =(const real_expr<E> & a)
+	{
+		if (a.self().safe(r))
+		{
+			a.self().eval(r);
+		}
+		else
+		{
+			fixed_real x(a);
+			
+			mpfr_set(r, x.r, MPFR_RNDN);
+		}
+		return *this;
+	}
+	
+	template <class E>
+	fixed_real & operator +=(const real_expr<E> & a)
+	{
+		return *this = *this + a.self();
+	}
+	
+	template <class E>
+	fixed_real & operator -=(const real_expr<E> & a)
+	{
+		return *this = *this - a.self();
+	}
+	
+	template <class E>
+	fixed_real & operator *=(const real_expr<E> & a)
+	{
+		return *this = *this * a.self();
+	}
+	
+	template <class E>
+	fixed_real & operator /=(const real_expr<E> & a)
+	{
+		return *this = *this / a.self();
+	}
+	
+	template <class T>
+	typename std::enable_if<std::is_integral<T>::value, fixed_real &>::type operator +=(T a)
+	{
+		return *this = *this + a;
+	}
+	
+	template <class T>
+	typename std::enable_if<std::is_integral<T>::value, fixed_real &>::type operator -=(T a)
+	{
+		return *this = *this - a;
+	}
+	
+	template <class T>
+	typename std::enable_if<std::is_integral<T>::value, fixed_real &>::type operator *=(T a)
+	{
+		return *this = *this * a;
+	}
+	
+	template <class T>
+	typename std::enable_if<std::is_integral<T>::value, fixed_real &>::type operator /=(T a)
+	{
+		return *this = *this / a;
+	}
+	
+	int get_precision() const
+	{
+		return bits;
+	}
+	
+	int get_int() const
+	{
+		return mpfr_get_si(r, MPFR_RNDZ);
+	}
+	
+	double get_double() const
+	{
+		return mpfr_get_d(r, MPFR_RNDN);
+	}
+	
+	std::string get_string(int p) const
+	{
+		return get_mpfr_string(r, p);
+	}
+	
+	// A fixed_real is the leaf of an expression.
+	static const bool leaf = true;
+	
+	mpfr_srcptr src() const
+	{
+		return r;
+	}
+	
+	bool aliases(mpfr_srcptr x) const
+	{
+		return x == r;
+	}
+	
+	bool safe(mpfr_srcptr x) const
+	{
+		return true;
+	}
+	
+	void eval(mpfr_ptr x) const
+	{
+		mpfr_set(x, r, MPFR_RNDN);
+	}
+	
+	friend bool operator >(const fixed_real & a, const fixed_real & b)
+	{
+		return mpfr_greater_p(a.r, b.r) != 0;
+	}
+	
+	friend bool operator >=(const fixed_real & a, const fixed_real & b)
+	{
+		return mpfr_greaterequal_p(a.r, b.r) != 0;
+	}
+	
+	friend bool operator <(const fixed_real & a, const fixed_real & b)
+	{
+		return mpfr_less_p(a.r, b.r) != 0;
+	}
+	
+	friend bool operator <=(const fixed_real & a, const fixed_real & b)
+	{
+		return mpfr_lessequal_p(a.r, b.r) != 0;
+	}
+	
+	friend bool operator ==(const fixed_real & a, const fixed_real & b)
+	{
+		return mpfr_equal_p(a.r, b.r) != 0;
+	}
+	
+	friend bool operator !=(const fixed_real & a, const fixed_real & b)
+	{
+		return mpfr_equal_p(a.r, b.r) == 0;
+	}
+	
+	friend fixed_real abs(const fixed_real & a)
+	{
+		fixed_real x;
+		
+		mpfr_abs(x.r, a.r, MPFR_RNDN);
+		return x;
+	}
+	
+	//
+	// See is_negligible in real.cpp.
+	//
+	friend bool is_negligible(const fixed_real & change, const fixed_real & x)
+	{
+		mpfr_exp_t d;
+		mpfr_exp_t s;
+		
+		if (mpfr_regular_p(change.r) && mpfr_regular_p(x.r))
+		{
+			d = mpfr_get_exp(change.r) - mpfr_get_exp(x.r);
+			s = mpfr_get_exp(SMALL_ENOUGH.r);
+			if (d + 2 < s)
+			{
+				return true;
+			}
+			if (d > s + 1)
+			{
+				return false;
+			}
+		}
+		return abs(change) > ZERO && abs(change / x) < SMALL_ENOUGH;
+	}
+	
+	friend long mul_for_sum(fixed_real & x, const fixed_real & a, const fixed_real & b, const fixed_real & sum, long guard_bits)
+	{
+		return set_mpfr_mul_for_sum(x.r, a.r, b.r, sum.r, guard_bits);
+	}
+	
+	friend void set_z_2exp(fixed_real & x, mpz_srcptr a, long e)
+	{
+		mpfr_set_z(x.r, a, MPFR_RNDN);
+		mpfr_mul_2si(x.r, x.r, e, MPFR_RNDN);
+	}
+	
+	friend fixed_real atan(const fixed_real & a)
+	{
+		fixed_real x;
+		
+		mpfr_atan(x.r, a.r, MPFR_RNDN);
+		return x;
+	}
+	
+	friend fixed_real atan2(const fixed_real & b, const fixed_real & a)
+	{
+		fixed_real x;
+		
+		mpfr_atan2(x.r, b.r, a.r, MPFR_RNDN);
+		return x;
+	}
+	
+	friend fixed_real cos(const fixed_real & a)
+	{
+		fixed_real x;
+		
+		mpfr_cos(x.r, a.r, MPFR_RNDN);
+		return x;
+	}
+	
+	friend fixed_real factorial(const fixed_real & a)
+	{
+		fixed_real x;
+		
+		mpfr_fac_ui(x.r, mpfr_get_ui(a.r, MPFR_RNDZ), MPFR_RNDN);
+		return x;
+	}
+	
+	friend fixed_real log(const fixed_real & a)
+	{
+		fixed_real x;
+		
+		mpfr_log(x.r, a.r, MPFR_RNDN);
+		return x;
+	}
+	
+	friend fixed_real max(const fixed_real & a, const fixed_real & b)
+	{
+		fixed_real x;
+		
+		mpfr_max(x.r, a.r, b.r, MPFR_RNDN);
+		return x;
+	}
+	
+	friend fixed_real pochhammer(const fixed_real & a, const fixed_real & k)
+	{
+		fixed_real x;
+		
+		x = ONE;
+		for (fixed_real i = ZERO; i <= k - ONE; i = i + ONE)
+		{
+			x = x * (a + i);
+		}
+		return x;
+	}
+	
+	friend fixed_real pow(const fixed_real & a, const fixed_real & b)
+	{
+		fixed_real x;
+		
+		set_mpfr_pow(x.r, a.r, b.r);
+		return x;
+	}
+	
+	friend fixed_real pow_si(const fixed_real & a, long n)
+	{
+		fixed_real x;
+		
+		mpfr_pow_si(x.r, a.r, n, MPFR_RNDN);
+		return x;
+	}
+	
+	friend fixed_real rec_sqrt(const fixed_real & a)
+	{
+		fixed_real x;
+		
+		mpfr_rec_sqrt(x.r, a.r, MPFR_RNDN);
+		return x;
+	}
+	
+	friend fixed_real reciprocal(const fixed_real & a)
+	{
+		fixed_real x;
+		
+		mpfr_ui_div(x.r, 1, a.r, MPFR_RNDN);
+		return x;
+	}
+	
+	friend fixed_real remainder(const fixed_real & a, const fixed_real & b)
+	{
+		fixed_real x;
+		
+		mpfr_remainder(x.r, a.r, b.r, MPFR_RNDN);
+		return x;
+	}
+	
+	friend fixed_real round(const fixed_real & a)
+	{
+		fixed_real x;
+		
+		mpfr_rint(x.r, a.r, MPFR_RNDN);
+		return x;
+	}
+	
+	friend fixed_real sign_pow(const fixed_real & n)
+	{
+		fixed_real x;
+		
+		mpfr_set_si(x.r, mpfr_get_si(n.r, MPFR_RNDZ) % 2 == 0 ? 1 : -1, MPFR_RNDN);
+		return x;
+	}
+	
+	friend fixed_real sin(const fixed_real & a)
+	{
+		fixed_real x;
+		
+		mpfr_sin(x.r, a.r, MPFR_RNDN);
+		return x;
+	}
+	
+	friend fixed_real sqrt(const fixed_real & a)
+	{
+		fixed_real x;
+		
+		mpfr_sqrt(x.r, a.r, MPFR_RNDN);
+		return x;
+	}
+	
+	friend int gzbi(const fixed_real & i)
+	{
+		return i.get_int();
+	}
+	
+	friend int gnobi(const fixed_real & i)
+	{
+		return -i.get_int() - 1;
+	}
+	
+private:
+	mp_limb_t limbs[n_limbs];
+	
+	void init()
+	{
+		mpfr_custom_init(limbs, bits);
+		mpfr_custom_init_set(r, MPFR_ZERO_KIND, 0, bits, limbs);
+		real_context::add_bytes(sizeof(fixed_real));
+	}
+};
+
+//
+// The scratch register of an expression whose value is a fixed_real is just
+// another fixed_real, which is free to set up.
+//
+template <int bits>
+class fixed_scratch
+{
+public:
+	mpfr_ptr get(mpfr_srcptr x)
+	{
+		return t.r;
+	}
+	
+private:
+	fixed_real<bits> t;
+};
+
+template <int bits>
+fixed_real<bits> fixed_real<bits>::NAN;
+template <int bits>
+fixed_real<bits> fixed_real<bits>::INF;
+template <int bits>
+fixed_real<bits> fixed_real<bits>::ZERO;
+template <int bits>
+fixed_real<bits> fixed_real<bits>::ONE;
+template <int bits>
+fixed_real<bits> fixed_real<bits>::TWO;
+template <int bits>
+fixed_real<bits> fixed_real<bits>::THREE;
+template <int bits>
+fixed_real<bits> fixed_real<bits>::FOUR;
+template <int bits>
+fixed_real<bits> fixed_real<bits>::FIVE;
+template <int bits>
+fixed_real<bits> fixed_real<bits>::PI;
+template <int bits>
+fixed_real<bits> fixed_real<bits>::EPS;
+template <int bits>
+fixed_real<bits> fixed_real<bits>::SMALL_ENOUGH;
+
+//
+// Works out the constants at this precision, the same way a real_context
+// does.
+//
+template <int bits>
+void fixed_real<bits>::begin()
+{
+	mpfr_set_nan(NAN.r);
+	mpfr_set_inf(INF.r, 0);
+	mpfr_set_zero(ZERO.r, 1);
+	ONE = 1;
+	TWO = 2;
+	THREE = 3;
+	FOUR = 4;
+	FIVE = 5;
+	mpfr_const_pi(PI.r, MPFR_RNDN);
+	EPS = ONE;
+	while (ONE + EPS != ONE)
+	{
+		EPS = EPS / TWO;
+	}
+	SMALL_ENOUGH = EPS;
+}
+
+#endif
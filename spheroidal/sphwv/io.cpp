@@ -28,9 +28,11 @@
 #include <fstream>
 #include "io.hpp"
 #include "real.hpp"
+#include "real_types.hpp"
 #include <string>
 #include <vector>
 
+template <class real>
 bool save_data(const std::string & name, const std::vector<real> & data)
 {
 	std::ofstream out;
@@ -48,6 +50,7 @@ bool save_data(const std::string & name, const std::vector<real> & data)
 	return true;
 }
 
+template <class real>
 bool save_data(const std::string & name, const real & data)
 {
 	std::vector<real> container;
@@ -57,6 +60,7 @@ bool save_data(const std::string & name, const real & data)
 	return save_data(name, container);
 }
 
+template <class real>
 bool save_log_abs_data(const std::string & name, const std::vector<real> & data)
 {
 	std::vector<real> log_abs_data;
@@ -72,11 +76,13 @@ bool save_log_abs_data(const std::string & name, const std::vector<real> & data)
 	return save_data(name, log_abs_data);
 }
 
+template <class real>
 bool save_log_abs_data(const std::string & name, const real & data)
 {
 	return save_data(name, log(abs(data)));
 }
 
+template <class real>
 bool open_data(std::vector<real> & data, const std::string & name)
 {
 	std::ifstream in;
@@ -104,6 +110,7 @@ bool open_data(std::vector<real> & data, const std::string & name)
 	return true;
 }
 
+template <class real>
 bool open_data(real & data, const std::string & name)
 {
 	std::vector<real> container;
@@ -115,3 +122,13 @@ bool open_data(real & data, const std::string & name)
 	data = container[0];
 	return true;
 }
+
+#define INSTANTIATE_IO(real) \
+	template bool save_data<real>(const std::string & name, const std::vector<real> & data); \
+	template bool save_data<real>(const std::string & name, const real & data); \
+	template bool save_log_abs_data<real>(const std::string & name, const std::vector<real> & data); \
+	template bool save_log_abs_data<real>(const std::string & name, const real & data); \
+	template bool open_data<real>(std::vector<real> & data, const std::string & name); \
+	template bool open_data<real>(real & data, const std::string & name);
+
+FOR_EACH_REAL_TYPE(INSTANTIATE_IO)
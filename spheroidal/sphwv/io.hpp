@@ -32,11 +32,17 @@
 #include <string>
 #include <vector>
 
+template <class real>
 bool save_data(const std::string & name, const std::vector<real> & data);
+template <class real>
 bool save_data(const std::string & name, const real & data);
+template <class real>
 bool save_log_abs_data(const std::string & name, const std::vector<real> & data);
+template <class real>
 bool save_log_abs_data(const std::string & name, const real & data);
+template <class real>
 bool open_data(std::vector<real> & data, const std::string & name);
+template <class real>
 bool open_data(real & data, const std::string & name);
 
 #endif
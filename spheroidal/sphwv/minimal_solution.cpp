@@ -0,0 +1,299 @@
+//
+// Copyright (c) 2014, Ross Adelman, Nail A. Gumerov, and Ramani Duraiswami
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include "acceleration.hpp"
+#include <algorithm>
+#include <chrono>
+#include "complex.hpp"
+#include "continued_fraction.hpp"
+#include <iostream>
+#include "minimal_solution.hpp"
+#include "real.hpp"
+#include "real_types.hpp"
+#include <string>
+#include <vector>
+
+static double get_seconds_since(const std::chrono::steady_clock::time_point & start);
+template <class real>
+static void add_to_accelerators(accelerator<real> & a_accelerator, accelerator<real> & b_accelerator, const real & x);
+template <class real>
+static void add_to_accelerators(accelerator<real> & a_accelerator, accelerator<real> & b_accelerator, const complex<real> & x);
+template <class real>
+static bool get_accelerated(real & x, const accelerator<real> & a_accelerator, const accelerator<real> & b_accelerator);
+template <class real>
+static bool get_accelerated(complex<real> & x, const accelerator<real> & a_accelerator, const accelerator<real> & b_accelerator);
+
+static double get_seconds_since(const std::chrono::steady_clock::time_point & start)
+{
+	return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+//
+// A complex sequence is accelerated one part at a time, with the real part
+// in a_accelerator, and the imaginary part in b_accelerator.  A real
+// sequence only uses a_accelerator.
+//
+template <class real>
+static void add_to_accelerators(accelerator<real> & a_accelerator, accelerator<real> & b_accelerator, const real & x)
+{
+	a_accelerator.add(x);
+}
+
+template <class real>
+static void add_to_accelerators(accelerator<real> & a_accelerator, accelerator<real> & b_accelerator, const complex<real> & x)
+{
+	a_accelerator.add(x.a);
+	b_accelerator.add(x.b);
+}
+
+template <class real>
+static bool get_accelerated(real & x, const accelerator<real> & a_accelerator, const accelerator<real> & b_accelerator)
+{
+	if (!a_accelerator.has_converged())
+	{
+		return false;
+	}
+	x = a_accelerator.get_value();
+	return true;
+}
+
+template <class real>
+static bool get_accelerated(complex<real> & x, const accelerator<real> & a_accelerator, const accelerator<real> & b_accelerator)
+{
+	if (!a_accelerator.has_converged() || !b_accelerator.has_converged())
+	{
+		return false;
+	}
+	x = complex<real>(a_accelerator.get_value(), b_accelerator.get_value());
+	return true;
+}
+
+template <class real, class number>
+minimal_solution<real, number>::minimal_solution()
+{
+	k_min = real::ZERO;
+	step = real::ONE;
+	n_ratios = 0;
+	n_terms = 0;
+	start_time = 0.0;
+	recurrence_time = 0.0;
+	normalization_time = 0.0;
+}
+
+template <class real, class number>
+void minimal_solution<real, number>::calculate_ratios(bool verbose, const std::string & name, const coefficients & get_coefficients, const real & kk_min, const real & k_max, const real & sstep, const real & max_terms, start_test test)
+{
+	std::chrono::steady_clock::time_point start;
+	fraction N_fraction;
+	accelerator<real> a_accelerator;
+	accelerator<real> b_accelerator;
+	bool accelerated;
+	number a;
+	number b;
+	number c;
+	number prev_c;
+	real next_check;
+	bool have_prev_N;
+	number prev_N;
+	number N_top;
+	number change;
+	
+	k_min = kk_min;
+	step = sstep;
+	n_ratios = gzbi((k_max - k_min) / step);
+	if ((int)N.size() < n_ratios + 1)
+	{
+		N.resize(n_ratios + 1);
+	}
+	n_terms = 0;
+	if (n_ratios == 0)
+	{
+		return;
+	}
+	start = std::chrono::steady_clock::now();
+	N_fraction.clear(real::ZERO);
+	next_check = real::ONE;
+	have_prev_N = false;
+	accelerated = false;
+	for (real i = real::ZERO; i < max_terms; i += 1)
+	{
+		if (remainder(i, 10000) == real::ZERO && i > real::ZERO)
+		{
+			if (verbose)
+			{
+				std::cout << name << ": " << i.get_int() << std::endl;
+			}
+		}
+		get_coefficients(a, b, c, k_max + i * step);
+		if (i > real::ZERO)
+		{
+			N_fraction.add(prev_c * a, b);
+		}
+		else
+		{
+			N_fraction.add(a, b);
+		}
+		prev_c = c;
+		if (acceleration::method != acceleration::NONE)
+		{
+			add_to_accelerators(a_accelerator, b_accelerator, number(-N_fraction.get_value()));
+			if (get_accelerated(N_top, a_accelerator, b_accelerator))
+			{
+				accelerated = true;
+				break;
+			}
+		}
+		if (test == EVERY_TERM)
+		{
+			if (N_fraction.has_converged())
+			{
+				if (verbose)
+				{
+					std::cout << name << ": " << N_fraction.get_change().get_string(10) << std::endl;
+				}
+				break;
+			}
+		}
+		else if (i == next_check)
+		{
+			next_check *= 2;
+			N_top = -N_fraction.get_value();
+			if (have_prev_N)
+			{
+				change = (N_top - prev_N) / prev_N;
+				if (verbose)
+				{
+					std::cout << name << ": " << i.get_int() << ": " << change.get_string(10) << std::endl;
+				}
+				if (abs(change) < real::SMALL_ENOUGH)
+				{
+					break;
+				}
+			}
+			have_prev_N = true;
+			prev_N = N_top;
+		}
+	}
+	n_terms = N_fraction.get_n_terms();
+	if (test == POWERS_OF_TWO)
+	{
+		a_accelerator.report(verbose, name, std::max(next_check.get_int() + 1, 3));
+	}
+	else
+	{
+		a_accelerator.report(verbose, name, 0);
+	}
+	if (test == EVERY_TERM && !accelerated)
+	{
+		N_top = -N_fraction.get_value();
+	}
+	start_time += get_seconds_since(start);
+	start = std::chrono::steady_clock::now();
+	N[n_ratios] = N_top;
+	for (int j = n_ratios - 1; j >= 1; --j)
+	{
+		get_coefficients(a, b, c, k_min + j * step);
+		N[j] = a / (b - c * N[j + 1]);
+	}
+	recurrence_time += get_seconds_since(start);
+}
+
+template <class real, class number>
+void minimal_solution<real, number>::calculate_backward(std::vector<number> & y)
+{
+	std::chrono::steady_clock::time_point start;
+	
+	start = std::chrono::steady_clock::now();
+	y[gzbi(k_min + n_ratios * step)] = real::ONE;
+	for (int j = n_ratios; j >= 1; --j)
+	{
+		y[gzbi(k_min + (j - 1) * step)] = y[gzbi(k_min + j * step)] / N[j];
+	}
+	recurrence_time += get_seconds_since(start);
+}
+
+template <class real, class number>
+void minimal_solution<real, number>::calculate_forward(std::vector<number> & y)
+{
+	std::chrono::steady_clock::time_point start;
+	
+	start = std::chrono::steady_clock::now();
+	for (int j = 1; j <= n_ratios; ++j)
+	{
+		y[gzbi(k_min + j * step)] = N[j] * y[gzbi(k_min + (j - 1) * step)];
+	}
+	normalization_time += get_seconds_since(start);
+}
+
+template <class real, class number>
+void minimal_solution<real, number>::scale(std::vector<number> & y, const number & s)
+{
+	std::chrono::steady_clock::time_point start;
+	
+	start = std::chrono::steady_clock::now();
+	for (int j = 0; j <= n_ratios; ++j)
+	{
+		y[gzbi(k_min + j * step)] *= s;
+	}
+	normalization_time += get_seconds_since(start);
+}
+
+template <class real, class number>
+int minimal_solution<real, number>::get_n_terms() const
+{
+	return n_terms;
+}
+
+template <class real, class number>
+double minimal_solution<real, number>::get_start_time() const
+{
+	return start_time;
+}
+
+template <class real, class number>
+double minimal_solution<real, number>::get_recurrence_time() const
+{
+	return recurrence_time;
+}
+
+template <class real, class number>
+double minimal_solution<real, number>::get_normalization_time() const
+{
+	return normalization_time;
+}
+
+template <class real, class number>
+void minimal_solution<real, number>::print_times(const std::string & name) const
+{
+	std::cout << name << ": " << n_terms << " terms, start: " << start_time << " s, recurrence: " << recurrence_time << " s, normalization: " << normalization_time << " s" << std::endl;
+}
+
+#define INSTANTIATE_MINIMAL_SOLUTION(real) \
+	template class minimal_solution<real, real>; \
+	template class minimal_solution<real, complex<real> >;
+
+FOR_EACH_REAL_TYPE(INSTANTIATE_MINIMAL_SOLUTION)
@@ -0,0 +1,118 @@
+//
+// Copyright (c) 2014, Ross Adelman, Nail A. Gumerov, and Ramani Duraiswami
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#ifndef MINIMAL_SOLUTION_HPP
+#define MINIMAL_SOLUTION_HPP
+
+#include "complex.hpp"
+#include "continued_fraction.hpp"
+#include <functional>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+//
+// minimal_solution works out the minimal solution of a three-term recurrence
+//
+//     a_k * y_(k - step) - b_k * y_k + c_k * y_(k + step) = 0,
+//
+// for k = k_min, k_min + step, ..., k_max, which is what the d_r's, the
+// spherical Bessel functions of the first kind, and the Legendre functions
+// of the second kind all are.  The minimal solution can't be worked out
+// going forward, since any error grows into the dominant solution, so it's
+// worked out backward (Miller's algorithm) from the ratios
+//
+//     N_k = y_k / y_(k - step) = a_k / (b_k - c_k * N_(k + step)),
+//
+// where N_(k_max) is found with a continued_fraction (which is this same
+// formula over and over).  get_coefficients(a, b, c, k) gives a_k, b_k, and
+// c_k.
+//
+// There are three stages:
+//
+// 1. the start, in calculate_ratios, which adds terms to the continued
+// fraction for N_(k_max) until it converges, or until there have been
+// max_terms terms.  With EVERY_TERM, it's checked after every term, and,
+// with POWERS_OF_TWO, it's checked (against the last check) after 1, 2, 4,
+// 8, ... terms, which is slower, but better when the fraction converges
+// slowly.
+// 2. the recurrence, which is the rest of calculate_ratios, and then
+// calculate_backward, which sets y_(k_max) to 1, and works out the rest of
+// y from there, or calculate_forward, which starts from y_(k_min) (which
+// has to already be set), and goes the other way.
+// 3. the normalization, which is scale, and which is up to the caller.
+// Going forward from a known y_(k_min) is also a normalization, since it
+// doesn't need one afterward, so it's counted here too.
+//
+// With acceleration (see acceleration.hpp), the values of the continued
+// fraction are also fed to an accelerator (one for each part, if they're
+// complex), and the start stops as soon as it converges.
+//
+// The time that's spent in each stage (in seconds) is added up over every
+// call, and it's printed along with the number of terms that the last start
+// took by print_times.  y is indexed like the rest of the code (y[gzbi(k)]),
+// and N is kept between calls, so that it only has to grow, instead of being
+// made again every time.
+//
+template <class real, class number>
+class minimal_solution
+{
+public:
+	enum start_test
+	{
+		EVERY_TERM,
+		POWERS_OF_TWO
+	};
+	
+	typedef std::function<void (number & a, number & b, number & c, const real & k)> coefficients;
+	
+	std::vector<number> N;
+	
+	minimal_solution();
+	void calculate_ratios(bool verbose, const std::string & name, const coefficients & get_coefficients, const real & kk_min, const real & k_max, const real & sstep, const real & max_terms, start_test test);
+	void calculate_backward(std::vector<number> & y);
+	void calculate_forward(std::vector<number> & y);
+	void scale(std::vector<number> & y, const number & s);
+	int get_n_terms() const;
+	double get_start_time() const;
+	double get_recurrence_time() const;
+	double get_normalization_time() const;
+	void print_times(const std::string & name) const;
+	
+private:
+	typedef typename std::conditional<std::is_same<number, real>::value, continued_fraction<real>, complex_continued_fraction<real> >::type fraction;
+	
+	real k_min;
+	real step;
+	int n_ratios;
+	int n_terms;
+	double start_time;
+	double recurrence_time;
+	double normalization_time;
+};
+
+#endif
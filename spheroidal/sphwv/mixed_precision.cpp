@@ -0,0 +1,107 @@
+//
+// Copyright (c) 2014, Ross Adelman, Nail A. Gumerov, and Ramani Duraiswami
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include <atomic>
+#include <iostream>
+#include "mixed_precision.hpp"
+#include "real.hpp"
+#include "real_types.hpp"
+#include <string>
+
+bool mixed_precision::enabled = false;
+std::atomic<long> mixed_precision::n_products(0);
+std::atomic<long> mixed_precision::n_rounded(0);
+std::atomic<long> mixed_precision::n_bits(0);
+std::atomic<long> mixed_precision::n_full_bits(0);
+
+void mixed_precision::print_statistics()
+{
+	std::cout << "mixed_precision: " << n_products << " products, " << n_rounded << " rounded, to " << (n_full_bits > 0 ? (100.0 * (double)n_bits) / (double)n_full_bits : 100.0) << "% of the bits" << std::endl;
+}
+
+template <class real>
+series_tail<real>::series_tail()
+{
+	clear();
+}
+
+template <class real>
+void series_tail<real>::clear()
+{
+	n_rounded = 0;
+}
+
+template <class real>
+void series_tail<real>::multiply(real & x, const real & a, const real & b, const real & sum)
+{
+	long bits;
+	
+	if (!mixed_precision::enabled)
+	{
+		x = a * b;
+		return;
+	}
+	bits = mul_for_sum(x, a, b, sum, mixed_precision::GUARD_BITS);
+	++mixed_precision::n_products;
+	if (bits < x.get_precision())
+	{
+		++n_rounded;
+		++mixed_precision::n_rounded;
+		mixed_precision::n_bits += bits;
+		mixed_precision::n_full_bits += x.get_precision();
+	}
+}
+
+//
+// With mixed precision, a * c is done to the full precision, and only the
+// product with b is rounded.
+//
+template <class real>
+void series_tail<real>::multiply(real & x, const real & a, const real & b, const real & c, const real & sum)
+{
+	if (!mixed_precision::enabled)
+	{
+		x = a * b * c;
+		return;
+	}
+	ac = a * c;
+	multiply(x, ac, b, sum);
+}
+
+template <class real>
+void series_tail<real>::report(bool verbose, const std::string & name)
+{
+	if (verbose && mixed_precision::enabled)
+	{
+		std::cout << name << ": " << n_rounded << " products rounded, error bound " << n_rounded << " * 2^-" << mixed_precision::GUARD_BITS << " ulp" << std::endl;
+	}
+}
+
+#define INSTANTIATE_SERIES_TAIL(real) \
+	template class series_tail<real>;
+
+FOR_EACH_REAL_TYPE(INSTANTIATE_SERIES_TAIL)
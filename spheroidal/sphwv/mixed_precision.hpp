@@ -0,0 +1,90 @@
+//
+// Copyright (c) 2014, Ross Adelman, Nail A. Gumerov, and Ramani Duraiswami
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#ifndef MIXED_PRECISION_HPP
+#define MIXED_PRECISION_HPP
+
+#include <atomic>
+#include <string>
+
+//
+// mixed_precision::enabled is set by main with -mixed_precision y.  It's off
+// by default, in which case every term of every series is worked out to the
+// full precision, like it always has been.  When it's on, the series that
+// use a series_tail (below) round the products that make up their terms to
+// only the bits that can still reach the sum, plus GUARD_BITS more.
+//
+// The counters are added up over every series_tail: n_products is how many
+// products they did, n_rounded is how many of those were rounded to fewer
+// bits than the full precision, and n_bits and n_full_bits are how many bits
+// those were rounded to and would have had.  They're atomic, so that tails
+// on different threads can count at the same time.  With -verbose y, main
+// prints them at the end.
+//
+class mixed_precision
+{
+public:
+	static const int GUARD_BITS = 32;
+	
+	static bool enabled;
+	static std::atomic<long> n_products;
+	static std::atomic<long> n_rounded;
+	static std::atomic<long> n_bits;
+	static std::atomic<long> n_full_bits;
+	
+	static void print_statistics();
+};
+
+//
+// series_tail works out the terms of one series.  multiply sets x to a * b
+// (or a * b * c) with the last product rounded with mul_for_sum, so that it
+// only has as many bits as it needs next to sum, which is the series' sum
+// so far.  With mixed_precision::enabled off, it's just a * b (or a * b *
+// c), to the bit.
+//
+// Each rounded product is off by at most 2^-GUARD_BITS of an ulp of the sum
+// at the time, so the terms together are off by at most n_rounded times
+// that, which is the error bound that report prints (with verbose), in ulps
+// of the largest partial sum.
+//
+template <class real>
+class series_tail
+{
+public:
+	long n_rounded;
+	
+	series_tail();
+	void clear();
+	void multiply(real & x, const real & a, const real & b, const real & sum);
+	void multiply(real & x, const real & a, const real & b, const real & c, const real & sum);
+	void report(bool verbose, const std::string & name);
+	
+private:
+	real ac;
+};
+
+#endif
@@ -0,0 +1,1008 @@
+//
+// Copyright (c) 2014, Ross Adelman, Nail A. Gumerov, and Ramani Duraiswami
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#ifndef NATIVE_REAL_HPP
+#define NATIVE_REAL_HPP
+
+#include <cstdlib>
+#include "double_double.hpp"
+#include "extended_double.hpp"
+#include <mpfr.h>
+#include <quadmath.h>
+#include "real.hpp"
+#include <string>
+
+//
+// native_math<F> is everything that native_real needs to know about the
+// floating-point type F: how to parse it, its transcendental functions, its
+// precision (in bits), and how to convert it exactly to an mpfr_t, which is
+// how it gets printed.
+//
+template <class F>
+class native_math;
+
+template <>
+class native_math<double>
+{
+public:
+	static const int bits = 53;
+	
+	static double parse(const std::string & a)
+	{
+		return std::strtod(a.c_str(), 0);
+	}
+	
+	static double nan()
+	{
+		return __builtin_nan("");
+	}
+	
+	static double inf()
+	{
+		return __builtin_inf();
+	}
+	
+	static double eps()
+	{
+		return __builtin_ldexp(1.0, -bits);
+	}
+	
+	static double abs(double a)
+	{
+		return __builtin_fabs(a);
+	}
+	
+	static double atan(double a)
+	{
+		return __builtin_atan(a);
+	}
+	
+	static double atan2(double b, double a)
+	{
+		return __builtin_atan2(b, a);
+	}
+	
+	static double cos(double a)
+	{
+		return __builtin_cos(a);
+	}
+	
+	static double log(double a)
+	{
+		return __builtin_log(a);
+	}
+	
+	static double pow(double a, double b)
+	{
+		return __builtin_pow(a, b);
+	}
+	
+	static double remainder(double a, double b)
+	{
+		return __builtin_remainder(a, b);
+	}
+	
+	static double round(double a)
+	{
+		return __builtin_rint(a);
+	}
+	
+	static double sin(double a)
+	{
+		return __builtin_sin(a);
+	}
+	
+	static double sqrt(double a)
+	{
+		return __builtin_sqrt(a);
+	}
+	
+	static long to_long(double a)
+	{
+		return (long)a;
+	}
+	
+	static double to_double(double a)
+	{
+		return a;
+	}
+	
+	static void to_mpfr(mpfr_ptr x, double a)
+	{
+		mpfr_set_d(x, a, MPFR_RNDN);
+	}
+};
+
+template <>
+class native_math<long double>
+{
+public:
+	static const int bits = 64;
+	
+	static long double parse(const std::string & a)
+	{
+		return std::strtold(a.c_str(), 0);
+	}
+	
+	static long double nan()
+	{
+		return __builtin_nanl("");
+	}
+	
+	static long double inf()
+	{
+		return __builtin_infl();
+	}
+	
+	static long double eps()
+	{
+		return __builtin_ldexpl(1.0L, -bits);
+	}
+	
+	static long double abs(long double a)
+	{
+		return __builtin_fabsl(a);
+	}
+	
+	static long double atan(long double a)
+	{
+		return __builtin_atanl(a);
+	}
+	
+	static long double atan2(long double b, long double a)
+	{
+		return __builtin_atan2l(b, a);
+	}
+	
+	static long double cos(long double a)
+	{
+		return __builtin_cosl(a);
+	}
+	
+	static long double log(long double a)
+	{
+		return __builtin_logl(a);
+	}
+	
+	static long double pow(long double a, long double b)
+	{
+		return __builtin_powl(a, b);
+	}
+	
+	static long double remainder(long double a, long double b)
+	{
+		return __builtin_remainderl(a, b);
+	}
+	
+	static long double round(long double a)
+	{
+		return __builtin_rintl(a);
+	}
+	
+	static long double sin(long double a)
+	{
+		return __builtin_sinl(a);
+	}
+	
+	static long double sqrt(long double a)
+	{
+		return __builtin_sqrtl(a);
+	}
+	
+	static long to_long(long double a)
+	{
+		return (long)a;
+	}
+	
+	static double to_double(long double a)
+	{
+		return (double)a;
+	}
+	
+	static void to_mpfr(mpfr_ptr x, long double a)
+	{
+		mpfr_set_ld(x, a, MPFR_RNDN);
+	}
+};
+
+template <>
+class native_math<__float128>
+{
+public:
+	static const int bits = 113;
+	
+	static __float128 parse(const std::string & a)
+	{
+		return strtoflt128(a.c_str(), 0);
+	}
+	
+	static __float128 nan()
+	{
+		return nanq("");
+	}
+	
+	static __float128 inf()
+	{
+		return (__float128)__builtin_inf();
+	}
+	
+	static __float128 eps()
+	{
+		return ldexpq((__float128)1.0, -bits);
+	}
+	
+	static __float128 abs(__float128 a)
+	{
+		return fabsq(a);
+	}
+	
+	static __float128 atan(__float128 a)
+	{
+		return atanq(a);
+	}
+	
+	static __float128 atan2(__float128 b, __float128 a)
+	{
+		return atan2q(b, a);
+	}
+	
+	static __float128 cos(__float128 a)
+	{
+		return cosq(a);
+	}
+	
+	static __float128 log(__float128 a)
+	{
+		return logq(a);
+	}
+	
+	static __float128 pow(__float128 a, __float128 b)
+	{
+		return powq(a, b);
+	}
+	
+	static __float128 remainder(__float128 a, __float128 b)
+	{
+		return remainderq(a, b);
+	}
+	
+	static __float128 round(__float128 a)
+	{
+		return rintq(a);
+	}
+	
+	static __float128 sin(__float128 a)
+	{
+		return sinq(a);
+	}
+	
+	static __float128 sqrt(__float128 a)
+	{
+		return sqrtq(a);
+	}
+	
+	static long to_long(__float128 a)
+	{
+		return (long)a;
+	}
+	
+	static double to_double(__float128 a)
+	{
+		return (double)a;
+	}
+	
+	//
+	// MPFR can't take a __float128 directly, so it's split into doubles.
+	// The exponent is split off first (like an extended_double's), since a
+	// __float128's range is much wider than a double's, and the mantissa,
+	// which is between 1 / 2 and 1, always fits in three doubles.  The sum
+	// is done at (at least) 113 bits, and the exponent is put back on
+	// afterward, so it's exact.
+	//
+	static void to_mpfr(mpfr_ptr x, __float128 a)
+	{
+		int e;
+		double d;
+		
+		if (a == 0 || !finiteq(a))
+		{
+			mpfr_set_d(x, (double)a, MPFR_RNDN);
+			return;
+		}
+		a = frexpq(a, &e);
+		d = (double)a;
+		mpfr_set_d(x, d, MPFR_RNDN);
+		a = a - d;
+		d = (double)a;
+		mpfr_add_d(x, x, d, MPFR_RNDN);
+		a = a - d;
+		mpfr_add_d(x, x, (double)a, MPFR_RNDN);
+		mpfr_mul_2si(x, x, e, MPFR_RNDN);
+	}
+};
+
+//
+// The transcendental functions of a double_double are done in __float128,
+// which has more than enough bits, and then split back up.
+//
+template <>
+class native_math<double_double>
+{
+public:
+	static const int bits = 106;
+	
+	static double_double parse(const std::string & a)
+	{
+		return double_double(strtoflt128(a.c_str(), 0));
+	}
+	
+	static double_double nan()
+	{
+		return double_double(__builtin_nan(""));
+	}
+	
+	static double_double inf()
+	{
+		return double_double(__builtin_inf());
+	}
+	
+	static double_double eps()
+	{
+		return double_double(__builtin_ldexp(1.0, -bits));
+	}
+	
+	static double_double abs(const double_double & a)
+	{
+		return a.hi < 0.0 ? -a : a;
+	}
+	
+	static double_double atan(const double_double & a)
+	{
+		return double_double(atanq((__float128)a));
+	}
+	
+	static double_double atan2(const double_double & b, const double_double & a)
+	{
+		return double_double(atan2q((__float128)b, (__float128)a));
+	}
+	
+	static double_double cos(const double_double & a)
+	{
+		return double_double(cosq((__float128)a));
+	}
+	
+	static double_double log(const double_double & a)
+	{
+		return double_double(logq((__float128)a));
+	}
+	
+	static double_double pow(const double_double & a, const double_double & b)
+	{
+		return double_double(powq((__float128)a, (__float128)b));
+	}
+	
+	static double_double remainder(const double_double & a, const double_double & b)
+	{
+		return double_double(remainderq((__float128)a, (__float128)b));
+	}
+	
+	static double_double round(const double_double & a)
+	{
+		return double_double(rintq((__float128)a));
+	}
+	
+	static double_double sin(const double_double & a)
+	{
+		return double_double(sinq((__float128)a));
+	}
+	
+	static double_double sqrt(const double_double & a)
+	{
+		return double_double(sqrtq((__float128)a));
+	}
+	
+	static long to_long(const double_double & a)
+	{
+		return (long)(__float128)a;
+	}
+	
+	static double to_double(const double_double & a)
+	{
+		return a.hi;
+	}
+	
+	static void to_mpfr(mpfr_ptr x, const double_double & a)
+	{
+		mpfr_set_d(x, a.hi, MPFR_RNDN);
+		if (__builtin_isfinite(a.hi))
+		{
+			mpfr_add_d(x, x, a.lo, MPFR_RNDN);
+		}
+	}
+};
+
+//
+// An extended_double is parsed and printed through MPFR, whose exponent range
+// is big enough for it.  Everything but the arithmetic, which has to keep
+// track of the exponent, only needs a double's range, and is done with
+// doubles.  pow is exact (up to rounding) for integer powers, which is most
+// of them, and otherwise goes through log2, which loses a few bits when the
+// result is very big or very small.
+//
+template <>
+class native_math<extended_double>
+{
+public:
+	static const int bits = 53;
+	
+	static extended_double parse(const std::string & a)
+	{
+		mpfr_t x;
+		double m;
+		long e;
+		
+		mpfr_init2(x, bits);
+		mpfr_set_str(x, a.c_str(), 10, MPFR_RNDN);
+		m = mpfr_get_d_2exp(&e, x, MPFR_RNDN);
+		mpfr_clear(x);
+		return extended_double(m, e);
+	}
+	
+	static extended_double nan()
+	{
+		return extended_double(__builtin_nan(""));
+	}
+	
+	static extended_double inf()
+	{
+		return extended_double(__builtin_inf());
+	}
+	
+	static extended_double eps()
+	{
+		return extended_double(__builtin_ldexp(1.0, -bits));
+	}
+	
+	static extended_double abs(const extended_double & a)
+	{
+		return extended_double(__builtin_fabs(a.m), a.e);
+	}
+	
+	static extended_double atan(const extended_double & a)
+	{
+		return extended_double(__builtin_atan(a.get_double()));
+	}
+	
+	//
+	// Only the ratio of b and a matters, so they're both scaled by the
+	// bigger exponent first.
+	//
+	static extended_double atan2(const extended_double & b, const extended_double & a)
+	{
+		long s;
+		
+		s = a.e > b.e ? a.e : b.e;
+		return extended_double(__builtin_atan2(extended_double(b.m, b.e - s).get_double(), extended_double(a.m, a.e - s).get_double()));
+	}
+	
+	static extended_double cos(const extended_double & a)
+	{
+		return extended_double(__builtin_cos(a.get_double()));
+	}
+	
+	static extended_double log(const extended_double & a)
+	{
+		return extended_double(__builtin_log(a.m) + (double)a.e * 0.69314718055994530941723212145817656807550013436026);
+	}
+	
+	static extended_double pow(const extended_double & a, const extended_double & b)
+	{
+		extended_double x;
+		extended_double y;
+		double p;
+		long n;
+		double t;
+		
+		p = b.get_double();
+		if (p == __builtin_rint(p) && __builtin_fabs(p) < 2147483648.0)
+		{
+			x = extended_double(1.0);
+			y = a;
+			for (n = (long)__builtin_fabs(p); n > 0; n = n / 2)
+			{
+				if (n % 2 == 1)
+				{
+					x = x * y;
+				}
+				y = y * y;
+			}
+			return p < 0.0 ? extended_double(1.0) / x : x;
+		}
+		else if (a.m <= 0.0 || !a.finite())
+		{
+			return extended_double(__builtin_pow(a.m, p));
+		}
+		t = p * (__builtin_log2(a.m) + (double)a.e);
+		if (!__builtin_isfinite(t))
+		{
+			return extended_double(__builtin_exp2(t));
+		}
+		n = (long)__builtin_floor(t);
+		return extended_double(__builtin_exp2(t - (double)n), n);
+	}
+	
+	static extended_double remainder(const extended_double & a, const extended_double & b)
+	{
+		return extended_double(__builtin_remainder(a.get_double(), b.get_double()));
+	}
+	
+	static extended_double round(const extended_double & a)
+	{
+		if (a.e >= bits)
+		{
+			return a;
+		}
+		return extended_double(__builtin_rint(a.get_double()));
+	}
+	
+	static extended_double sin(const extended_double & a)
+	{
+		return extended_double(__builtin_sin(a.get_double()));
+	}
+	
+	//
+	// The exponent is made even (which makes the mantissa up to twice as big)
+	// so that it can just be halved.
+	//
+	static extended_double sqrt(const extended_double & a)
+	{
+		long e;
+		
+		e = a.e - (a.e & 1);
+		return extended_double(__builtin_sqrt(__builtin_ldexp(a.m, (int)(a.e - e))), e / 2);
+	}
+	
+	static long to_long(const extended_double & a)
+	{
+		return (long)a.get_double();
+	}
+	
+	static double to_double(const extended_double & a)
+	{
+		return a.get_double();
+	}
+	
+	static void to_mpfr(mpfr_ptr x, const extended_double & a)
+	{
+		mpfr_set_d(x, a.m, MPFR_RNDN);
+		mpfr_mul_2si(x, x, a.e, MPFR_RNDN);
+	}
+};
+
+//
+// A real backed by a hardware (or, for double_double and __float128,
+// software-emulated) floating-point type F instead of MPFR.  It has the same
+// interface as a real, so the code that calculates the coefficients and the
+// functions can be instantiated for it too, but it doesn't build
+// expressions, since F's own arithmetic is already as fast as it gets.
+// Since its precision is fixed by F, and so is its range (except for an
+// extended_double's), it's only good for small values of c, but there it's
+// much faster than MPFR, which makes it useful for seeing how much precision
+// a problem actually needs.  With an extended_double, it's also good for
+// evaluating the functions from coefficients that were calculated (and
+// saved) with MPFR, which only needs a double's precision but not its range.
+// Like a fixed_real, it counts against the context's max_reals by its size.
+//
+template <class F>
+class native_real
+{
+public:
+	typedef native_real value_type;
+	
+	static native_real NAN;
+	static native_real INF;
+	static native_real ZERO;
+	static native_real ONE;
+	static native_real TWO;
+	static native_real THREE;
+	static native_real FOUR;
+	static native_real FIVE;
+	static native_real PI;
+	static native_real EPS;
+	static native_real SMALL_ENOUGH;
+	
+	static void begin();
+	
+	F x;
+	
+	native_real() : x()
+	{
+		real_context::add_bytes(sizeof(native_real));
+	}
+	
+	native_real(const native_real & a) : x(a.x)
+	{
+		real_context::add_bytes(sizeof(native_real));
+	}
+	
+	native_real(int a) : x((double)a)
+	{
+		real_context::add_bytes(sizeof(native_real));
+	}
+	
+	native_real(double a) : x(a)
+	{
+		real_context::add_bytes(sizeof(native_real));
+	}
+	
+	native_real(const std::string & a) : x(native_math<F>::parse(a))
+	{
+		real_context::add_bytes(sizeof(native_real));
+	}
+	
+	~native_real()
+	{
+		real_context::remove_bytes(sizeof(native_real));
+	}
+	
+	native_real & operator =(const native_real & a)
+	{
+		x = a.x;
+		return *this;
+	}
+	
+	native_real & operator +=(const native_real & a)
+	{
+		x = x + a.x;
+		return *this;
+	}
+	
+	native_real & operator -=(const native_real & a)
+	{
+		x = x - a.x;
+		return *this;
+	}
+	
+	native_real & operator *=(const native_real & a)
+	{
+		x = x * a.x;
+		return *this;
+	}
+	
+	native_real & operator /=(const native_real & a)
+	{
+		x = x / a.x;
+		return *this;
+	}
+	
+	int get_precision() const
+	{
+		return native_math<F>::bits;
+	}
+	
+	int get_int() const
+	{
+		return (int)native_math<F>::to_long(x);
+	}
+	
+	double get_double() const
+	{
+		return native_math<F>::to_double(x);
+	}
+	
+	std::string get_string(int p) const
+	{
+		std::string string;
+		mpfr_t r;
+		
+		mpfr_init2(r, native_math<F>::bits);
+		native_math<F>::to_mpfr(r, x);
+		string = get_mpfr_string(r, p);
+		mpfr_clear(r);
+		return string;
+	}
+	
+	friend native_real operator +(const native_real & a, const native_real & b)
+	{
+		return from(a.x + b.x);
+	}
+	
+	friend native_real operator -(const native_real & a, const native_real & b)
+	{
+		return from(a.x - b.x);
+	}
+	
+	friend native_real operator *(const native_real & a, const native_real & b)
+	{
+		return from(a.x * b.x);
+	}
+	
+	friend native_real operator /(const native_real & a, const native_real & b)
+	{
+		return from(a.x / b.x);
+	}
+	
+	friend native_real operator -(const native_real & a)
+	{
+		return from(-a.x);
+	}
+	
+	friend bool operator >(const native_real & a, const native_real & b)
+	{
+		return a.x > b.x;
+	}
+	
+	friend bool operator >=(const native_real & a, const native_real & b)
+	{
+		return a.x >= b.x;
+	}
+	
+	friend bool operator <(const native_real & a, const native_real & b)
+	{
+		return a.x < b.x;
+	}
+	
+	friend bool operator <=(const native_real & a, const native_real & b)
+	{
+		return a.x <= b.x;
+	}
+	
+	friend bool operator ==(const native_real & a, const native_real & b)
+	{
+		return a.x == b.x;
+	}
+	
+	friend bool operator !=(const native_real & a, const native_real & b)
+	{
+		return a.x != b.x;
+	}
+	
+	friend native_real abs(const native_real & a)
+	{
+		return from(native_math<F>::abs(a.x));
+	}
+	
+	//
+	// The division is as cheap as looking at the exponents here, so there's
+	// no shortcut (see is_negligible in real.cpp).
+	//
+	friend bool is_negligible(const native_real & change, const native_real & x)
+	{
+		return abs(change) > ZERO && abs(change / x) < SMALL_ENOUGH;
+	}
+	
+	//
+	// The precision is fixed, so the product is always done to all of it (see
+	// set_mpfr_mul_for_sum in real.cpp).
+	//
+	friend long mul_for_sum(native_real & x, const native_real & a, const native_real & b, const native_real & sum, long guard_bits)
+	{
+		x.x = a.x * b.x;
+		return native_math<F>::bits;
+	}
+	
+	//
+	// a * 2^e is rounded to F's precision with MPFR first, and then parsed,
+	// the same way as any other number.  That's slow, but it's only done to
+	// fill the tables in binary_splitting.hpp.
+	//
+	friend void set_z_2exp(native_real & x, mpz_srcptr a, long e)
+	{
+		mpfr_t r;
+		
+		mpfr_init2(r, native_math<F>::bits);
+		mpfr_set_z(r, a, MPFR_RNDN);
+		mpfr_mul_2si(r, r, e, MPFR_RNDN);
+		x.x = native_math<F>::parse(get_mpfr_string(r, 0));
+		mpfr_clear(r);
+	}
+	
+	friend native_real atan(const native_real & a)
+	{
+		return from(native_math<F>::atan(a.x));
+	}
+	
+	friend native_real atan2(const native_real & b, const native_real & a)
+	{
+		return from(native_math<F>::atan2(b.x, a.x));
+	}
+	
+	friend native_real cos(const native_real & a)
+	{
+		return from(native_math<F>::cos(a.x));
+	}
+	
+	//
+	// Like a real's, the factorial of a negative number is 1.
+	//
+	friend native_real factorial(const native_real & a)
+	{
+		native_real x;
+		long n;
+		
+		x = ONE;
+		n = native_math<F>::to_long(a.x);
+		for (long i = 2; i <= n; ++i)
+		{
+			x.x = x.x * F((double)i);
+		}
+		return x;
+	}
+	
+	friend native_real log(const native_real & a)
+	{
+		return from(native_math<F>::log(a.x));
+	}
+	
+	friend native_real max(const native_real & a, const native_real & b)
+	{
+		return a.x < b.x ? b : a;
+	}
+	
+	friend native_real pochhammer(const native_real & a, const native_real & k)
+	{
+		native_real x;
+		
+		x = ONE;
+		for (native_real i = ZERO; i <= k - ONE; i = i + ONE)
+		{
+			x = x * (a + i);
+		}
+		return x;
+	}
+	
+	//
+	// Like a real's, pow hands the easy powers off to something cheaper.  A
+	// half-integer power is an integer power times a square root, which for
+	// an extended_double is also more accurate than going through log2.
+	//
+	friend native_real pow(const native_real & a, const native_real & b)
+	{
+		F h;
+		
+		if (b.x == F(-1.0))
+		{
+			return reciprocal(a);
+		}
+		else if (a.x == F(-1.0) && native_math<F>::round(b.x) == b.x)
+		{
+			return sign_pow(b);
+		}
+		h = b.x + b.x;
+		if (F(0.0) < a.x && native_math<F>::round(b.x) != b.x && native_math<F>::round(h) == h)
+		{
+			return from(native_math<F>::pow(a.x, b.x - F(0.5)) * native_math<F>::sqrt(a.x));
+		}
+		return from(native_math<F>::pow(a.x, b.x));
+	}
+	
+	friend native_real pow_si(const native_real & a, long n)
+	{
+		return from(native_math<F>::pow(a.x, F((double)n)));
+	}
+	
+	friend native_real rec_sqrt(const native_real & a)
+	{
+		return from(F(1.0) / native_math<F>::sqrt(a.x));
+	}
+	
+	friend native_real reciprocal(const native_real & a)
+	{
+		return from(F(1.0) / a.x);
+	}
+	
+	friend native_real remainder(const native_real & a, const native_real & b)
+	{
+		return from(native_math<F>::remainder(a.x, b.x));
+	}
+	
+	friend native_real round(const native_real & a)
+	{
+		return from(native_math<F>::round(a.x));
+	}
+	
+	friend native_real sign_pow(const native_real & n)
+	{
+		return native_math<F>::to_long(n.x) % 2 == 0 ? ONE : from(F(-1.0));
+	}
+	
+	friend native_real sin(const native_real & a)
+	{
+		return from(native_math<F>::sin(a.x));
+	}
+	
+	friend native_real sqrt(const native_real & a)
+	{
+		return from(native_math<F>::sqrt(a.x));
+	}
+	
+	friend int gzbi(const native_real & i)
+	{
+		return i.get_int();
+	}
+	
+	friend int gnobi(const native_real & i)
+	{
+		return -i.get_int() - 1;
+	}
+	
+private:
+	static native_real from(const F & a)
+	{
+		native_real x;
+		
+		x.x = a;
+		return x;
+	}
+};
+
+template <class F>
+native_real<F> native_real<F>::NAN;
+template <class F>
+native_real<F> native_real<F>::INF;
+template <class F>
+native_real<F> native_real<F>::ZERO;
+template <class F>
+native_real<F> native_real<F>::ONE;
+template <class F>
+native_real<F> native_real<F>::TWO;
+template <class F>
+native_real<F> native_real<F>::THREE;
+template <class F>
+native_real<F> native_real<F>::FOUR;
+template <class F>
+native_real<F> native_real<F>::FIVE;
+template <class F>
+native_real<F> native_real<F>::PI;
+template <class F>
+native_real<F> native_real<F>::EPS;
+template <class F>
+native_real<F> native_real<F>::SMALL_ENOUGH;
+
+//
+// EPS is 2^-bits, which is what the loop that a real_context uses gives for
+// a binary type with that many bits.  (The loop doesn't work for a
+// double_double, whose lo can hold a 1 + EPS for any EPS that's not too
+// small.)
+//
+template <class F>
+void native_real<F>::begin()
+{
+	NAN.x = native_math<F>::nan();
+	INF.x = native_math<F>::inf();
+	ZERO = 0;
+	ONE = 1;
+	TWO = 2;
+	THREE = 3;
+	FOUR = 4;
+	FIVE = 5;
+	PI = std::string("3.14159265358979323846264338327950288419716939937510582097494459");
+	EPS.x = native_math<F>::eps();
+	SMALL_ENOUGH = EPS;
+}
+
+#endif
@@ -0,0 +1,72 @@
+//
+// Copyright (c) 2014, Ross Adelman, Nail A. Gumerov, and Ramani Duraiswami
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include <cstdio>
+#include "native_real.hpp"
+#include <quadmath.h>
+#include <string>
+
+static bool check_round_trip(const std::string & value);
+
+//
+// Parses value as a native_real<__float128>, prints it (which goes through
+// native_math<__float128>::to_mpfr), and parses what was printed.  It has to
+// come back to exactly the same __float128.
+//
+static bool check_round_trip(const std::string & value)
+{
+	native_real<__float128> a;
+	native_real<__float128> b;
+	std::string printed;
+	bool ok;
+	
+	a = native_real<__float128>(value);
+	printed = a.get_string(0);
+	b = native_real<__float128>(printed);
+	ok = a.x == b.x;
+	std::printf("%-38s %-45s %s\n", value.c_str(), printed.c_str(), ok ? "ok" : "FAILED");
+	return ok;
+}
+
+//
+// This checks that a __float128 is printed exactly over its whole range,
+// and not just a double's: far below and above the range of a double (where
+// the coefficients of a float128 run end up, with -dr_min 1e-400, say), and
+// down among its subnormals.  It returns 1 if any of them don't round-trip.
+//
+int main(int argc, char **argv)
+{
+	const char *VALUES[] = {"1", "-0.1", "3.14159265358979323846264338327950288", "1e-300", "2.43e-327", "1e-400", "-3.2e-400", "1.2345678901234567890123456789e-400", "7e400", "1e-4940", "1e4900"};
+	bool ok;
+	
+	ok = true;
+	for (int i = 0; i < (int)(sizeof(VALUES) / sizeof(VALUES[0])); ++i)
+	{
+		ok = check_round_trip(VALUES[i]) && ok;
+	}
+	return ok ? 0 : 1;
+}
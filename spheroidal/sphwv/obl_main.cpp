@@ -32,15 +32,22 @@
 #include <iostream>
 #include "obl_spheroidal.hpp"
 #include "real.hpp"
+#include "real_types.hpp"
 #include <string>
 #include <vector>
 
+template <class real>
 static bool save_Qmn(bool verbose, const real & c, const real & m, const real & n);
+template <class real>
 static bool open_Qmn(real & Q, const real & c, const real & m, const real & n);
+template <class real>
 static bool save_B2rmn(bool verbose, const real & c, const real & m, const real & n, real & n_B2r, const real & B2r_min);
+template <class real>
 static bool open_B2rmn(real & n_B2r, std::vector<real> & B2r, const real & c, const real & m, const real & n);
+template <class real>
 static bool save_Rmn(bool verbose, const real & c, const real & m, const real & n, const real & a, const real & b, const real & d, const std::string & arg_type, const std::string & which, int p);
 
+template <class real>
 std::string generate_name(const real & c, const real & m, const real & n, const std::string & name)
 {
 	char raw_string[4096];
@@ -49,6 +56,7 @@ std::string generate_name(const real & c, const real & m, const real & n, const
 	return std::string(raw_string);
 }
 
+template <class real>
 static bool save_Qmn(bool verbose, const real & c, const real & m, const real & n)
 {
 	real lambda;
@@ -80,6 +88,7 @@ static bool save_Qmn(bool verbose, const real & c, const real & m, const real &
 	return true;
 }
 
+template <class real>
 static bool open_Qmn(real & Q, const real & c, const real & m, const real & n)
 {
 	if (!open_data(Q, generate_name(c, m, n, "Q")))
@@ -90,6 +99,7 @@ static bool open_Qmn(real & Q, const real & c, const real & m, const real & n)
 	return true;
 }
 
+template <class real>
 static bool save_B2rmn(bool verbose, const real & c, const real & m, const real & n, real & n_B2r, const real & B2r_min)
 {
 	real lambda;
@@ -123,6 +133,7 @@ static bool save_B2rmn(bool verbose, const real & c, const real & m, const real
 	return true;
 }
 
+template <class real>
 static bool open_B2rmn(real & n_B2r, std::vector<real> & B2r, const real & c, const real & m, const real & n)
 {
 	if (!open_data(B2r, generate_name(c, m, n, "B2r")))
@@ -134,6 +145,7 @@ static bool open_B2rmn(real & n_B2r, std::vector<real> & B2r, const real & c, co
 	return true;
 }
 
+template <class real>
 static bool save_Rmn(bool verbose, const real & c, const real & m, const real & n, const real & a, const real & b, const real & d, const std::string & arg_type, const std::string & which, int p)
 {
 	real n_dr;
@@ -320,6 +332,7 @@ static bool save_Rmn(bool verbose, const real & c, const real & m, const real &
 	return true;
 }
 
+template <class real>
 int parse_args(int argc, char **argv)
 {
 	std::string argument;
@@ -332,6 +345,8 @@ int parse_args(int argc, char **argv)
 	bool m_entered;
 	real n;
 	bool n_entered;
+	real n_max;
+	bool n_max_entered;
 	std::string w;
 	bool w_entered;
 	real n_dr;
@@ -367,6 +382,7 @@ int parse_args(int argc, char **argv)
 	c_entered = false;
 	m_entered = false;
 	n_entered = false;
+	n_max_entered = false;
 	w_entered = false;
 	n_dr_entered = false;
 	dr_min_entered = false;
@@ -406,6 +422,11 @@ int parse_args(int argc, char **argv)
 			n = real(value);
 			n_entered = true;
 		}
+		else if (argument == "-n_max")
+		{
+			n_max = real(value);
+			n_max_entered = true;
+		}
 		else if (argument == "-w")
 		{
 			w = value;
@@ -487,6 +508,15 @@ int parse_args(int argc, char **argv)
 		std::cout << "no value of verbose was entered..." << std::endl;
 		return 1;
 	}
+	else if (w_entered && w == "lambda_all")
+	{
+		if (!c_entered || !m_entered || !n_max_entered)
+		{
+			std::cout << "no value of c, m, and/or n_max was entered..." << std::endl;
+			return 1;
+		}
+		save_lambdamn_all(verbose, c, m, n_max);
+	}
 	else if (!c_entered || !m_entered || !n_entered || !w_entered)
 	{
 		std::cout << "no value of c, m, n, and/or w was entered..." << std::endl;
@@ -590,3 +620,9 @@ int parse_args(int argc, char **argv)
 	}
 	return 0;
 }
+
+#define INSTANTIATE_OBL_MAIN(real) \
+	template std::string generate_name<real>(const real & c, const real & m, const real & n, const std::string & name); \
+	template int parse_args<real>(int argc, char **argv);
+
+FOR_EACH_REAL_TYPE(INSTANTIATE_OBL_MAIN)
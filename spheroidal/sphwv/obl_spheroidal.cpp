@@ -25,40 +25,52 @@
 // POSSIBILITY OF SUCH DAMAGE.
 //
 
+#include "acceleration.hpp"
 #include "adder.hpp"
 #include <algorithm>
 #include "common_spheroidal.hpp"
+#include "complex.hpp"
 #include <iostream>
+#include "minimal_solution.hpp"
 #include "obl_spheroidal.hpp"
 #include "real.hpp"
+#include "real_types.hpp"
 #include <vector>
 
+template <class real>
 static real get_c2k(bool verbose, const real & c, const real & m, const real & n, const real & lambda, real & n_dr, std::vector<real> & dr, real & n_c2k, std::vector<real> & c2k, const real & k);
+template <class real>
 static void calculate_B2rmn_coefficients(std::vector<real> & alpha, std::vector<real> & beta, std::vector<real> & gamma, std::vector<real> & h, bool verbose, const real & c, const real & m, const real & n, const real & lambda, real & n_dr, std::vector<real> & dr, const real & k1, real & n_c2k, std::vector<real> & c2k, const real & Q, std::vector<real> & h_saved, const real & r0, const real & r1);
+template <class real>
 static void calculate_B2rmn_forward(std::vector<real> & alpha, std::vector<real> & beta, std::vector<real> & gamma, std::vector<real> & h, std::vector<real> & B2r, bool verbose, const real & c, const real & m, const real & n, const real & lambda, real & n_dr, std::vector<real> & dr, const real & k1, real & n_c2k, std::vector<real> & c2k, const real & Q, std::vector<real> & h_saved, const real & n_B2r);
+template <class real>
 static void calculate_B2rmn_backward(std::vector<real> & B2r, bool verbose, const real & c, const real & m, const real & n, const real & lambda, real & n_dr, std::vector<real> & dr, const real & k1, real & n_c2k, std::vector<real> & c2k, const real & Q, std::vector<real> & h_saved, const real & n_B2r, std::vector<real> & alpha, std::vector<real> & beta, std::vector<real> & gamma, std::vector<real> & h, const real & r0, const real & B0);
+template <class real>
 static void calculate_B2rmn_once(std::vector<real> & B2r, bool verbose, const real & c, const real & m, const real & n, const real & lambda, real & n_dr, std::vector<real> & dr, const real & k1, real & n_c2k, std::vector<real> & c2k, const real & Q, std::vector<real> & h_saved, const real & n_B2r);
-static complex calculate_continued_fraction(const complex & b0, const std::vector<complex> & a, const std::vector<complex> & b);
-static void calculate_Q(std::vector<complex> & Q, bool verbose, const real & m0, const real & n1, const real & xi);
+template <class real>
+static void calculate_Q(std::vector<complex<real> > & Q, bool verbose, const real & m0, const real & n1, const real & xi);
 
+template <class real>
 real calculate_c_squared(const real & c)
 {
 	return -c * c;
 }
 
+template <class real>
 static real get_c2k(bool verbose, const real & c, const real & m, const real & n, const real & lambda, real & n_dr, std::vector<real> & dr, real & n_c2k, std::vector<real> & c2k, const real & k)
 {
 	if (k >= n_c2k)
 	{
 		while (k >= n_c2k)
 		{
-			n_c2k = real::TWO * n_c2k;
+			n_c2k *= 2;
 		}
-		calculate_c2kmn(c2k, verbose, c, m, n, lambda, n_dr, dr, n_c2k, real::ZERO);
+		calculate_c2kmn<real>(c2k, verbose, c, m, n, lambda, n_dr, dr, n_c2k, real::ZERO);
 	}
 	return c2k[gzbi(k)];
 }
 
+template <class real>
 real calculate_Qmn(bool verbose, const real & c, const real & m, const real & n, const real & lambda, real & n_dr, std::vector<real> & dr, const real & k1, real & n_c2k, std::vector<real> & c2k)
 {
 	std::vector<real> Ck;
@@ -67,72 +79,73 @@ real calculate_Qmn(bool verbose, const real & c, const real & m, const real & n,
 	real Q;
 	
 	Ck.clear();
-	for (real k = real::ZERO; k <= m; k = k + real::ONE)
+	for (real k = real::ZERO; k <= m; k += 1)
 	{
 		Ck.push_back(real::ZERO);
 	}
-	for (real k = real::ZERO; k <= m; k = k + real::ONE)
+	for (real k = real::ZERO; k <= m; k += 1)
 	{
-		Ck[gzbi(k)] = get_c2k(verbose, c, m, n, lambda, n_dr, dr, n_c2k, c2k, k);
+		Ck[gzbi(k)] = get_c2k<real>(verbose, c, m, n, lambda, n_dr, dr, n_c2k, c2k, k);
 	}
 	Bk.clear();
-	for (real k = real::ZERO; k <= m; k = k + real::ONE)
+	for (real k = real::ZERO; k <= m; k += 1)
 	{
 		Bk.push_back(real::ZERO);
 	}
-	for (real i = real::ZERO; i <= m; i = i + real::ONE)
+	for (real i = real::ZERO; i <= m; i += 1)
 	{
 		Bk[gzbi(i)] = real::ZERO;
-		for (real k = real::ZERO; k <= i; k = k + real::ONE)
+		for (real k = real::ZERO; k <= i; k += 1)
 		{
-			Bk[gzbi(i)] = Bk[gzbi(i)] + Ck[gzbi(k)] * Ck[gzbi(i - k)];
+			Bk[gzbi(i)] += Ck[gzbi(k)] * Ck[gzbi(i - k)];
 		}
 	}
 	Ak.clear();
-	for (real k = real::ZERO; k <= m; k = k + real::ONE)
+	for (real k = real::ZERO; k <= m; k += 1)
 	{
 		Ak.push_back(real::ZERO);
 	}
-	Ak[gzbi(real::ZERO)] = real::ONE / Bk[gzbi(real::ZERO)];
-	for (real i = real::ONE; i <= m; i = i + real::ONE)
+	Ak[gzbi(real::ZERO)] = 1 / Bk[gzbi(real::ZERO)];
+	for (real i = real::ONE; i <= m; i += 1)
 	{
 		Ak[gzbi(i)] = real::ZERO;
-		for (real k = real::ZERO; k <= i - real::ONE; k = k + real::ONE)
+		for (real k = real::ZERO; k <= i - 1; k += 1)
 		{
-			Ak[gzbi(i)] = Ak[gzbi(i)] + Ak[gzbi(k)] * Bk[gzbi(i - k)];
+			Ak[gzbi(i)] += Ak[gzbi(k)] * Bk[gzbi(i - k)];
 		}
-		Ak[gzbi(i)] = -(real::ONE / Bk[0]) * Ak[gzbi(i)];
+		Ak[gzbi(i)] *= -(1 / Bk[0]);
 	}
 	if (remainder(n - m, real::TWO) == real::ZERO)
 	{
 		Q = real::ZERO;
-		for (real k = real::ZERO; k <= m; k = k + real::ONE)
+		for (real k = real::ZERO; k <= m; k += 1)
 		{
-			Q = Q + Ak[gzbi(k)] * (factorial(real::TWO * m - real::TWO * k) / (pow(real::TWO, m - k) * factorial(m - k) * pow(real::TWO, m - k) * factorial(m - k)));
+			Q += Ak[gzbi(k)] * (factorial(2 * m - 2 * k) / (pow(real::TWO, m - k) * factorial(m - k) * pow(real::TWO, m - k) * factorial(m - k)));
 		}
-		Q = k1 * k1 * (real::ONE / c) * Q;
+		Q = k1 * k1 * (1 / c) * Q;
 	}
 	else
 	{
 		Q = real::ZERO;
-		for (real k = real::ZERO; k <= m; k = k + real::ONE)
+		for (real k = real::ZERO; k <= m; k += 1)
 		{
-			Q = Q + Ak[gzbi(k)] * (factorial(real::TWO * m - real::TWO * k + real::ONE) / (pow(real::TWO, m - k) * factorial(m - k) * pow(real::TWO, m - k) * factorial(m - k)));
+			Q += Ak[gzbi(k)] * (factorial(2 * m - 2 * k + 1) / (pow(real::TWO, m - k) * factorial(m - k) * pow(real::TWO, m - k) * factorial(m - k)));
 		}
-		Q = -k1 * k1 * (real::ONE / c) * Q;
+		Q = -k1 * k1 * (1 / c) * Q;
 	}
 	return Q;
 }
 
+template <class real>
 static void calculate_B2rmn_coefficients(std::vector<real> & alpha, std::vector<real> & beta, std::vector<real> & gamma, std::vector<real> & h, bool verbose, const real & c, const real & m, const real & n, const real & lambda, real & n_dr, std::vector<real> & dr, const real & k1, real & n_c2k, std::vector<real> & c2k, const real & Q, std::vector<real> & h_saved, const real & r0, const real & r1)
 {
 	real h0;
-	adder h0_adder;
+	adder<real> h0_adder;
 	real k0;
 	real a;
 	real change;
 	real h1;
-	adder h1_adder;
+	adder<real> h1_adder;
 	
 	while (r1 >= real((int)h_saved.size()))
 	{
@@ -142,7 +155,7 @@ static void calculate_B2rmn_coefficients(std::vector<real> & alpha, std::vector<
 	beta.clear();
 	gamma.clear();
 	h.clear();
-	for (real r = r0; r <= r1; r = r + real::ONE)
+	for (real r = r0; r <= r1; r += 1)
 	{
 		alpha.push_back(real::ZERO);
 		beta.push_back(real::ZERO);
@@ -151,10 +164,10 @@ static void calculate_B2rmn_coefficients(std::vector<real> & alpha, std::vector<
 	}
 	if (remainder(n - m, real::TWO) == real::ZERO)
 	{
-		for (real r = r0; r <= r1; r = r + real::ONE)
+		for (real r = r0; r <= r1; r += 1)
 		{
-			alpha[gzbi(r - r0)] = (real::TWO * r + real::TWO) * (real::TWO * r + real::THREE);
-			beta[gzbi(r - r0)] = (real::TWO * r + real::ONE) * (real::TWO * r - real::TWO * m + real::TWO) + m * (m - real::ONE) - lambda;
+			alpha[gzbi(r - r0)] = (2 * r + 2) * (2 * r + 3);
+			beta[gzbi(r - r0)] = (2 * r + 1) * (2 * r - 2 * m + 2) + m * (m - 1) - lambda;
 			gamma[gzbi(r - r0)] = c * c;
 			if (h_saved[gzbi(r)] == h_saved[gzbi(r)])
 			{
@@ -164,28 +177,28 @@ static void calculate_B2rmn_coefficients(std::vector<real> & alpha, std::vector<
 			{
 				h0 = real::ZERO;
 				h0_adder.clear();
-				k0 = max(real::ZERO, r - m + real::ONE);
-				for (real k = k0; ; k = k + real::ONE)
+				k0 = max(real::ZERO, r - m + 1);
+				for (real k = k0; ; k += 1)
 				{
 					if (k > k0)
 					{
-						a = a * ((m + k - real::ONE) / (m + k - r - real::ONE));
+						a *= (m + k - 1) / (m + k - r - 1);
 					}
 					else
 					{
-						if (k == r - m + real::ONE)
+						if (k == r - m + 1)
 						{
 							a = real::ONE;
 						}
 						else
 						{
-							a = factorial(m - real::ONE) / (factorial(m - real::ONE - r) * factorial(r));
+							a = factorial(m - 1) / (factorial(m - 1 - r) * factorial(r));
 						}
 					}
-					change = get_c2k(verbose, c, m, n, lambda, n_dr, dr, n_c2k, c2k, k) * (m + real::TWO * k) * a;
-					h0 = h0 + change;
+					change = get_c2k<real>(verbose, c, m, n, lambda, n_dr, dr, n_c2k, c2k, k) * (m + 2 * k) * a;
+					h0 += change;
 					h0_adder.add(change);
-					if (k > k0 && abs(change) > real::ZERO && abs(change / h0) < real::SMALL_ENOUGH)
+					if (k > k0 && is_negligible(change, h0))
 					{
 						if (verbose)
 						{
@@ -195,17 +208,17 @@ static void calculate_B2rmn_coefficients(std::vector<real> & alpha, std::vector<
 					}
 				}
 				h0 = h0_adder.calculate_sum();
-				h[gzbi(r - r0)] = -((real::TWO * Q) / k1) * h0;
+				h[gzbi(r - r0)] = -((2 * Q) / k1) * h0;
 				h_saved[gzbi(r)] = h[gzbi(r - r0)];
 			}
 		}
 	}
 	else
 	{
-		for (real r = r0; r <= r1; r = r + real::ONE)
+		for (real r = r0; r <= r1; r += 1)
 		{
-			alpha[gzbi(r - r0)] = (real::TWO * r + real::ONE) * (real::TWO * r + real::TWO);
-			beta[gzbi(r - r0)] = real::TWO * r * (real::TWO * r - real::TWO * m + real::ONE) + m * (m - real::ONE) - lambda;
+			alpha[gzbi(r - r0)] = (2 * r + 1) * (2 * r + 2);
+			beta[gzbi(r - r0)] = 2 * r * (2 * r - 2 * m + 1) + m * (m - 1) - lambda;
 			gamma[gzbi(r - r0)] = c * c;
 			if (h_saved[gzbi(r)] == h_saved[gzbi(r)])
 			{
@@ -216,11 +229,11 @@ static void calculate_B2rmn_coefficients(std::vector<real> & alpha, std::vector<
 				h0 = real::ZERO;
 				h0_adder.clear();
 				k0 = max(real::ZERO, r - m);
-				for (real k = k0; ; k = k + real::ONE)
+				for (real k = k0; ; k += 1)
 				{
 					if (k > k0)
 					{
-						a = a * ((m + k) / (m + k - r));
+						a *= (m + k) / (m + k - r);
 					}
 					else
 					{
@@ -233,10 +246,10 @@ static void calculate_B2rmn_coefficients(std::vector<real> & alpha, std::vector<
 							a = factorial(m) / (factorial(m - r) * factorial(r));
 						}
 					}
-					change = get_c2k(verbose, c, m, n, lambda, n_dr, dr, n_c2k, c2k, k) * (m + real::TWO * k + real::ONE) * a;
-					h0 = h0 + change;
+					change = get_c2k<real>(verbose, c, m, n, lambda, n_dr, dr, n_c2k, c2k, k) * (m + 2 * k + 1) * a;
+					h0 += change;
 					h0_adder.add(change);
-					if (k > k0 && abs(change) > real::ZERO && abs(change / h0) < real::SMALL_ENOUGH)
+					if (k > k0 && is_negligible(change, h0))
 					{
 						if (verbose)
 						{
@@ -248,28 +261,28 @@ static void calculate_B2rmn_coefficients(std::vector<real> & alpha, std::vector<
 				h0 = h0_adder.calculate_sum();
 				h1 = real::ZERO;
 				h1_adder.clear();
-				k0 = max(real::ZERO, r - m + real::ONE);
-				for (real k = k0; ; k = k + real::ONE)
+				k0 = max(real::ZERO, r - m + 1);
+				for (real k = k0; ; k += 1)
 				{
 					if (k > k0)
 					{
-						a = a * ((m + k - real::ONE) / (m + k - r - real::ONE));
+						a *= (m + k - 1) / (m + k - r - 1);
 					}
 					else
 					{
-						if (k == r - m + real::ONE)
+						if (k == r - m + 1)
 						{
 							a = real::ONE;
 						}
 						else
 						{
-							a = factorial(m - real::ONE) / (factorial(m - real::ONE - r) * factorial(r));
+							a = factorial(m - 1) / (factorial(m - 1 - r) * factorial(r));
 						}
 					}
-					change = get_c2k(verbose, c, m, n, lambda, n_dr, dr, n_c2k, c2k, k) * (m + real::TWO * k) * a;
-					h1 = h1 + change;
+					change = get_c2k<real>(verbose, c, m, n, lambda, n_dr, dr, n_c2k, c2k, k) * (m + 2 * k) * a;
+					h1 += change;
 					h1_adder.add(change);
-					if (k > k0 && abs(change) > real::ZERO && abs(change / h1) < real::SMALL_ENOUGH)
+					if (k > k0 && is_negligible(change, h1))
 					{
 						if (verbose)
 						{
@@ -279,46 +292,48 @@ static void calculate_B2rmn_coefficients(std::vector<real> & alpha, std::vector<
 					}
 				}
 				h1 = h1_adder.calculate_sum();
-				h[gzbi(r - r0)] = -((real::TWO * Q) / k1) * (h0 - h1);
+				h[gzbi(r - r0)] = -((2 * Q) / k1) * (h0 - h1);
 				h_saved[gzbi(r)] = h[gzbi(r - r0)];
 			}
 		}
 	}
 }
 
+template <class real>
 static void calculate_B2rmn_forward(std::vector<real> & alpha, std::vector<real> & beta, std::vector<real> & gamma, std::vector<real> & h, std::vector<real> & B2r, bool verbose, const real & c, const real & m, const real & n, const real & lambda, real & n_dr, std::vector<real> & dr, const real & k1, real & n_c2k, std::vector<real> & c2k, const real & Q, std::vector<real> & h_saved, const real & n_B2r)
 {
 	real R1;
 	real R1p;
 	
-	calculate_B2rmn_coefficients(alpha, beta, gamma, h, verbose, c, m, n, lambda, n_dr, dr, k1, n_c2k, c2k, Q, h_saved, real::ZERO, n_B2r - real::ONE);
+	calculate_B2rmn_coefficients<real>(alpha, beta, gamma, h, verbose, c, m, n, lambda, n_dr, dr, k1, n_c2k, c2k, Q, h_saved, real::ZERO, n_B2r - 1);
 	B2r.clear();
-	for (real r = real::ZERO; r <= n_B2r - real::ONE; r = r + real::ONE)
+	for (real r = real::ZERO; r <= n_B2r - 1; r += 1)
 	{
 		B2r.push_back(real::ZERO);
 	}
-	calculate_Rmn1_2(R1, R1p, verbose, c, m, n, k1, n_c2k, c2k, real::ZERO);
+	calculate_Rmn1_2<real>(R1, R1p, verbose, c, m, n, k1, n_c2k, c2k, real::ZERO);
 	if (remainder(n - m, real::TWO) == real::ZERO)
 	{
-		B2r[gzbi(real::ZERO)] = pow(c * R1, -real::ONE) - Q * R1;
+		B2r[gzbi(real::ZERO)] = reciprocal(c * R1) - Q * R1;
 	}
 	else
 	{
-		B2r[gzbi(real::ZERO)] = -pow(c * R1p, -real::ONE);
+		B2r[gzbi(real::ZERO)] = -reciprocal(c * R1p);
 	}
-	for (real r = real::ZERO; r <= n_B2r - real::TWO; r = r + real::ONE)
+	for (real r = real::ZERO; r <= n_B2r - 2; r += 1)
 	{
 		if (r > real::ZERO)
 		{
-			B2r[gzbi(r + real::ONE)] = (h[gzbi(r)] - beta[gzbi(r)] * B2r[gzbi(r)] - gamma[gzbi(r)] * B2r[gzbi(r - real::ONE)]) / alpha[gzbi(r)];
+			B2r[gzbi(r + 1)] = (h[gzbi(r)] - beta[gzbi(r)] * B2r[gzbi(r)] - gamma[gzbi(r)] * B2r[gzbi(r - 1)]) / alpha[gzbi(r)];
 		}
 		else
 		{
-			B2r[gzbi(r + real::ONE)] = (h[gzbi(r)] - beta[gzbi(r)] * B2r[gzbi(r)]) / alpha[gzbi(r)];
+			B2r[gzbi(r + 1)] = (h[gzbi(r)] - beta[gzbi(r)] * B2r[gzbi(r)]) / alpha[gzbi(r)];
 		}
 	}
 }
 
+template <class real>
 static void calculate_B2rmn_backward(std::vector<real> & B2r, bool verbose, const real & c, const real & m, const real & n, const real & lambda, real & n_dr, std::vector<real> & dr, const real & k1, real & n_c2k, std::vector<real> & c2k, const real & Q, std::vector<real> & h_saved, const real & n_B2r, std::vector<real> & alpha, std::vector<real> & beta, std::vector<real> & gamma, std::vector<real> & h, const real & r0, const real & B0)
 {
 	std::vector<real> p;
@@ -331,62 +346,62 @@ static void calculate_B2rmn_backward(std::vector<real> & B2r, bool verbose, cons
 	std::vector<real> h_more;
 	real max_abs_change;
 	
-	for (real n_B2r_more = n_B2r; ; n_B2r_more = n_B2r_more + real("100"))
+	for (real n_B2r_more = n_B2r; ; n_B2r_more += 100)
 	{
 		if (n_B2r_more > n_B2r)
 		{
-			calculate_B2rmn_coefficients(alpha_more, beta_more, gamma_more, h_more, verbose, c, m, n, lambda, n_dr, dr, k1, n_c2k, c2k, Q, h_saved, prev_n_B2r_more, n_B2r_more - real::ONE);
+			calculate_B2rmn_coefficients<real>(alpha_more, beta_more, gamma_more, h_more, verbose, c, m, n, lambda, n_dr, dr, k1, n_c2k, c2k, Q, h_saved, prev_n_B2r_more, n_B2r_more - 1);
 			alpha.insert(alpha.end(), alpha_more.begin(), alpha_more.end());
 			beta.insert(beta.end(), beta_more.begin(), beta_more.end());
 			gamma.insert(gamma.end(), gamma_more.begin(), gamma_more.end());
 			h.insert(h.end(), h_more.begin(), h_more.end());
-			for (real r = prev_n_B2r_more; r <= n_B2r_more - real::ONE; r = r + real::ONE)
+			for (real r = prev_n_B2r_more; r <= n_B2r_more - 1; r += 1)
 			{
 				p.push_back(real::ZERO);
 				e.push_back(real::ZERO);
 			}
-			for (real r = prev_n_B2r_more; r <= n_B2r_more - real::ONE; r = r + real::ONE)
+			for (real r = prev_n_B2r_more; r <= n_B2r_more - 1; r += 1)
 			{
-				p[gzbi(r)] = alpha[gzbi(r)] / (beta[gzbi(r)] - gamma[gzbi(r)] * p[gzbi(r - real::ONE)]);
-				e[gzbi(r)] = (h[gzbi(r)] - gamma[gzbi(r)] * e[gzbi(r - real::ONE)]) / (beta[gzbi(r)] - gamma[gzbi(r)] * p[gzbi(r - real::ONE)]);
+				p[gzbi(r)] = alpha[gzbi(r)] / (beta[gzbi(r)] - gamma[gzbi(r)] * p[gzbi(r - 1)]);
+				e[gzbi(r)] = (h[gzbi(r)] - gamma[gzbi(r)] * e[gzbi(r - 1)]) / (beta[gzbi(r)] - gamma[gzbi(r)] * p[gzbi(r - 1)]);
 			}
-			for (real r = prev_n_B2r_more; r <= n_B2r_more - real::ONE; r = r + real::ONE)
+			for (real r = prev_n_B2r_more; r <= n_B2r_more - 1; r += 1)
 			{
 				B2r.push_back(real::ZERO);
 			}
 		}
 		else
 		{
-			for (real r = real::ZERO; r <= n_B2r - real::ONE; r = r + real::ONE)
+			for (real r = real::ZERO; r <= n_B2r - 1; r += 1)
 			{
 				p.push_back(real::ZERO);
 				e.push_back(real::ZERO);
 			}
-			p[gzbi(r0 + real::ONE)] = alpha[gzbi(r0 + real::ONE)] / beta[gzbi(r0 + real::ONE)];
-			e[gzbi(r0 + real::ONE)] = (h[gzbi(r0 + real::ONE)] - gamma[gzbi(r0 + real::ONE)] * B0) / beta[gzbi(r0 + real::ONE)];
-			for (real r = r0 + real::TWO; r <= n_B2r - real::ONE; r = r + real::ONE)
+			p[gzbi(r0 + 1)] = alpha[gzbi(r0 + 1)] / beta[gzbi(r0 + 1)];
+			e[gzbi(r0 + 1)] = (h[gzbi(r0 + 1)] - gamma[gzbi(r0 + 1)] * B0) / beta[gzbi(r0 + 1)];
+			for (real r = r0 + 2; r <= n_B2r - 1; r += 1)
 			{
-				p[gzbi(r)] = alpha[gzbi(r)] / (beta[gzbi(r)] - gamma[gzbi(r)] * p[gzbi(r - real::ONE)]);
-				e[gzbi(r)] = (h[gzbi(r)] - gamma[gzbi(r)] * e[gzbi(r - real::ONE)]) / (beta[gzbi(r)] - gamma[gzbi(r)] * p[gzbi(r - real::ONE)]);
+				p[gzbi(r)] = alpha[gzbi(r)] / (beta[gzbi(r)] - gamma[gzbi(r)] * p[gzbi(r - 1)]);
+				e[gzbi(r)] = (h[gzbi(r)] - gamma[gzbi(r)] * e[gzbi(r - 1)]) / (beta[gzbi(r)] - gamma[gzbi(r)] * p[gzbi(r - 1)]);
 			}
 			B2r.clear();
 			prev_B2r.clear();
-			for (real r = real::ZERO; r <= n_B2r - real::ONE; r = r + real::ONE)
+			for (real r = real::ZERO; r <= n_B2r - 1; r += 1)
 			{
 				B2r.push_back(real::ZERO);
 				prev_B2r.push_back(real::ZERO);
 			}
 		}
-		B2r[gzbi(n_B2r_more - real::ONE)] = e[gzbi(n_B2r_more - real::ONE)];
-		for (real r = n_B2r_more - real::TWO; r >= r0 + real::ONE; r = r - real::ONE)
+		B2r[gzbi(n_B2r_more - 1)] = e[gzbi(n_B2r_more - 1)];
+		for (real r = n_B2r_more - 2; r >= r0 + 1; r -= 1)
 		{
-			B2r[gzbi(r)] = e[gzbi(r)] - p[gzbi(r)] * B2r[gzbi(r + real::ONE)];
+			B2r[gzbi(r)] = e[gzbi(r)] - p[gzbi(r)] * B2r[gzbi(r + 1)];
 		}
 		B2r[gzbi(r0)] = B0;
 		if (n_B2r_more > n_B2r)
 		{
 			max_abs_change = real::ZERO;
-			for (real r = r0; r <= n_B2r - real::ONE; r = r + real::ONE)
+			for (real r = r0; r <= n_B2r - 1; r += 1)
 			{
 				max_abs_change = max(max_abs_change, abs((B2r[gzbi(r)] - prev_B2r[gzbi(r)]) / prev_B2r[gzbi(r)]));
 			}
@@ -405,6 +420,7 @@ static void calculate_B2rmn_backward(std::vector<real> & B2r, bool verbose, cons
 	B2r.erase(B2r.begin() + gzbi(n_B2r), B2r.end());
 }
 
+template <class real>
 static void calculate_B2rmn_once(std::vector<real> & B2r, bool verbose, const real & c, const real & m, const real & n, const real & lambda, real & n_dr, std::vector<real> & dr, const real & k1, real & n_c2k, std::vector<real> & c2k, const real & Q, std::vector<real> & h_saved, const real & n_B2r)
 {
 	std::vector<real> alpha;
@@ -416,27 +432,28 @@ static void calculate_B2rmn_once(std::vector<real> & B2r, bool verbose, const re
 	std::vector<real> B2r_backward;
 	
 	B2r.clear();
-	for (real r = real::ZERO; r <= n_B2r - real::ONE; r = r + real::ONE)
+	for (real r = real::ZERO; r <= n_B2r - 1; r += 1)
 	{
 		B2r.push_back(real::ZERO);
 	}
 	calculate_B2rmn_forward(alpha, beta, gamma, h, B2r_forward, verbose, c, m, n, lambda, n_dr, dr, k1, n_c2k, c2k, Q, h_saved, n_B2r);
 	max_r = -real::ONE;
-	for (real r = real::ZERO; r <= n_B2r - real::ONE; r = r + real::ONE)
+	for (real r = real::ZERO; r <= n_B2r - 1; r += 1)
 	{
 		if (max_r == -real::ONE || abs(B2r_forward[gzbi(r)]) > abs(B2r_forward[gzbi(max_r)]))
 		{
 			max_r = r;
 		}
 	}
-	std::copy(B2r_forward.begin(), B2r_forward.begin() + gzbi(max_r + real::ONE), B2r.begin());
+	std::copy(B2r_forward.begin(), B2r_forward.begin() + gzbi(max_r + 1), B2r.begin());
 	if (max_r < n_B2r - 1)
 	{
 		calculate_B2rmn_backward(B2r_backward, verbose, c, m, n, lambda, n_dr, dr, k1, n_c2k, c2k, Q, h_saved, n_B2r, alpha, beta, gamma, h, max_r, B2r[gzbi(max_r)]);
-		std::copy(B2r_backward.begin() + gzbi(max_r + real::ONE), B2r_backward.end(), B2r.begin() + gzbi(max_r + real::ONE));
+		std::copy(B2r_backward.begin() + gzbi(max_r + 1), B2r_backward.end(), B2r.begin() + gzbi(max_r + 1));
 	}
 }
 
+template <class real>
 void calculate_B2rmn(std::vector<real> & B2r, bool verbose, const real & c, const real & m, const real & n, const real & lambda, real & n_dr, std::vector<real> & dr, const real & k1, real & n_c2k, std::vector<real> & c2k, const real & Q, real & n_B2r, const real & B2r_min)
 {
 	real n_B2r_orig;
@@ -445,22 +462,22 @@ void calculate_B2rmn(std::vector<real> & B2r, bool verbose, const real & c, cons
 	
 	n_B2r_orig = n_B2r;
 	h_saved.clear();
-	for ( ; ; n_B2r = real::TWO * n_B2r)
+	for ( ; ; n_B2r *= 2)
 	{
 		calculate_B2rmn_once(B2r, verbose, c, m, n, lambda, n_dr, dr, k1, n_c2k, c2k, Q, h_saved, n_B2r);
-		if (B2r_min == real::ZERO || abs(B2r[gzbi(n_B2r - real::ONE)]) < B2r_min)
+		if (B2r_min == real::ZERO || abs(B2r[gzbi(n_B2r - 1)]) < B2r_min)
 		{
 			break;
 		}
 	}
 	if (B2r_min > real::ZERO)
 	{
-		for (real r = n_B2r - real::ONE; r >= real::ZERO; r = r - real::ONE)
+		for (real r = n_B2r - 1; r >= real::ZERO; r -= 1)
 		{
 			if (abs(B2r[gzbi(r)]) >= B2r_min)
 			{
-				remove_where = r + real::TWO;
-				if (remove_where >= n_B2r_orig && remove_where <= n_B2r - real::ONE)
+				remove_where = r + 2;
+				if (remove_where >= n_B2r_orig && remove_where <= n_B2r - 1)
 				{
 					B2r.erase(B2r.begin() + gzbi(remove_where), B2r.end());
 					n_B2r = real((int)B2r.size());
@@ -471,46 +488,50 @@ void calculate_B2rmn(std::vector<real> & B2r, bool verbose, const real & c, cons
 	}
 }
 
+template <class real>
 void calculate_Rmn1_1(real & R1, real & R1p, bool verbose, const real & c, const real & m, const real & n, const real & n_dr, const std::vector<real> & dr, const real & F, const real & xi)
 {
 	calculate_Rmn1_1_shared(R1, R1p, verbose, c, m, n, n_dr, dr, xi);
 	if (m > real::ZERO)
 	{
-		R1p = pow(F, -real::ONE) * (m / real::TWO) * pow(real::ONE + real::ONE / (xi * xi), m / real::TWO - real::ONE) * (-real::TWO / (xi * xi * xi)) * R1 + pow(F, -real::ONE) * pow(real::ONE + real::ONE / (xi * xi), m / real::TWO) * R1p;
-		R1 = pow(F, -real::ONE) * pow(real::ONE + real::ONE / (xi * xi), m / real::TWO) * R1;
+		R1p = reciprocal(F) * (m / 2) * pow(real::ONE + real::ONE / (xi * xi), m / real::TWO - real::ONE) * (-2 / (xi * xi * xi)) * R1 + reciprocal(F) * pow(real::ONE + real::ONE / (xi * xi), m / 2) * R1p;
+		R1 = reciprocal(F) * pow(real::ONE + real::ONE / (xi * xi), m / 2) * R1;
 	}
 	else
 	{
-		R1p = pow(F, -real::ONE) * R1p;
-		R1 = pow(F, -real::ONE) * R1;
+		R1p *= reciprocal(F);
+		R1 *= reciprocal(F);
 	}
 }
 
+template <class real>
 void calculate_Rmn1_2(real & R1, real & R1p, bool verbose, const real & c, const real & m, const real & n, const real & k1, const real & n_c2k, const std::vector<real> & c2k, const real & xi)
 {
-	adder R1_adder;
+	adder<real> R1_adder;
+	accelerator<real> R1_accelerator;
 	real a;
 	real change;
-	adder R1p_adder;
+	adder<real> R1p_adder;
+	accelerator<real> R1p_accelerator;
 	real ap;
 	real changep;
 	
 	R1 = real::ZERO;
 	R1_adder.clear();
-	for (real k = real::ZERO; k <= n_c2k - real::ONE; k = k + real::ONE)
+	for (real k = real::ZERO; k <= n_c2k - 1; k += 1)
 	{
 		if (k > real::ZERO)
 		{
-			a = a * (xi * xi + real::ONE);
+			a *= xi * xi + 1;
 		}
 		else
 		{
 			a = real::ONE;
 		}
 		change = c2k[gzbi(k)] * a;
-		R1 = R1 + change;
+		R1 += change;
 		R1_adder.add(change);
-		if (k > real::ZERO && abs(change) > real::ZERO && abs(change / R1) < real::SMALL_ENOUGH)
+		if (k > real::ZERO && is_negligible(change, R1))
 		{
 			if (verbose)
 			{
@@ -518,24 +539,37 @@ void calculate_Rmn1_2(real & R1, real & R1p, bool verbose, const real & c, const
 			}
 			break;
 		}
+		R1_accelerator.add(R1);
+		if (R1_accelerator.has_converged())
+		{
+			break;
+		}
+	}
+	R1_accelerator.report(verbose, "calculate_Rmn1_2", 0);
+	if (R1_accelerator.has_converged())
+	{
+		R1 = R1_accelerator.get_value();
+	}
+	else
+	{
+		R1 = R1_adder.calculate_sum();
 	}
-	R1 = R1_adder.calculate_sum();
 	R1p = real::ZERO;
 	R1p_adder.clear();
-	for (real k = real::ONE; k <= n_c2k - real::ONE; k = k + real::ONE)
+	for (real k = real::ONE; k <= n_c2k - 1; k += 1)
 	{
 		if (k > real::ONE)
 		{
-			ap = ap * (xi * xi + real::ONE);
+			ap *= xi * xi + 1;
 		}
 		else
 		{
 			ap = real::ONE;
 		}
-		changep = c2k[gzbi(k)] * k * ap * real::TWO * xi;
-		R1p = R1p + changep;
+		changep = c2k[gzbi(k)] * k * ap * 2 * xi;
+		R1p += changep;
 		R1p_adder.add(changep);
-		if (k > real::ONE && abs(changep) > real::ZERO && abs(changep / R1p) < real::SMALL_ENOUGH)
+		if (k > real::ONE && is_negligible(changep, R1p))
 		{
 			if (verbose)
 			{
@@ -543,83 +577,76 @@ void calculate_Rmn1_2(real & R1, real & R1p, bool verbose, const real & c, const
 			}
 			break;
 		}
+		R1p_accelerator.add(R1p);
+		if (R1p_accelerator.has_converged())
+		{
+			break;
+		}
 	}
-	R1p = R1p_adder.calculate_sum();
-	if (remainder(n - m, real::TWO) == real::ZERO)
+	R1p_accelerator.report(verbose, "calculate_Rmn1_2", 0);
+	if (R1p_accelerator.has_converged())
 	{
-		R1p = pow(k1, -real::ONE) * (m / real::TWO) * pow(xi * xi + real::ONE, m / real::TWO - real::ONE) * real::TWO * xi * R1 + pow(k1, -real::ONE) * pow(xi * xi + real::ONE, m / real::TWO) * R1p;
-		R1 = pow(k1, -real::ONE) * pow(xi * xi + real::ONE, m / real::TWO) * R1;
+		R1p = R1p_accelerator.get_value();
 	}
 	else
 	{
-		R1p = pow(k1, -real::ONE) * pow(xi * xi + real::ONE, m / real::TWO) * R1 + pow(k1, -real::ONE) * xi * (m / real::TWO) * pow(xi * xi + real::ONE, m / real::TWO - real::ONE) * real::TWO * xi * R1 + pow(k1, -real::ONE) * xi * pow(xi * xi + real::ONE, m / real::TWO) * R1p;
-		R1 = pow(k1, -real::ONE) * xi * pow(xi * xi + real::ONE, m / real::TWO) * R1;
+		R1p = R1p_adder.calculate_sum();
 	}
-}
-
-void calculate_Rmn2_1(real & R2, real & R2p, bool verbose, const real & c, const real & m, const real & n, const real & n_dr, const std::vector<real> & dr, const real & F, const real & xi)
-{
-	calculate_Rmn2_1_shared(R2, R2p, verbose, c, m, n, n_dr, dr, xi);
-	if (m > real::ZERO)
+	if (remainder(n - m, real::TWO) == real::ZERO)
 	{
-		R2p = pow(F, -real::ONE) * (m / real::TWO) * pow(real::ONE + real::ONE / (xi * xi), m / real::TWO - real::ONE) * (-real::TWO / (xi * xi * xi)) * R2 + pow(F, -real::ONE) * pow(real::ONE + real::ONE / (xi * xi), m / real::TWO) * R2p;
-		R2 = pow(F, -real::ONE) * pow(real::ONE + real::ONE / (xi * xi), m / real::TWO) * R2;
+		R1p = reciprocal(k1) * (m / 2) * pow(xi * xi + 1, m / real::TWO - real::ONE) * 2 * xi * R1 + reciprocal(k1) * pow(xi * xi + 1, m / 2) * R1p;
+		R1 = reciprocal(k1) * pow(xi * xi + 1, m / 2) * R1;
 	}
 	else
 	{
-		R2p = pow(F, -real::ONE) * R2p;
-		R2 = pow(F, -real::ONE) * R2;
+		R1p = reciprocal(k1) * pow(xi * xi + 1, m / 2) * R1 + reciprocal(k1) * xi * (m / 2) * pow(xi * xi + 1, m / real::TWO - real::ONE) * 2 * xi * R1 + reciprocal(k1) * xi * pow(xi * xi + 1, m / 2) * R1p;
+		R1 = reciprocal(k1) * xi * pow(xi * xi + 1, m / 2) * R1;
 	}
 }
 
-static complex calculate_continued_fraction(const complex & b0, const std::vector<complex> & a, const std::vector<complex> & b)
+template <class real>
+void calculate_Rmn2_1(real & R2, real & R2p, bool verbose, const real & c, const real & m, const real & n, const real & n_dr, const std::vector<real> & dr, const real & F, const real & xi)
 {
-	complex x;
-	
-	x = real::ZERO;
-	if ((int)a.size() < (int)b.size())
+	calculate_Rmn2_1_shared(R2, R2p, verbose, c, m, n, n_dr, dr, xi);
+	if (m > real::ZERO)
 	{
-		for (int i = (int)a.size() - 1; i >= 0; --i)
-		{
-			x = a[i] / (b[i] - x);
-		}
+		R2p = reciprocal(F) * (m / 2) * pow(real::ONE + real::ONE / (xi * xi), m / real::TWO - real::ONE) * (-2 / (xi * xi * xi)) * R2 + reciprocal(F) * pow(real::ONE + real::ONE / (xi * xi), m / 2) * R2p;
+		R2 = reciprocal(F) * pow(real::ONE + real::ONE / (xi * xi), m / 2) * R2;
 	}
 	else
 	{
-		for (int i = (int)b.size() - 1; i >= 0; --i)
-		{
-			x = a[i] / (b[i] - x);
-		}
+		R2p *= reciprocal(F);
+		R2 *= reciprocal(F);
 	}
-	x = b0 - x;
-	return x;
 }
 
-static void calculate_Q(std::vector<complex> & Q, bool verbose, const real & m0, const real & n1, const real & xi)
+template <class real>
+static void calculate_Q(std::vector<complex<real> > & Q, bool verbose, const real & m0, const real & n1, const real & xi)
 {
-	complex x;
-	complex Q0;
-	complex Q1;
-	complex Q2;
-	complex b0;
-	std::vector<complex> a;
-	std::vector<complex> b;
-	complex prev_N;
-	complex N;
+	complex<real> x;
+	complex<real> Q0;
+	complex<real> Q1;
+	complex<real> Q2;
+	minimal_solution<real, complex<real> > Q_solution;
+	real s;
 	
-	x = complex::I * xi;
+	// x is imaginary, so x^2 - 1 = -(xi^2 + 1) is real and negative, and
+	// (x^2 - 1)^(1 / 2) = I * s on the principal branch.
+	x = complex<real>(real::ZERO, xi);
+	s = sqrt(xi * xi + real::ONE);
 	Q.clear();
-	for (real n = real::ZERO; n <= n1; n = n + real::ONE)
+	for (real n = real::ZERO; n <= n1; n += 1)
 	{
 		Q.push_back(real::ZERO);
 	}
 	Q0 = (real::ONE / real::TWO) * log((x + real::ONE) / (x - real::ONE));
-	Q1 = -pow(x * x - real::ONE, -real::ONE / real::TWO);
+	Q1 = complex<real>(real::ZERO, real::ONE / s);
 	if (m0 > real::ONE)
 	{
-		for (real m = real::TWO; m <= m0; m = m + real::ONE)
+		for (real m = real::TWO; m <= m0; m += 1)
 		{
-			Q2 = (m - real::ONE) * (-m + real::TWO) * Q0 - ((real::TWO * (m - real::ONE)) / pow(x * x - real::ONE, real::ONE / real::TWO)) * x * Q1;
+			Q2 = (m - 1) * (-m + 2) * Q0;
+			Q2.add_product(-(2 * (m - 1)) * xi / s, Q1);
 			Q0 = Q1;
 			Q1 = Q2;
 		}
@@ -633,121 +660,101 @@ static void calculate_Q(std::vector<complex> & Q, bool verbose, const real & m0,
 	{
 		Q[gzbi(real::ZERO)] = Q0;
 	}
-	for (real n = n1; n >= real::ONE; n = n - real::ONE)
+	Q_solution.calculate_ratios(verbose, "calculate_Q", [&](complex<real> & a_n, complex<real> & b_n, complex<real> & c_n, const real & n)
 	{
-		if (n < n1)
-		{
-			N = (n + m0) / ((real::TWO * n + real::ONE) * x - (n - m0 + real::ONE) * N);
-		}
-		else
-		{
-			b0 = real::ZERO;
-			a.clear();
-			a.push_back(real::ONE);
-			b.clear();
-			prev_N = real::NAN;
-			for (real i = n; i <= n + real("8388608.0"); i = i + real::ONE)
-			{
-				if (remainder(i - n, real("10000.0")) == real::ZERO)
-				{
-					if (verbose)
-					{
-						std::cout << "calculate_Q: " << (i - n).get_int() << std::endl;
-					}
-				}
-				a.back() = a.back() * (i + m0);
-				b.push_back((real::TWO * i + real::ONE) * x);
-				a.push_back(i - m0 + real::ONE);
-				if (i > n && pow(real::TWO, round(log(i - n) / log(real::TWO))) == i - n)
-				{
-					N = -calculate_continued_fraction(b0, a, b);
-					if (prev_N.a == prev_N.a)
-					{
-						if (verbose)
-						{
-							std::cout << "calculate_Q: " << (i - n).get_int() << ": " << ((N - prev_N) / prev_N).get_string(10) << std::endl;
-						}
-						if (abs((N - prev_N) / prev_N) < real::SMALL_ENOUGH)
-						{
-							break;
-						}
-					}
-					prev_N = N;
-				}
-			}
-		}
-		Q[gzbi(n)] = N;
-	}
-	for (real n = real::ONE; n <= n1; n = n + real::ONE)
+		a_n = n + m0;
+		b_n = complex<real>(real::ZERO, (2 * n + 1) * xi);
+		c_n = n - m0 + 1;
+	}, real::ZERO, n1, real::ONE, real(8388609), minimal_solution<real, complex<real> >::POWERS_OF_TWO);
+	Q_solution.calculate_forward(Q);
+	if (verbose)
 	{
-		Q[gzbi(n)] = Q[gzbi(n)] * Q[gzbi(n - real::ONE)];
+		Q_solution.print_times("calculate_Q");
 	}
 }
 
+template <class real>
 void calculate_Rmn2_2(real & R2, real & R2p, bool verbose, const real & c, const real & m, const real & n, const real & n_dr, const std::vector<real> & dr, const real & n_dr_neg, const std::vector<real> & dr_neg, const real & k2, const real & xi)
 {
-	complex x;
+	complex<real> x;
 	real v_max;
-	std::vector<complex> P;
-	std::vector<complex> Pp;
-	std::vector<complex> Q;
-	std::vector<complex> Qp;
-	complex Q1;
-	complex Q2;
-	complex R2_complex;
-	complex R2p_complex;
-	complex_adder R2_adder;
-	complex_adder R2p_adder;
-	complex change;
-	complex changep;
+	std::vector<complex<real> > P;
+	std::vector<complex<real> > Pp;
+	std::vector<complex<real> > Q;
+	std::vector<complex<real> > Qp;
+	complex<real> Q1;
+	complex<real> Q2;
+	complex<real> R2_complex;
+	complex<real> R2p_complex;
+	complex_adder<real> R2_adder;
+	complex_adder<real> R2p_adder;
+	complex<real> change;
+	complex<real> changep;
+	real s;
+	real x2m1;
 	
 	if (xi > real::ZERO)
 	{
-		x = complex::I * xi;
+		// As in calculate_Q, x is imaginary, x^2 - 1 = x2m1 is real, and
+		// (x^2 - 1)^(1 / 2) = I * s, so multiplying by any of them is just a
+		// real product (and maybe a multiplication by I).
+		x = complex<real>(real::ZERO, xi);
+		x2m1 = -(xi * xi) - real::ONE;
+		s = sqrt(xi * xi + real::ONE);
 		// The following code assumes there are at least m + 2 entries in P, so
 		// make sure there are.
-		v_max = max(m + real::ONE, n_dr_neg - m);
+		v_max = max(m + 1, n_dr_neg - m);
 		P.clear();
-		for (real v = real::ZERO; v <= v_max; v = v + real::ONE)
+		for (real v = real::ZERO; v <= v_max; v += 1)
 		{
 			P.push_back(real::ZERO);
 		}
 		P[gzbi(real::ZERO)] = real::ONE;
-		for (real v = real::ONE; v <= m; v = v + real::ONE)
+		for (real v = real::ONE; v <= m; v += 1)
 		{
-			P[gzbi(v)] = (real::TWO * v - real::ONE) * pow(x * x - real::ONE, real::ONE / real::TWO) * P[gzbi(v - real::ONE)];
-			P[gzbi(v - real::ONE)] = real::ZERO;
+			P[gzbi(v)] = ((2 * v - 1) * s * P[gzbi(v - 1)]).times_I();
+			P[gzbi(v - 1)] = real::ZERO;
 		}
-		P[gzbi(m + real::ONE)] = (real::TWO * m + real::ONE) * x * P[gzbi(m)];
-		for (real v = m + real::TWO; v <= v_max; v = v + real::ONE)
+		P[gzbi(m + 1)] = ((2 * m + 1) * xi * P[gzbi(m)]).times_I();
+		for (real v = m + 2; v <= v_max; v += 1)
 		{
-			P[gzbi(v)] = (real::ONE / (v - m)) * (-(v + m - real::ONE) * P[gzbi(v - real::TWO)] + (real::TWO * v - real::ONE) * x * P[gzbi(v - real::ONE)]);
+			P[gzbi(v)] = -(v + m - 1) * P[gzbi(v - 2)];
+			P[gzbi(v)].add_product((2 * v - 1) * xi, P[gzbi(v - 1)].times_I());
+			P[gzbi(v)] = P[gzbi(v)] / (v - m);
 		}
 		Pp.clear();
-		for (real v = real::ZERO; v <= v_max - real::ONE; v = v + real::ONE)
+		for (real v = real::ZERO; v <= v_max - 1; v += 1)
 		{
 			Pp.push_back(real::ZERO);
 		}
-		for (real v = m; v <= v_max - real::ONE; v = v + real::ONE)
+		for (real v = m; v <= v_max - 1; v += 1)
 		{
-			Pp[gzbi(v)] = (real::ONE / (x * x - real::ONE)) * (-(v + real::ONE) * x * P[gzbi(v)] + (v - m + real::ONE) * P[gzbi(v + real::ONE)]);
+			Pp[gzbi(v)] = (v - m + 1) * P[gzbi(v + 1)];
+			Pp[gzbi(v)].add_product(-(v + 1) * xi, P[gzbi(v)].times_I());
+			Pp[gzbi(v)] = Pp[gzbi(v)] / x2m1;
 		}
-		calculate_Q(Q, verbose, m, m + n_dr, xi);
+		calculate_Q<real>(Q, verbose, m, m + n_dr, xi);
 		Qp.clear();
-		for (real v = real::ZERO; v <= m + n_dr - real::ONE; v = v + real::ONE)
+		for (real v = real::ZERO; v <= m + n_dr - 1; v += 1)
 		{
 			Qp.push_back(real::ZERO);
 		}
-		for (real v = real::ZERO; v <= m + n_dr - real::ONE; v = v + real::ONE)
+		for (real v = real::ZERO; v <= m + n_dr - 1; v += 1)
 		{
-			Qp[gzbi(v)] = (real::ONE / (x * x - real::ONE)) * (-(v + 1) * x * Q[gzbi(v)] + (v - m + real::ONE) * Q[gzbi(v + real::ONE)]);
+			Qp[gzbi(v)] = (v - m + 1) * Q[gzbi(v + 1)];
+			Qp[gzbi(v)].add_product(-(v + 1) * xi, Q[gzbi(v)].times_I());
+			Qp[gzbi(v)] = Qp[gzbi(v)] / x2m1;
 		}
 		Q1 = Q[gzbi(real::ZERO)];
 		Q2 = Q[gzbi(real::ONE)];
-		for (real v = -real::ONE; v >= -m; v = v - real::ONE)
+		for (real v = -real::ONE; v >= -m; v -= 1)
 		{
-			P[gnobi(v)] = (real::ONE / (v + m + real::ONE)) * ((real::TWO * v + real::THREE) * x * Q1 - (v - m + real::TWO) * Q2);
-			Pp[gnobi(v)] = (real::ONE / (x * x - real::ONE)) * (-(v + real::ONE) * x * P[gnobi(v)] + (v - m + real::ONE) * Q1);
+			P[gnobi(v)] = -(v - m + 2) * Q2;
+			P[gnobi(v)].add_product((2 * v + 3) * xi, Q1.times_I());
+			P[gnobi(v)] = P[gnobi(v)] / (v + m + 1);
+			Pp[gnobi(v)] = (v - m + 1) * Q1;
+			Pp[gnobi(v)].add_product(-(v + 1) * xi, P[gnobi(v)].times_I());
+			Pp[gnobi(v)] = Pp[gnobi(v)] / x2m1;
 			Q2 = Q1;
 			Q1 = P[gnobi(v)];
 		}
@@ -756,76 +763,76 @@ void calculate_Rmn2_2(real & R2, real & R2p, bool verbose, const real & c, const
 	{
 		// For the code at the end of this else section to work properly, there
 		// need to be at least as many entries in P as there are in Q.
-		v_max = max(m + n_dr - real::ONE, n_dr_neg - m - real::ONE);
+		v_max = max(m + n_dr - 1, n_dr_neg - m - 1);
 		P.clear();
 		Pp.clear();
-		for (real v = real::ZERO; v <= v_max; v = v + real::ONE)
+		for (real v = real::ZERO; v <= v_max; v += 1)
 		{
 			P.push_back(real::ZERO);
 			Pp.push_back(real::ZERO);
 		}
-		for (real v = m; v <= v_max; v = v + real::ONE)
+		for (real v = m; v <= v_max; v += 1)
 		{
 			if (remainder(v - m, real::TWO) == real::ZERO)
 			{
-				P[gzbi(v)] = (pow(-real::ONE, (v - m) / real::TWO) * factorial(v + m)) / (pow(real::TWO, v) * factorial((v + m) / real::TWO) * factorial((v - m) / real::TWO));
+				P[gzbi(v)] = (sign_pow((v - m) / 2) * factorial(v + m)) / (pow(real::TWO, v) * factorial((v + m) / 2) * factorial((v - m) / 2));
 			}
 			else
 			{
-				Pp[gzbi(v)] = (pow(-real::ONE, (v - m - real::ONE) / real::TWO) * factorial(v + m + real::ONE)) / (pow(real::TWO, v) * factorial((v + m + real::ONE) / real::TWO) * factorial((v - m - real::ONE) / real::TWO));
+				Pp[gzbi(v)] = (sign_pow((v - m - 1) / 2) * factorial(v + m + 1)) / (pow(real::TWO, v) * factorial((v + m + 1) / 2) * factorial((v - m - 1) / 2));
 			}
 		}
 		Q.clear();
 		Qp.clear();
-		for (real v = real::ZERO; v <= m + n_dr - real::ONE; v = v + real::ONE)
+		for (real v = real::ZERO; v <= m + n_dr - 1; v += 1)
 		{
 			Q.push_back(real::ZERO);
 			Qp.push_back(real::ZERO);
 		}
-		for (real v = m; v <= m + n_dr - real::ONE; v = v + real::ONE)
+		for (real v = m; v <= m + n_dr - 1; v += 1)
 		{
 			if (remainder(v - m, real::TWO) == real::ZERO)
 			{
-				Qp[gzbi(v)] = (pow(-real::ONE, (v - m) / real::TWO) * pow(real::TWO, v - real::ONE) * factorial((v + m) / real::TWO) * factorial((v - m - real::TWO) / real::TWO)) / factorial(v - m - real::ONE);
+				Qp[gzbi(v)] = (sign_pow((v - m) / 2) * pow(real::TWO, v - 1) * factorial((v + m) / 2) * factorial((v - m - 2) / 2)) / factorial(v - m - 1);
 			}
 			else
 			{
-				Q[gzbi(v)] = (pow(-real::ONE, (v - m + real::ONE) / real::TWO) * pow(real::TWO, v - real::ONE) * factorial((v + m - real::ONE) / real::TWO) * factorial((v - m - real::ONE) / real::TWO)) / factorial(v - m);
+				Q[gzbi(v)] = (sign_pow((v - m + 1) / 2) * pow(real::TWO, v - 1) * factorial((v + m - 1) / 2) * factorial((v - m - 1) / 2)) / factorial(v - m);
 			}
 		}
-		for (real v = m - real::ONE; v >= real::ZERO; v = v - real::ONE)
+		for (real v = m - 1; v >= real::ZERO; v -= 1)
 		{
-			Q[gzbi(v)] = -((v - m + real::TWO) / (v + m + real::ONE)) * Q[gzbi(v + real::TWO)];
-			Qp[gzbi(v)] = -(v - m + real::ONE) * Q[gzbi(v + real::ONE)];
+			Q[gzbi(v)] = -((v - m + 2) / (v + m + 1)) * Q[gzbi(v + 2)];
+			Qp[gzbi(v)] = -(v - m + 1) * Q[gzbi(v + 1)];
 		}
 		Q1 = Q[gzbi(real::ZERO)];
 		Q2 = Q[gzbi(real::ONE)];
-		for (real v = -real::ONE; v >= -m; v = v - real::ONE)
+		for (real v = -real::ONE; v >= -m; v -= 1)
 		{
-			P[gnobi(v)] = -((v - m + real::TWO) / (v + m + real::ONE)) * Q2;
-			Pp[gnobi(v)] = -(v - m + real::ONE) * Q1;
+			P[gnobi(v)] = -((v - m + 2) / (v + m + 1)) * Q2;
+			Pp[gnobi(v)] = -(v - m + 1) * Q1;
 			Q2 = Q1;
 			Q1 = P[gnobi(v)];
 		}
-		for (real v = real::ZERO; v <= m - real::ONE; v = v + real::ONE)
+		for (real v = real::ZERO; v <= m - 1; v += 1)
 		{
-			Q[gzbi(v)] = pow(complex::I, m) * Q[gzbi(v)];
-			Qp[gzbi(v)] = pow(complex::I, m) * Qp[gzbi(v)];
+			Q[gzbi(v)] = Q[gzbi(v)].times_I(m);
+			Qp[gzbi(v)] = Qp[gzbi(v)].times_I(m);
 		}
-		for (real v = m; v <= m + n_dr - real::ONE; v = v + real::ONE)
+		for (real v = m; v <= m + n_dr - 1; v += 1)
 		{
-			Q[gzbi(v)] = pow(complex::I, m) * (Q[gzbi(v)] - (real::ONE / real::TWO) * real::PI * complex::I * P[gzbi(v)]);
-			Qp[gzbi(v)] = pow(complex::I, m) * (Qp[gzbi(v)] - (real::ONE / real::TWO) * real::PI * complex::I * Pp[gzbi(v)]);
+			Q[gzbi(v)] = (Q[gzbi(v)] - ((real::ONE / real::TWO) * real::PI * P[gzbi(v)]).times_I()).times_I(m);
+			Qp[gzbi(v)] = (Qp[gzbi(v)] - ((real::ONE / real::TWO) * real::PI * Pp[gzbi(v)]).times_I()).times_I(m);
 		}
-		for (real v = -real::ONE; v >= -m; v = v - real::ONE)
+		for (real v = -real::ONE; v >= -m; v -= 1)
 		{
-			P[gnobi(v)] = pow(complex::I, m) * P[gnobi(v)];
-			Pp[gnobi(v)] = pow(complex::I, m) * Pp[gnobi(v)];
+			P[gnobi(v)] = P[gnobi(v)].times_I(m);
+			Pp[gnobi(v)] = Pp[gnobi(v)].times_I(m);
 		}
-		for (real v = m; v <= v_max; v = v + real::ONE)
+		for (real v = m; v <= v_max; v += 1)
 		{
-			P[gzbi(v)] = pow(complex::I, m) * P[gzbi(v)];
-			Pp[gzbi(v)] = pow(complex::I, m) * Pp[gzbi(v)];
+			P[gzbi(v)] = P[gzbi(v)].times_I(m);
+			Pp[gzbi(v)] = Pp[gzbi(v)].times_I(m);
 		}
 	}
 	R2_complex = real::ZERO;
@@ -834,15 +841,15 @@ void calculate_Rmn2_2(real & R2, real & R2p, bool verbose, const real & c, const
 	R2p_adder.clear();
 	if (remainder(n - m, real::TWO) == real::ZERO)
 	{
-		for (real r = -real::TWO * m - real::TWO; r >= -n_dr_neg; r = r - real::TWO)
+		for (real r = -2 * m - 2; r >= -n_dr_neg; r -= 2)
 		{
-			change = dr_neg[gnobi(r)] * P[gzbi(-r - m - real::ONE)];
-			R2_complex = R2_complex + change;
+			change = dr_neg[gnobi(r)] * P[gzbi(-r - m - 1)];
+			R2_complex += change;
 			R2_adder.add(change);
-			changep = dr_neg[gnobi(r)] * Pp[gzbi(-r - m - real::ONE)] * complex::I;
-			R2p_complex = R2p_complex + changep;
+			changep = (dr_neg[gnobi(r)] * Pp[gzbi(-r - m - 1)]).times_I();
+			R2p_complex += changep;
 			R2p_adder.add(changep);
-			if (r < -real::TWO * m - real::TWO && abs(change) > real::ZERO && abs(change / R2_complex) < real::SMALL_ENOUGH && abs(changep) > real::ZERO && abs(changep / R2p_complex) < real::SMALL_ENOUGH)
+			if (r < -2 * m - 2 && is_negligible(change, R2_complex) && is_negligible(changep, R2p_complex))
 			{
 				if (verbose)
 				{
@@ -852,23 +859,23 @@ void calculate_Rmn2_2(real & R2, real & R2p, bool verbose, const real & c, const
 			}
 		}
 		// There is a max here because n_dr_neg may be smaller than m.
-		for (real r = -real::TWO; r >= max(-n_dr_neg, -real::TWO * m); r = r - real::TWO)
+		for (real r = -real::TWO; r >= max(-n_dr_neg, -2 * m); r -= 2)
 		{
 			if (m + r >= real::ZERO)
 			{
 				change = dr_neg[gnobi(r)] * Q[gzbi(m + r)];
-				changep = dr_neg[gnobi(r)] * Qp[gzbi(m + r)] * complex::I;
+				changep = (dr_neg[gnobi(r)] * Qp[gzbi(m + r)]).times_I();
 			}
 			else
 			{
 				change = dr_neg[gnobi(r)] * P[gnobi(m + r)];
-				changep = dr_neg[gnobi(r)] * Pp[gnobi(m + r)] * complex::I;
+				changep = (dr_neg[gnobi(r)] * Pp[gnobi(m + r)]).times_I();
 			}
-			R2_complex = R2_complex + change;
+			R2_complex += change;
 			R2_adder.add(change);
-			R2p_complex = R2p_complex + changep;
+			R2p_complex += changep;
 			R2p_adder.add(changep);
-			if (r < -real::TWO && abs(change) > real::ZERO && abs(change / R2_complex) < real::SMALL_ENOUGH && abs(changep) > real::ZERO && abs(changep / R2p_complex) < real::SMALL_ENOUGH)
+			if (r < -real::TWO && is_negligible(change, R2_complex) && is_negligible(changep, R2p_complex))
 			{
 				if (verbose)
 				{
@@ -877,15 +884,15 @@ void calculate_Rmn2_2(real & R2, real & R2p, bool verbose, const real & c, const
 				break;
 			}
 		}
-		for (real r = real::ZERO; r <= n_dr - real::TWO; r = r + real::TWO)
+		for (real r = real::ZERO; r <= n_dr - 2; r += 2)
 		{
 			change = dr[gzbi(r)] * Q[gzbi(m + r)];
-			R2_complex = R2_complex + change;
+			R2_complex += change;
 			R2_adder.add(change);
-			changep = dr[gzbi(r)] * Qp[gzbi(m + r)] * complex::I;
-			R2p_complex = R2p_complex + changep;
+			changep = (dr[gzbi(r)] * Qp[gzbi(m + r)]).times_I();
+			R2p_complex += changep;
 			R2p_adder.add(changep);
-			if (r > real::ZERO && abs(change) > real::ZERO && abs(change / R2_complex) < real::SMALL_ENOUGH && abs(changep) > real::ZERO && abs(changep / R2p_complex) < real::SMALL_ENOUGH)
+			if (r > real::ZERO && is_negligible(change, R2_complex) && is_negligible(changep, R2p_complex))
 			{
 				if (verbose)
 				{
@@ -896,20 +903,22 @@ void calculate_Rmn2_2(real & R2, real & R2p, bool verbose, const real & c, const
 		}
 		R2_complex = R2_adder.calculate_sum();
 		R2p_complex = R2p_adder.calculate_sum();
-		R2_complex = pow(k2 / pow(-complex::I, m - real::ONE), -real::ONE) * R2_complex;
-		R2p_complex = pow(k2 / pow(-complex::I, m - real::ONE), -real::ONE) * R2p_complex;
+		// Divide by k2 / (-I)^(m - 1), which is the same as multiplying by
+		// I^(1 - m) / k2.
+		R2_complex = R2_complex.times_I(1 - m) / k2;
+		R2p_complex = R2p_complex.times_I(1 - m) / k2;
 	}
 	else
 	{
-		for (real r = -real::TWO * m - real::ONE; r >= -n_dr_neg + real::ONE; r = r - real::TWO)
+		for (real r = -2 * m - 1; r >= -n_dr_neg + 1; r -= 2)
 		{
-			change = dr_neg[gnobi(r)] * P[gzbi(-r - m - real::ONE)];
-			R2_complex = R2_complex + change;
+			change = dr_neg[gnobi(r)] * P[gzbi(-r - m - 1)];
+			R2_complex += change;
 			R2_adder.add(change);
-			changep = dr_neg[gnobi(r)] * Pp[gzbi(-r - m - real::ONE)] * complex::I;
-			R2p_complex = R2p_complex + changep;
+			changep = (dr_neg[gnobi(r)] * Pp[gzbi(-r - m - 1)]).times_I();
+			R2p_complex += changep;
 			R2p_adder.add(changep);
-			if (r < -real::TWO * m - real::ONE && abs(change) > real::ZERO && abs(change / R2_complex) < real::SMALL_ENOUGH && abs(changep) > real::ZERO && abs(changep / R2p_complex) < real::SMALL_ENOUGH)
+			if (r < -2 * m - 1 && is_negligible(change, R2_complex) && is_negligible(changep, R2p_complex))
 			{
 				if (verbose)
 				{
@@ -919,23 +928,23 @@ void calculate_Rmn2_2(real & R2, real & R2p, bool verbose, const real & c, const
 			}
 		}
 		// See the corresponding comment when n - m = even.
-		for (real r = -real::ONE; r >= max(-n_dr_neg + real::ONE, -real::TWO * m + real::ONE); r = r - real::TWO)
+		for (real r = -real::ONE; r >= max(-n_dr_neg + 1, -2 * m + 1); r -= 2)
 		{
 			if (m + r >= real::ZERO)
 			{
 				change = dr_neg[gnobi(r)] * Q[gzbi(m + r)];
-				changep = dr_neg[gnobi(r)] * Qp[gzbi(m + r)] * complex::I;
+				changep = (dr_neg[gnobi(r)] * Qp[gzbi(m + r)]).times_I();
 			}
 			else
 			{
 				change = dr_neg[gnobi(r)] * P[gnobi(m + r)];
-				changep = dr_neg[gnobi(r)] * Pp[gnobi(m + r)] * complex::I;
+				changep = (dr_neg[gnobi(r)] * Pp[gnobi(m + r)]).times_I();
 			}
-			R2_complex = R2_complex + change;
+			R2_complex += change;
 			R2_adder.add(change);
-			R2p_complex = R2p_complex + changep;
+			R2p_complex += changep;
 			R2p_adder.add(changep);
-			if (r < -real::ONE && abs(change) > real::ZERO && abs(change / R2_complex) < real::SMALL_ENOUGH && abs(changep) > real::ZERO && abs(changep / R2p_complex) < real::SMALL_ENOUGH)
+			if (r < -real::ONE && is_negligible(change, R2_complex) && is_negligible(changep, R2p_complex))
 			{
 				if (verbose)
 				{
@@ -944,15 +953,15 @@ void calculate_Rmn2_2(real & R2, real & R2p, bool verbose, const real & c, const
 				break;
 			}
 		}
-		for (real r = real::ONE; r <= n_dr - real::ONE; r = r + real::TWO)
+		for (real r = real::ONE; r <= n_dr - 1; r += 2)
 		{
 			change = dr[gzbi(r)] * Q[gzbi(m + r)];
-			R2_complex = R2_complex + change;
+			R2_complex += change;
 			R2_adder.add(change);
-			changep = dr[gzbi(r)] * Qp[gzbi(m + r)] * complex::I;
-			R2p_complex = R2p_complex + changep;
+			changep = (dr[gzbi(r)] * Qp[gzbi(m + r)]).times_I();
+			R2p_complex += changep;
 			R2p_adder.add(changep);
-			if (r > real::ONE && abs(change) > real::ZERO && abs(change / R2_complex) < real::SMALL_ENOUGH && abs(changep) > real::ZERO && abs(changep / R2p_complex) < real::SMALL_ENOUGH)
+			if (r > real::ONE && is_negligible(change, R2_complex) && is_negligible(changep, R2p_complex))
 			{
 				if (verbose)
 				{
@@ -963,25 +972,30 @@ void calculate_Rmn2_2(real & R2, real & R2p, bool verbose, const real & c, const
 		}
 		R2_complex = R2_adder.calculate_sum();
 		R2p_complex = R2p_adder.calculate_sum();
-		R2_complex = pow(k2 / pow(-complex::I, m - real::TWO), -real::ONE) * R2_complex;
-		R2p_complex = pow(k2 / pow(-complex::I, m - real::TWO), -real::ONE) * R2p_complex;
+		// Divide by k2 / (-I)^(m - 2), which is the same as multiplying by
+		// I^(2 - m) / k2.
+		R2_complex = R2_complex.times_I(2 - m) / k2;
+		R2p_complex = R2p_complex.times_I(2 - m) / k2;
 	}
 	R2 = R2_complex.a;
 	R2p = R2p_complex.a;
 }
 
+template <class real>
 void calculate_Rmn2_3(real & R2, real & R2p, bool verbose, const real & c, const real & m, const real & n, const real & Q, const real & n_B2r, const std::vector<real> & B2r, const real & xi, const real & R1, const real & R1p)
 {
-	adder R2_adder;
+	adder<real> R2_adder;
+	accelerator<real> R2_accelerator;
 	real a;
 	real change;
-	adder R2p_adder;
+	adder<real> R2p_adder;
+	accelerator<real> R2p_accelerator;
 	real ap;
 	real changep;
 	
 	R2 = real::ZERO;
 	R2_adder.clear();
-	for (real r = real::ZERO; r <= n_B2r - real::ONE; r = r + real::ONE)
+	for (real r = real::ZERO; r <= n_B2r - 1; r += 1)
 	{
 		if (r > real::ZERO)
 		{
@@ -992,9 +1006,9 @@ void calculate_Rmn2_3(real & R2, real & R2p, bool verbose, const real & c, const
 			a = real::ONE;
 		}
 		change = B2r[gzbi(r)] * a;
-		R2 = R2 + change;
+		R2 += change;
 		R2_adder.add(change);
-		if (r > real::ZERO && abs(change) > real::ZERO && abs(change / R2) < real::SMALL_ENOUGH)
+		if (r > real::ZERO && is_negligible(change, R2))
 		{
 			if (verbose)
 			{
@@ -1002,11 +1016,24 @@ void calculate_Rmn2_3(real & R2, real & R2p, bool verbose, const real & c, const
 			}
 			break;
 		}
+		R2_accelerator.add(R2);
+		if (R2_accelerator.has_converged())
+		{
+			break;
+		}
+	}
+	R2_accelerator.report(verbose, "calculate_Rmn2_3", 0);
+	if (R2_accelerator.has_converged())
+	{
+		R2 = R2_accelerator.get_value();
+	}
+	else
+	{
+		R2 = R2_adder.calculate_sum();
 	}
-	R2 = R2_adder.calculate_sum();
 	R2p = real::ZERO;
 	R2p_adder.clear();
-	for (real r = real::ONE; r <= n_B2r - real::ONE; r = r + real::ONE)
+	for (real r = real::ONE; r <= n_B2r - 1; r += 1)
 	{
 		if (r > real::ONE)
 		{
@@ -1016,10 +1043,10 @@ void calculate_Rmn2_3(real & R2, real & R2p, bool verbose, const real & c, const
 		{
 			ap = xi;
 		}
-		changep = B2r[gzbi(r)] * real::TWO * r * ap;
-		R2p = R2p + changep;
+		changep = B2r[gzbi(r)] * 2 * r * ap;
+		R2p += changep;
 		R2p_adder.add(changep);
-		if (r > real::ONE && abs(changep) > real::ZERO && abs(changep / R2p) < real::SMALL_ENOUGH)
+		if (r > real::ONE && is_negligible(changep, R2p))
 		{
 			if (verbose)
 			{
@@ -1027,18 +1054,43 @@ void calculate_Rmn2_3(real & R2, real & R2p, bool verbose, const real & c, const
 			}
 			break;
 		}
+		R2p_accelerator.add(R2p);
+		if (R2p_accelerator.has_converged())
+		{
+			break;
+		}
+	}
+	R2p_accelerator.report(verbose, "calculate_Rmn2_3", 0);
+	if (R2p_accelerator.has_converged())
+	{
+		R2p = R2p_accelerator.get_value();
+	}
+	else
+	{
+		R2p = R2p_adder.calculate_sum();
 	}
-	R2p = R2p_adder.calculate_sum();
 	if (remainder(n - m, real::TWO) == real::ZERO)
 	{
-		R2p = pow(xi * xi + real::ONE, -m / real::TWO) * R2 + xi * (-m / real::TWO) * pow(xi * xi + real::ONE, -m / real::TWO - real::ONE) * real::TWO * xi * R2 + xi * pow(xi * xi + real::ONE, -m / real::TWO) * R2p;
-		R2 = xi * pow(xi * xi + real::ONE, -m / real::TWO) * R2;
+		R2p = pow(xi * xi + 1, -m / 2) * R2 + xi * (-m / 2) * pow(xi * xi + 1, -m / real::TWO - real::ONE) * 2 * xi * R2 + xi * pow(xi * xi + 1, -m / 2) * R2p;
+		R2 = xi * pow(xi * xi + 1, -m / 2) * R2;
 	}
 	else
 	{
-		R2p = (-m / real::TWO) * pow(xi * xi + real::ONE, -m / real::TWO - real::ONE) * real::TWO * xi * R2 + pow(xi * xi + real::ONE, -m / real::TWO) * R2p;
-		R2 = pow(xi * xi + real::ONE, -m / real::TWO) * R2;
+		R2p = (-m / 2) * pow(xi * xi + 1, -m / real::TWO - real::ONE) * 2 * xi * R2 + pow(xi * xi + 1, -m / 2) * R2p;
+		R2 *= pow(xi * xi + 1, -m / 2);
 	}
-	R2 = Q * R1 * (atan(xi) - real::PI / real::TWO) + R2;
-	R2p = Q * R1p * (atan(xi) - real::PI / real::TWO) + Q * R1 * (real::ONE / (xi * xi + real::ONE)) + R2p;
+	R2 = Q * R1 * (atan(xi) - real::PI / 2) + R2;
+	R2p = Q * R1p * (atan(xi) - real::PI / 2) + Q * R1 * (1 / (xi * xi + 1)) + R2p;
 }
+
+#define INSTANTIATE_OBL_SPHEROIDAL(real) \
+	template real calculate_c_squared<real>(const real & c); \
+	template real calculate_Qmn<real>(bool verbose, const real & c, const real & m, const real & n, const real & lambda, real & n_dr, std::vector<real> & dr, const real & k1, real & n_c2k, std::vector<real> & c2k); \
+	template void calculate_B2rmn<real>(std::vector<real> & B2r, bool verbose, const real & c, const real & m, const real & n, const real & lambda, real & n_dr, std::vector<real> & dr, const real & k1, real & n_c2k, std::vector<real> & c2k, const real & Q, real & n_B2r, const real & B2r_min); \
+	template void calculate_Rmn1_1<real>(real & R1, real & R1p, bool verbose, const real & c, const real & m, const real & n, const real & n_dr, const std::vector<real> & dr, const real & F, const real & xi); \
+	template void calculate_Rmn1_2<real>(real & R1, real & R1p, bool verbose, const real & c, const real & m, const real & n, const real & k1, const real & n_c2k, const std::vector<real> & c2k, const real & xi); \
+	template void calculate_Rmn2_1<real>(real & R2, real & R2p, bool verbose, const real & c, const real & m, const real & n, const real & n_dr, const std::vector<real> & dr, const real & F, const real & xi); \
+	template void calculate_Rmn2_2<real>(real & R2, real & R2p, bool verbose, const real & c, const real & m, const real & n, const real & n_dr, const std::vector<real> & dr, const real & n_dr_neg, const std::vector<real> & dr_neg, const real & k2, const real & xi); \
+	template void calculate_Rmn2_3<real>(real & R2, real & R2p, bool verbose, const real & c, const real & m, const real & n, const real & Q, const real & n_B2r, const std::vector<real> & B2r, const real & xi, const real & R1, const real & R1p);
+
+FOR_EACH_REAL_TYPE(INSTANTIATE_OBL_SPHEROIDAL)
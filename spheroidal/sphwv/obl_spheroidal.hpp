@@ -31,12 +31,19 @@
 #include "real.hpp"
 #include <vector>
 
+template <class real>
 real calculate_Qmn(bool verbose, const real & c, const real & m, const real & n, const real & lambda, real & n_dr, std::vector<real> & dr, const real & k1, real & n_c2k, std::vector<real> & c2k);
+template <class real>
 void calculate_B2rmn(std::vector<real> & B2r, bool verbose, const real & c, const real & m, const real & n, const real & lambda, real & n_dr, std::vector<real> & dr, const real & k1, real & n_c2k, std::vector<real> & c2k, const real & Q, real & n_B2r, const real & B2r_min);
+template <class real>
 void calculate_Rmn1_1(real & R1, real & R1p, bool verbose, const real & c, const real & m, const real & n, const real & n_dr, const std::vector<real> & dr, const real & F, const real & xi);
+template <class real>
 void calculate_Rmn1_2(real & R1, real & R1p, bool verbose, const real & c, const real & m, const real & n, const real & k1, const real & n_c2k, const std::vector<real> & c2k, const real & xi);
+template <class real>
 void calculate_Rmn2_1(real & R2, real & R2p, bool verbose, const real & c, const real & m, const real & n, const real & n_dr, const std::vector<real> & dr, const real & F, const real & xi);
+template <class real>
 void calculate_Rmn2_2(real & R2, real & R2p, bool verbose, const real & c, const real & m, const real & n, const real & n_dr, const std::vector<real> & dr, const real & n_dr_neg, const std::vector<real> & dr_neg, const real & k2, const real & xi);
+template <class real>
 void calculate_Rmn2_3(real & R2, real & R2p, bool verbose, const real & c, const real & m, const real & n, const real & Q, const real & n_B2r, const std::vector<real> & B2r, const real & xi, const real & R1, const real & R1p);
 
 #endif
@@ -31,11 +31,14 @@
 #include <iostream>
 #include "pro_spheroidal.hpp"
 #include "real.hpp"
+#include "real_types.hpp"
 #include <string>
 #include <vector>
 
+template <class real>
 static bool save_Rmn(bool verbose, const real & c, const real & m, const real & n, const real & a, const real & b, const real & d, const std::string & arg_type, const std::string & which, int p);
 
+template <class real>
 std::string generate_name(const real & c, const real & m, const real & n, const std::string & name)
 {
 	char raw_string[4096];
@@ -44,6 +47,7 @@ std::string generate_name(const real & c, const real & m, const real & n, const
 	return std::string(raw_string);
 }
 
+template <class real>
 static bool save_Rmn(bool verbose, const real & c, const real & m, const real & n, const real & a, const real & b, const real & d, const std::string & arg_type, const std::string & which, int p)
 {
 	real n_dr;
@@ -93,7 +97,7 @@ static bool save_Rmn(bool verbose, const real & c, const real & m, const real &
 		}
 		else
 		{
-			xi = pow(i * i + real::ONE, real::ONE / real::TWO);
+			xi = sqrt(i * i + real::ONE);
 		}
 		log_xi = log(xi - real::ONE);
 		if (which.find("R1_1") != std::string::npos)
@@ -161,6 +165,7 @@ static bool save_Rmn(bool verbose, const real & c, const real & m, const real &
 	return true;
 }
 
+template <class real>
 int parse_args(int argc, char **argv)
 {
 	std::string argument;
@@ -173,6 +178,8 @@ int parse_args(int argc, char **argv)
 	bool m_entered;
 	real n;
 	bool n_entered;
+	real n_max;
+	bool n_max_entered;
 	std::string w;
 	bool w_entered;
 	real n_dr;
@@ -204,6 +211,7 @@ int parse_args(int argc, char **argv)
 	c_entered = false;
 	m_entered = false;
 	n_entered = false;
+	n_max_entered = false;
 	w_entered = false;
 	n_dr_entered = false;
 	dr_min_entered = false;
@@ -241,6 +249,11 @@ int parse_args(int argc, char **argv)
 			n = real(value);
 			n_entered = true;
 		}
+		else if (argument == "-n_max")
+		{
+			n_max = real(value);
+			n_max_entered = true;
+		}
 		else if (argument == "-w")
 		{
 			w = value;
@@ -334,6 +347,15 @@ int parse_args(int argc, char **argv)
 		std::cout << "no value of verbose was entered..." << std::endl;
 		return 1;
 	}
+	else if (w_entered && w == "lambda_all")
+	{
+		if (!c_entered || !m_entered || !n_max_entered)
+		{
+			std::cout << "no value of c, m, and/or n_max was entered..." << std::endl;
+			return 1;
+		}
+		save_lambdamn_all(verbose, c, m, n_max);
+	}
 	else if (!c_entered || !m_entered || !n_entered || !w_entered)
 	{
 		std::cout << "no value of c, m, n, and/or w was entered..." << std::endl;
@@ -422,3 +444,9 @@ int parse_args(int argc, char **argv)
 	}
 	return 0;
 }
+
+#define INSTANTIATE_PRO_MAIN(real) \
+	template std::string generate_name<real>(const real & c, const real & m, const real & n, const std::string & name); \
+	template int parse_args<real>(int argc, char **argv);
+
+FOR_EACH_REAL_TYPE(INSTANTIATE_PRO_MAIN)
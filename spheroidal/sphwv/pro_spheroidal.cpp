@@ -25,59 +25,68 @@
 // POSSIBILITY OF SUCH DAMAGE.
 //
 
+#include "acceleration.hpp"
 #include "adder.hpp"
 #include "common_spheroidal.hpp"
 #include <iostream>
+#include "minimal_solution.hpp"
 #include "pro_spheroidal.hpp"
 #include "real.hpp"
+#include "real_types.hpp"
 #include <vector>
 
+template <class real>
 static void calculate_Q(std::vector<real> & Q, bool verbose, const real & m0, const real & n1, const real & xi);
 
+template <class real>
 real calculate_c_squared(const real & c)
 {
 	return c * c;
 }
 
+template <class real>
 void calculate_Rmn1_1(real & R1, real & R1p, bool verbose, const real & c, const real & m, const real & n, const real & n_dr, const std::vector<real> & dr, const real & F, const real & xi)
 {
 	calculate_Rmn1_1_shared(R1, R1p, verbose, c, m, n, n_dr, dr, xi);
 	if (m > real::ZERO)
 	{
-		R1p = pow(F, -real::ONE) * (m / real::TWO) * pow(real::ONE - real::ONE / (xi * xi), m / real::TWO - real::ONE) * (real::TWO / (xi * xi * xi)) * R1 + pow(F, -real::ONE) * pow(real::ONE - real::ONE / (xi * xi), m / real::TWO) * R1p;
+		R1p = reciprocal(F) * (m / 2) * pow(real::ONE - real::ONE / (xi * xi), m / real::TWO - real::ONE) * (2 / (xi * xi * xi)) * R1 + reciprocal(F) * pow(real::ONE - real::ONE / (xi * xi), m / 2) * R1p;
 	}
 	else
 	{
-		R1p = pow(F, -real::ONE) * R1p;
+		R1p *= reciprocal(F);
 	}
-	R1 = pow(F, -real::ONE) * pow(real::ONE - real::ONE / (xi * xi), m / real::TWO) * R1;
+	R1 = reciprocal(F) * pow(real::ONE - real::ONE / (xi * xi), m / 2) * R1;
 }
 
+template <class real>
 void calculate_Rmn1_2(real & R1, real & R1p, bool verbose, const real & c, const real & m, const real & n, const real & k1, const real & n_c2k, const std::vector<real> & c2k, const real & xi)
 {
-	adder R1_adder;
+	adder<real> R1_adder;
+	accelerator<real> R1_accelerator;
 	real a;
 	real change;
-	adder R1p_adder;
+	adder<real> R1p_adder;
+	accelerator<real> R1p_accelerator;
 	real ap;
 	real changep;
 	
 	R1 = real::ZERO;
 	R1_adder.clear();
-	for (real k = real::ZERO; k <= n_c2k - real::ONE; k = k + real::ONE)
+	for (real k = real::ZERO; k <= n_c2k - 1; k += 1)
 	{
 		if (k > real::ZERO)
 		{
-			a = a * -real::ONE * (xi * xi - real::ONE);
+			a *= -real::ONE * (xi * xi - 1);
 		}
 		else
 		{
 			a = real::ONE;
 		}
 		change = a * c2k[gzbi(k)];
-		R1 = R1 + change;
+		R1 += change;
 		R1_adder.add(change);
-		if (k > real::ZERO && abs(change) > real::ZERO && abs(change / R1) < real::SMALL_ENOUGH)
+		if (k > real::ZERO && is_negligible(change, R1))
 		{
 			if (verbose)
 			{
@@ -85,24 +94,37 @@ void calculate_Rmn1_2(real & R1, real & R1p, bool verbose, const real & c, const
 			}
 			break;
 		}
+		R1_accelerator.add(R1);
+		if (R1_accelerator.has_converged())
+		{
+			break;
+		}
+	}
+	R1_accelerator.report(verbose, "calculate_Rmn1_2", 0);
+	if (R1_accelerator.has_converged())
+	{
+		R1 = R1_accelerator.get_value();
+	}
+	else
+	{
+		R1 = R1_adder.calculate_sum();
 	}
-	R1 = R1_adder.calculate_sum();
 	R1p = real::ZERO;
 	R1p_adder.clear();
-	for (real k = real::ONE; k <= n_c2k - real::ONE; k = k + real::ONE)
+	for (real k = real::ONE; k <= n_c2k - 1; k += 1)
 	{
 		if (k > real::ONE)
 		{
-			ap = ap * -real::ONE * (xi * xi - real::ONE);
+			ap *= -real::ONE * (xi * xi - 1);
 		}
 		else
 		{
 			ap = -real::ONE;
 		}
-		changep = ap * c2k[gzbi(k)] * k * real::TWO * xi;
-		R1p = R1p + changep;
+		changep = ap * c2k[gzbi(k)] * k * 2 * xi;
+		R1p += changep;
 		R1p_adder.add(changep);
-		if (k > real::ONE && abs(changep) > real::ZERO && abs(changep / R1p) < real::SMALL_ENOUGH)
+		if (k > real::ONE && is_negligible(changep, R1p))
 		{
 			if (verbose)
 			{
@@ -110,71 +132,82 @@ void calculate_Rmn1_2(real & R1, real & R1p, bool verbose, const real & c, const
 			}
 			break;
 		}
+		R1p_accelerator.add(R1p);
+		if (R1p_accelerator.has_converged())
+		{
+			break;
+		}
+	}
+	R1p_accelerator.report(verbose, "calculate_Rmn1_2", 0);
+	if (R1p_accelerator.has_converged())
+	{
+		R1p = R1p_accelerator.get_value();
+	}
+	else
+	{
+		R1p = R1p_adder.calculate_sum();
 	}
-	R1p = R1p_adder.calculate_sum();
 	if (remainder(n - m, real::TWO) == real::ZERO)
 	{
 		if (m > real::ZERO)
 		{
-			R1p = pow(k1, -real::ONE) * (m / real::TWO) * pow(xi * xi - real::ONE, m / real::TWO - real::ONE) * real::TWO * xi * R1 + pow(k1, -real::ONE) * pow(xi * xi - real::ONE, m / real::TWO) * R1p;
+			R1p = reciprocal(k1) * (m / 2) * pow(xi * xi - 1, m / real::TWO - real::ONE) * 2 * xi * R1 + reciprocal(k1) * pow(xi * xi - 1, m / 2) * R1p;
 		}
 		else
 		{
-			R1p = pow(k1, -real::ONE) * R1p;
+			R1p *= reciprocal(k1);
 		}
-		R1 = pow(k1, -real::ONE) * pow(xi * xi - real::ONE, m / real::TWO) * R1;
+		R1 = reciprocal(k1) * pow(xi * xi - 1, m / 2) * R1;
 	}
 	else
 	{
 		if (m > real::ZERO)
 		{
-			R1p = pow(k1, -real::ONE) * pow(xi * xi - real::ONE, m / real::TWO) * R1 + pow(k1, -real::ONE) * xi * (m / real::TWO) * pow(xi * xi - real::ONE, m / real::TWO - real::ONE) * real::TWO * xi * R1 + pow(k1, -real::ONE) * xi * pow(xi * xi - real::ONE, m / real::TWO) * R1p;
+			R1p = reciprocal(k1) * pow(xi * xi - 1, m / 2) * R1 + reciprocal(k1) * xi * (m / 2) * pow(xi * xi - 1, m / real::TWO - real::ONE) * 2 * xi * R1 + reciprocal(k1) * xi * pow(xi * xi - 1, m / 2) * R1p;
 		}
 		else
 		{
-			R1p = pow(k1, -real::ONE) * R1 + pow(k1, -real::ONE) * xi * R1p;
+			R1p = reciprocal(k1) * R1 + reciprocal(k1) * xi * R1p;
 		}
-		R1 = pow(k1, -real::ONE) * xi * pow(xi * xi - real::ONE, m / real::TWO) * R1;
+		R1 = reciprocal(k1) * xi * pow(xi * xi - 1, m / 2) * R1;
 	}
 }
 
+template <class real>
 void calculate_Rmn2_1(real & R2, real & R2p, bool verbose, const real & c, const real & m, const real & n, const real & n_dr, const std::vector<real> & dr, const real & F, const real & xi)
 {
 	calculate_Rmn2_1_shared(R2, R2p, verbose, c, m, n, n_dr, dr, xi);
 	if (m > real::ZERO)
 	{
-		R2p = pow(F, -real::ONE) * (m / real::TWO) * pow(real::ONE - real::ONE / (xi * xi), m / real::TWO - real::ONE) * (real::TWO / (xi * xi * xi)) * R2 + pow(F, -real::ONE) * pow(real::ONE - real::ONE / (xi * xi), m / real::TWO) * R2p;
+		R2p = reciprocal(F) * (m / 2) * pow(real::ONE - real::ONE / (xi * xi), m / real::TWO - real::ONE) * (2 / (xi * xi * xi)) * R2 + reciprocal(F) * pow(real::ONE - real::ONE / (xi * xi), m / 2) * R2p;
 	}
 	else
 	{
-		R2p = pow(F, -real::ONE) * R2p;
+		R2p *= reciprocal(F);
 	}
-	R2 = pow(F, -real::ONE) * pow(real::ONE - real::ONE / (xi * xi), m / real::TWO) * R2;
+	R2 = reciprocal(F) * pow(real::ONE - real::ONE / (xi * xi), m / 2) * R2;
 }
 
+template <class real>
 static void calculate_Q(std::vector<real> & Q, bool verbose, const real & m0, const real & n1, const real & xi)
 {
 	real Q0;
 	real Q1;
 	real Q2;
-	real b0;
-	std::vector<real> a;
-	std::vector<real> b;
-	real prev_N;
-	real N;
+	minimal_solution<real, real> Q_solution;
 	
 	Q.clear();
-	for (real n = real::ZERO; n <= n1; n = n + real::ONE)
+	for (real n = real::ZERO; n <= n1; n += 1)
 	{
 		Q.push_back(real::ZERO);
 	}
-	Q0 = (real::ONE / real::TWO) * log((xi + real::ONE) / (xi - real::ONE));
-	Q1 = -pow(xi * xi - real::ONE, -real::ONE / real::TWO);
+	Q0 = (real::ONE / real::TWO) * log((xi + 1) / (xi - 1));
+	Q1 = -rec_sqrt(xi * xi - 1);
 	if (m0 > real::ONE)
 	{
-		for (real m = real::TWO; m <= m0; m = m + real::ONE)
+		for (real m = real::TWO; m <= m0; m += 1)
 		{
-			Q2 = (m - real::ONE) * (-m + real::TWO) * Q0 - ((real::TWO * (m - real::ONE)) / pow(xi * xi - real::ONE, real::ONE / real::TWO)) * xi * Q1;
+			Q2 = (m - 1) * (-m + 2) * Q0 - ((2 * (m - 1)) / sqrt(xi * xi - 1)) * xi * Q1;
 			Q0 = Q1;
 			Q1 = Q2;
 		}
@@ -188,57 +221,20 @@ static void calculate_Q(std::vector<real> & Q, bool verbose, const real & m0, co
 	{
 		Q[gzbi(real::ZERO)] = Q0;
 	}
-	for (real n = n1; n >= real::ONE; n = n - real::ONE)
+	Q_solution.calculate_ratios(verbose, "calculate_Q", [&](real & a_n, real & b_n, real & c_n, const real & n)
 	{
-		if (n < n1)
-		{
-			N = (n + m0) / ((real::TWO * n + real::ONE) * xi - (n - m0 + real::ONE) * N);
-		}
-		else
-		{
-			b0 = real::ZERO;
-			a.clear();
-			a.push_back(real::ONE);
-			b.clear();
-			prev_N = real::NAN;
-			for (real i = n; i <= n + real("8388608.0"); i = i + real::ONE)
-			{
-				if (remainder(i - n, real("10000.0")) == real::ZERO)
-				{
-					if (verbose)
-					{
-						std::cout << "calculate_Q: " << (i - n).get_int() << std::endl;
-					}
-				}
-				a.back() = a.back() * (i + m0);
-				b.push_back((real::TWO * i + real::ONE) * xi);
-				a.push_back(i - m0 + real::ONE);
-				if (i > n && pow(real::TWO, round(log(i - n) / log(real::TWO))) == i - n)
-				{
-					N = -calculate_continued_fraction(b0, a, b);
-					if (prev_N == prev_N)
-					{
-						if (verbose)
-						{
-							std::cout << "calculate_Q: " << (i - n).get_int() << ": " << ((N - prev_N) / prev_N).get_string(10) << std::endl;
-						}
-						if (abs((N - prev_N) / prev_N) < real::SMALL_ENOUGH)
-						{
-							break;
-						}
-					}
-					prev_N = N;
-				}
-			}
-		}
-		Q[gzbi(n)] = N;
-	}
-	for (real n = real::ONE; n <= n1; n = n + real::ONE)
+		a_n = n + m0;
+		b_n = (2 * n + 1) * xi;
+		c_n = n - m0 + 1;
+	}, real::ZERO, n1, real::ONE, real(8388609), minimal_solution<real, real>::POWERS_OF_TWO);
+	Q_solution.calculate_forward(Q);
+	if (verbose)
 	{
-		Q[gzbi(n)] = Q[gzbi(n)] * Q[gzbi(n - real::ONE)];
+		Q_solution.print_times("calculate_Q");
 	}
 }
 
+template <class real>
 void calculate_Rmn2_2(real & R2, real & R2p, bool verbose, const real & c, const real & m, const real & n, const real & n_dr, const std::vector<real> & dr, const real & n_dr_neg, const std::vector<real> & dr_neg, const real & k2, const real & xi)
 {
 	real v_max;
@@ -248,8 +244,8 @@ void calculate_Rmn2_2(real & R2, real & R2p, bool verbose, const real & c, const
 	std::vector<real> Qp;
 	real Q1;
 	real Q2;
-	adder R2_adder;
-	adder R2p_adder;
+	adder<real> R2_adder;
+	adder<real> R2p_adder;
 	real change;
 	real changep;
 	
@@ -261,48 +257,48 @@ void calculate_Rmn2_2(real & R2, real & R2p, bool verbose, const real & c, const
 	}
 	// The following code assumes there are at least m + 2 entries in P, so
 	// make sure there are.
-	v_max = max(m + real::ONE, n_dr_neg - m);
+	v_max = max(m + 1, n_dr_neg - m);
 	P.clear();
-	for (real v = real::ZERO; v <= v_max; v = v + real::ONE)
+	for (real v = real::ZERO; v <= v_max; v += 1)
 	{
 		P.push_back(real::ZERO);
 	}
 	P[gzbi(real::ZERO)] = real::ONE;
-	for (real v = real::ONE; v <= m; v = v + real::ONE)
+	for (real v = real::ONE; v <= m; v += 1)
 	{
-		P[gzbi(v)] = (real::TWO * v - real::ONE) * pow(xi * xi - real::ONE, real::ONE / real::TWO) * P[gzbi(v - real::ONE)];
-		P[gzbi(v - real::ONE)] = real::ZERO;
+		P[gzbi(v)] = (2 * v - 1) * sqrt(xi * xi - 1) * P[gzbi(v - 1)];
+		P[gzbi(v - 1)] = real::ZERO;
 	}
-	P[gzbi(m + real::ONE)] = (real::TWO * m + real::ONE) * xi * P[gzbi(m)];
-	for (real v = m + real::TWO; v <= v_max; v = v + real::ONE)
+	P[gzbi(m + 1)] = (2 * m + 1) * xi * P[gzbi(m)];
+	for (real v = m + 2; v <= v_max; v += 1)
 	{
-		P[gzbi(v)] = (real::ONE / (v - m)) * (-(v + m - real::ONE) * P[gzbi(v - real::TWO)] + (real::TWO * v - real::ONE) * xi * P[gzbi(v - real::ONE)]);
+		P[gzbi(v)] = (1 / (v - m)) * (-(v + m - 1) * P[gzbi(v - 2)] + (2 * v - 1) * xi * P[gzbi(v - 1)]);
 	}
 	Pp.clear();
-	for (real v = real::ZERO; v <= v_max - real::ONE; v = v + real::ONE)
+	for (real v = real::ZERO; v <= v_max - 1; v += 1)
 	{
 		Pp.push_back(real::ZERO);
 	}
-	for (real v = m; v <= v_max - real::ONE; v = v + real::ONE)
+	for (real v = m; v <= v_max - 1; v += 1)
 	{
-		Pp[gzbi(v)] = (real::ONE / (xi * xi - real::ONE)) * (-(v + real::ONE) * xi * P[gzbi(v)] + (v - m + real::ONE) * P[gzbi(v + real::ONE)]);
+		Pp[gzbi(v)] = (1 / (xi * xi - 1)) * (-(v + 1) * xi * P[gzbi(v)] + (v - m + 1) * P[gzbi(v + 1)]);
 	}
-	calculate_Q(Q, verbose, m, m + n_dr, xi);
+	calculate_Q<real>(Q, verbose, m, m + n_dr, xi);
 	Qp.clear();
-	for (real v = real::ZERO; v <= m + n_dr - real::ONE; v = v + real::ONE)
+	for (real v = real::ZERO; v <= m + n_dr - 1; v += 1)
 	{
 		Qp.push_back(real::ZERO);
 	}
-	for (real v = real::ZERO; v <= m + n_dr - real::ONE; v = v + real::ONE)
+	for (real v = real::ZERO; v <= m + n_dr - 1; v += 1)
 	{
-		Qp[gzbi(v)] = (real::ONE / (xi * xi - real::ONE)) * (-(v + 1) * xi * Q[gzbi(v)] + (v - m + real::ONE) * Q[gzbi(v + real::ONE)]);
+		Qp[gzbi(v)] = (1 / (xi * xi - 1)) * (-(v + 1) * xi * Q[gzbi(v)] + (v - m + 1) * Q[gzbi(v + 1)]);
 	}
 	Q1 = Q[gzbi(real::ZERO)];
 	Q2 = Q[gzbi(real::ONE)];
-	for (real v = -real::ONE; v >= -m; v = v - real::ONE)
+	for (real v = -real::ONE; v >= -m; v -= 1)
 	{
-		P[gnobi(v)] = (real::ONE / (v + m + real::ONE)) * ((real::TWO * v + real::THREE) * xi * Q1 - (v - m + real::TWO) * Q2);
-		Pp[gnobi(v)] = (real::ONE / (xi * xi - real::ONE)) * (-(v + real::ONE) * xi * P[gnobi(v)] + (v - m + real::ONE) * Q1);
+		P[gnobi(v)] = (1 / (v + m + 1)) * ((2 * v + 3) * xi * Q1 - (v - m + 2) * Q2);
+		Pp[gnobi(v)] = (1 / (xi * xi - 1)) * (-(v + 1) * xi * P[gnobi(v)] + (v - m + 1) * Q1);
 		Q2 = Q1;
 		Q1 = P[gnobi(v)];
 	}
@@ -312,15 +308,15 @@ void calculate_Rmn2_2(real & R2, real & R2p, bool verbose, const real & c, const
 	R2p_adder.clear();
 	if (remainder(n - m, real::TWO) == real::ZERO)
 	{
-		for (real r = -real::TWO * m - real::TWO; r >= -n_dr_neg; r = r - real::TWO)
+		for (real r = -2 * m - 2; r >= -n_dr_neg; r -= 2)
 		{
-			change = dr_neg[gnobi(r)] * P[gzbi(-r - m - real::ONE)];
-			R2 = R2 + change;
+			change = dr_neg[gnobi(r)] * P[gzbi(-r - m - 1)];
+			R2 += change;
 			R2_adder.add(change);
-			changep = dr_neg[gnobi(r)] * Pp[gzbi(-r - m - real::ONE)];
-			R2p = R2p + changep;
+			changep = dr_neg[gnobi(r)] * Pp[gzbi(-r - m - 1)];
+			R2p += changep;
 			R2p_adder.add(changep);
-			if (r < -real::TWO * m - real::TWO && abs(change) > real::ZERO && abs(change / R2) < real::SMALL_ENOUGH && abs(changep) > real::ZERO && abs(changep / R2p) < real::SMALL_ENOUGH)
+			if (r < -2 * m - 2 && is_negligible(change, R2) && is_negligible(changep, R2p))
 			{
 				if (verbose)
 				{
@@ -330,7 +326,7 @@ void calculate_Rmn2_2(real & R2, real & R2p, bool verbose, const real & c, const
 			}
 		}
 		// There is a max here because n_dr_neg may be smaller than m.
-		for (real r = -real::TWO; r >= max(-n_dr_neg, -real::TWO * m); r = r - real::TWO)
+		for (real r = -real::TWO; r >= max(-n_dr_neg, -2 * m); r -= 2)
 		{
 			if (m + r >= real::ZERO)
 			{
@@ -342,11 +338,11 @@ void calculate_Rmn2_2(real & R2, real & R2p, bool verbose, const real & c, const
 				change = dr_neg[gnobi(r)] * P[gnobi(m + r)];
 				changep = dr_neg[gnobi(r)] * Pp[gnobi(m + r)];
 			}
-			R2 = R2 + change;
+			R2 += change;
 			R2_adder.add(change);
-			R2p = R2p + changep;
+			R2p += changep;
 			R2p_adder.add(changep);
-			if (r < -real::TWO && abs(change) > real::ZERO && abs(change / R2) < real::SMALL_ENOUGH && abs(changep) > real::ZERO && abs(changep / R2p) < real::SMALL_ENOUGH)
+			if (r < -real::TWO && is_negligible(change, R2) && is_negligible(changep, R2p))
 			{
 				if (verbose)
 				{
@@ -355,15 +351,15 @@ void calculate_Rmn2_2(real & R2, real & R2p, bool verbose, const real & c, const
 				break;
 			}
 		}
-		for (real r = real::ZERO; r <= n_dr - real::TWO; r = r + real::TWO)
+		for (real r = real::ZERO; r <= n_dr - 2; r += 2)
 		{
 			change = dr[gzbi(r)] * Q[gzbi(m + r)];
-			R2 = R2 + change;
+			R2 += change;
 			R2_adder.add(change);
 			changep = dr[gzbi(r)] * Qp[gzbi(m + r)];
-			R2p = R2p + changep;
+			R2p += changep;
 			R2p_adder.add(changep);
-			if (r > real::ZERO && abs(change) > real::ZERO && abs(change / R2) < real::SMALL_ENOUGH && abs(changep) > real::ZERO && abs(changep / R2p) < real::SMALL_ENOUGH)
+			if (r > real::ZERO && is_negligible(change, R2) && is_negligible(changep, R2p))
 			{
 				if (verbose)
 				{
@@ -375,15 +371,15 @@ void calculate_Rmn2_2(real & R2, real & R2p, bool verbose, const real & c, const
 	}
 	else
 	{
-		for (real r = -real::TWO * m - real::ONE; r >= -n_dr_neg + real::ONE; r = r - real::TWO)
+		for (real r = -2 * m - 1; r >= -n_dr_neg + 1; r -= 2)
 		{
-			change = dr_neg[gnobi(r)] * P[gzbi(-r - m - real::ONE)];
-			R2 = R2 + change;
+			change = dr_neg[gnobi(r)] * P[gzbi(-r - m - 1)];
+			R2 += change;
 			R2_adder.add(change);
-			changep = dr_neg[gnobi(r)] * Pp[gzbi(-r - m - real::ONE)];
-			R2p = R2p + changep;
+			changep = dr_neg[gnobi(r)] * Pp[gzbi(-r - m - 1)];
+			R2p += changep;
 			R2p_adder.add(changep);
-			if (r < -real::TWO * m - real::ONE && abs(change) > real::ZERO && abs(change / R2) < real::SMALL_ENOUGH && abs(changep) > real::ZERO && abs(changep / R2p) < real::SMALL_ENOUGH)
+			if (r < -2 * m - 1 && is_negligible(change, R2) && is_negligible(changep, R2p))
 			{
 				if (verbose)
 				{
@@ -393,7 +389,7 @@ void calculate_Rmn2_2(real & R2, real & R2p, bool verbose, const real & c, const
 			}
 		}
 		// See the corresponding comment when n - m = even.
-		for (real r = -real::ONE; r >= max(-n_dr_neg + real::ONE, -real::TWO * m + real::ONE); r = r - real::TWO)
+		for (real r = -real::ONE; r >= max(-n_dr_neg + 1, -2 * m + 1); r -= 2)
 		{
 			if (m + r >= real::ZERO)
 			{
@@ -405,11 +401,11 @@ void calculate_Rmn2_2(real & R2, real & R2p, bool verbose, const real & c, const
 				change = dr_neg[gnobi(r)] * P[gnobi(m + r)];
 				changep = dr_neg[gnobi(r)] * Pp[gnobi(m + r)];
 			}
-			R2 = R2 + change;
+			R2 += change;
 			R2_adder.add(change);
-			R2p = R2p + changep;
+			R2p += changep;
 			R2p_adder.add(changep);
-			if (r < -real::ONE && abs(change) > real::ZERO && abs(change / R2) < real::SMALL_ENOUGH && abs(changep) > real::ZERO && abs(changep / R2p) < real::SMALL_ENOUGH)
+			if (r < -real::ONE && is_negligible(change, R2) && is_negligible(changep, R2p))
 			{
 				if (verbose)
 				{
@@ -418,15 +414,15 @@ void calculate_Rmn2_2(real & R2, real & R2p, bool verbose, const real & c, const
 				break;
 			}
 		}
-		for (real r = real::ONE; r <= n_dr - real::ONE; r = r + real::TWO)
+		for (real r = real::ONE; r <= n_dr - 1; r += 2)
 		{
 			change = dr[gzbi(r)] * Q[gzbi(m + r)];
-			R2 = R2 + change;
+			R2 += change;
 			R2_adder.add(change);
 			changep = dr[gzbi(r)] * Qp[gzbi(m + r)];
-			R2p = R2p + changep;
+			R2p += changep;
 			R2p_adder.add(changep);
-			if (r > real::ONE && abs(change) > real::ZERO && abs(change / R2) < real::SMALL_ENOUGH && abs(changep) > real::ZERO && abs(changep / R2p) < real::SMALL_ENOUGH)
+			if (r > real::ONE && is_negligible(change, R2) && is_negligible(changep, R2p))
 			{
 				if (verbose)
 				{
@@ -438,6 +434,15 @@ void calculate_Rmn2_2(real & R2, real & R2p, bool verbose, const real & c, const
 	}
 	R2 = R2_adder.calculate_sum();
 	R2p = R2p_adder.calculate_sum();
-	R2 = pow(k2, -real::ONE) * R2;
-	R2p = pow(k2, -real::ONE) * R2p;
+	R2 *= reciprocal(k2);
+	R2p *= reciprocal(k2);
 }
+
+#define INSTANTIATE_PRO_SPHEROIDAL(real) \
+	template real calculate_c_squared<real>(const real & c); \
+	template void calculate_Rmn1_1<real>(real & R1, real & R1p, bool verbose, const real & c, const real & m, const real & n, const real & n_dr, const std::vector<real> & dr, const real & F, const real & xi); \
+	template void calculate_Rmn1_2<real>(real & R1, real & R1p, bool verbose, const real & c, const real & m, const real & n, const real & k1, const real & n_c2k, const std::vector<real> & c2k, const real & xi); \
+	template void calculate_Rmn2_1<real>(real & R2, real & R2p, bool verbose, const real & c, const real & m, const real & n, const real & n_dr, const std::vector<real> & dr, const real & F, const real & xi); \
+	template void calculate_Rmn2_2<real>(real & R2, real & R2p, bool verbose, const real & c, const real & m, const real & n, const real & n_dr, const std::vector<real> & dr, const real & n_dr_neg, const std::vector<real> & dr_neg, const real & k2, const real & xi);
+
+FOR_EACH_REAL_TYPE(INSTANTIATE_PRO_SPHEROIDAL)
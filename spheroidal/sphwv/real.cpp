@@ -30,165 +30,192 @@
 #include <mpfr.h>
 #include "real.hpp"
 #include <string>
+#include <utility>
+#include <vector>
+
+const real_constant real::NAN(&real_context::NAN);
+const real_constant real::INF(&real_context::INF);
+const real_constant real::ZERO(&real_context::ZERO);
+const real_constant real::ONE(&real_context::ONE);
+const real_constant real::TWO(&real_context::TWO);
+const real_constant real::THREE(&real_context::THREE);
+const real_constant real::FOUR(&real_context::FOUR);
+const real_constant real::FIVE(&real_context::FIVE);
+const real_constant real::PI(&real_context::PI);
+const real_constant real::EPS(&real_context::EPS);
+const real_constant real::SMALL_ENOUGH(&real_context::SMALL_ENOUGH);
+
+thread_local real_context *real_context::current = 0;
 
 //
-// max_reals is the maximum number of reals that can be active at the same
-// time.  When there are too many reals in use, the program stops.  This
-// serves as a way to prevent the program from using too much memory, and
-// causing the machine to thrash or whatever.  n_reals is the number of reals
-// being used, and is incremented or decremented in the real's constructor or
-// destructor, respectively.
+// The constants are made (at the context's precision) after s has made the
+// context current.
 //
-int real::max_reals = -1;
-int real::n_reals = 0;
-
-real real::NAN;
-real real::INF;
-real real::ZERO;
-real real::ONE;
-real real::TWO;
-real real::THREE;
-real real::FOUR;
-real real::FIVE;
-real real::PI;
-real real::EPS;
-real real::SMALL_ENOUGH;
-complex complex::I;
-
-void real::begin(int precision, int mmax_reals)
-{
-	max_reals = mmax_reals;
-	n_reals = 0;
-	mpfr_set_default_prec(precision);
-	mpfr_clear(NAN.r);
-	mpfr_init(NAN.r);
+real_context::real_context(int pprecision, int mmax_reals) : precision(pprecision), max_reals(mmax_reals), n_reals(0), n_bytes(0), s(this)
+{
 	mpfr_set_nan(NAN.r);
-	mpfr_clear(INF.r);
-	mpfr_init(INF.r);
 	mpfr_set_inf(INF.r, 0);
-	mpfr_clear(ZERO.r);
-	mpfr_init(ZERO.r);
-	ZERO = real("0.0");
-	mpfr_clear(ONE.r);
-	mpfr_init(ONE.r);
-	ONE = real("1.0");
-	mpfr_clear(TWO.r);
-	mpfr_init(TWO.r);
-	TWO = real("2.0");
-	mpfr_clear(THREE.r);
-	mpfr_init(THREE.r);
-	THREE = real("3.0");
-	mpfr_clear(FOUR.r);
-	mpfr_init(FOUR.r);
-	FOUR = real("4.0");
-	mpfr_clear(FIVE.r);
-	mpfr_init(FIVE.r);
-	FIVE = real("5.0");
-	mpfr_clear(PI.r);
-	mpfr_init(PI.r);
+	mpfr_set_zero(ZERO.r, 1);
+	mpfr_set_si(ONE.r, 1, MPFR_RNDN);
+	mpfr_set_si(TWO.r, 2, MPFR_RNDN);
+	mpfr_set_si(THREE.r, 3, MPFR_RNDN);
+	mpfr_set_si(FOUR.r, 4, MPFR_RNDN);
+	mpfr_set_si(FIVE.r, 5, MPFR_RNDN);
 	mpfr_const_pi(PI.r, MPFR_RNDN);
-	mpfr_clear(EPS.r);
-	mpfr_init(EPS.r);
 	EPS = ONE;
 	while (ONE + EPS != ONE)
 	{
 		EPS = EPS / TWO;
 	}
-	mpfr_clear(SMALL_ENOUGH.r);
-	mpfr_init(SMALL_ENOUGH.r);
 	SMALL_ENOUGH = EPS;
 }
 
+void real_context::stop()
+{
+	std::cout << "error: program has reached memory capacity" << std::endl;
+	exit(1);
+}
+
 real::real()
 {
-	mpfr_init(r);
-	mpfr_set_str(r, "0.0", 10, MPFR_RNDN);
-	++n_reals;
-	if (max_reals != -1 && n_reals > max_reals)
+	init();
+	if (r->_mpfr_d != 0)
 	{
-		std::cout << "error: program has reached memory capacity" << std::endl;
-		exit(1);
+		mpfr_set_zero(r, 1);
 	}
 }
 
 real::real(const real & a)
 {
-	mpfr_init(r);
+	init();
 	mpfr_set(r, a.r, MPFR_RNDN);
-	++n_reals;
-	if (max_reals != -1 && n_reals > max_reals)
+}
+
+//
+// The move constructor takes over a's limbs instead of allocating new ones
+// and copying them.  This leaves a empty (with no limbs at all), and an empty
+// real can only be assigned to or destroyed.
+//
+real::real(real && a)
+{
+	real_context *context = real_context::get();
+	
+	r[0] = a.r[0];
+	a.r->_mpfr_d = 0;
+	if (context != 0)
 	{
-		std::cout << "error: program has reached memory capacity" << std::endl;
-		exit(1);
+		++context->n_reals;
+		if (context->is_full())
+		{
+			real_context::stop();
+		}
 	}
 }
 
 real::real(int a)
 {
-	mpfr_init(r);
+	init();
 	mpfr_set_si(r, a, MPFR_RNDZ);
-	++n_reals;
-	if (max_reals != -1 && n_reals > max_reals)
-	{
-		std::cout << "error: program has reached memory capacity" << std::endl;
-		exit(1);
-	}
 }
 
 real::real(double a)
 {
-	mpfr_init(r);
+	init();
 	mpfr_set_d(r, a, MPFR_RNDN);
-	++n_reals;
-	if (max_reals != -1 && n_reals > max_reals)
-	{
-		std::cout << "error: program has reached memory capacity" << std::endl;
-		exit(1);
-	}
 }
 
 real::real(const std::string & a)
 {
-	mpfr_init(r);
+	init();
 	mpfr_set_str(r, a.c_str(), 10, MPFR_RNDN);
-	++n_reals;
-	if (max_reals != -1 && n_reals > max_reals)
-	{
-		std::cout << "error: program has reached memory capacity" << std::endl;
-		exit(1);
-	}
 }
 
 real::~real()
 {
-	mpfr_clear(r);
-	--n_reals;
+	real_context *context = real_context::get();
+	
+	if (r->_mpfr_d != 0)
+	{
+		mpfr_clear(r);
+	}
+	if (context != 0)
+	{
+		--context->n_reals;
+	}
 }
 
 real & real::operator =(const real & a)
 {
+	revive();
 	mpfr_set(r, a.r, MPFR_RNDN);
 	return *this;
 }
 
+//
+// Move assignment just swaps the limbs, so that the old value gets freed
+// along with the temporary.
+//
+real & real::operator =(real && a)
+{
+	mpfr_swap(r, a.r);
+	return *this;
+}
+
 real & real::operator =(int a)
 {
+	revive();
 	mpfr_set_si(r, a, MPFR_RNDN);
 	return *this;
 }
 
 real & real::operator =(double a)
 {
+	revive();
 	mpfr_set_d(r, a, MPFR_RNDN);
 	return *this;
 }
 
 real & real::operator =(const std::string & a)
 {
+	revive();
 	mpfr_set_str(r, a.c_str(), 10, MPFR_RNDN);
 	return *this;
 }
 
+void real::init()
+{
+	real_context *context = real_context::get();
+	
+	if (context == 0)
+	{
+		r->_mpfr_d = 0;
+		return;
+	}
+	mpfr_init2(r, context->precision);
+	++context->n_reals;
+	if (context->is_full())
+	{
+		real_context::stop();
+	}
+}
+
+//
+// Gives an empty real (one that has been moved from) its limbs back, so that
+// it can be assigned to again.
+//
+void real::revive()
+{
+	if (r->_mpfr_d == 0)
+	{
+		mpfr_init2(r, real_context::get()->precision);
+	}
+}
+
+int real::get_precision() const
+{
+	return (int)mpfr_get_prec(r);
+}
+
 int real::get_int() const
 {
 	return mpfr_get_si(r, MPFR_RNDZ);
@@ -200,6 +227,11 @@ double real::get_double() const
 }
 
 std::string real::get_string(int p) const
+{
+	return get_mpfr_string(r, p);
+}
+
+std::string get_mpfr_string(mpfr_srcptr r, int p)
 {
 	std::string string;
 	char *raw_string;
@@ -223,8 +255,9 @@ std::string real::get_string(int p) const
 	else
 	{
 		// Dynamically allocate a character array to hold the base-10
-		// representation of the real.
-		raw_string = new char[(int)mpfr_get_default_prec()];
+		// representation of the real.  It needs room for p digits (or, if p
+		// is 0, about as many as there are bits), the sign, and the null.
+		raw_string = new char[(int)mpfr_get_prec(r) + p + 3];
 		mpfr_get_str(raw_string, &exp, 10, p, r, MPFR_RNDN);
 		string = std::string(raw_string);
 		if (mpfr_zero_p(r) == 0)
@@ -251,44 +284,167 @@ std::string real::get_string(int p) const
 	return string;
 }
 
-real operator +(const real & a, const real & b)
+//
+// The scratch register that set_mpfr_mul_for_sum rounds the products into.
+// Its limbs are in a vector of its own (using MPFR's custom interface), not
+// from the allocator (see allocator.hpp), so that it can outlive the pool,
+// and they're only reallocated when it needs more bits than it's ever had.
+// Otherwise, only its precision changes, with mpfr_set_prec_raw.
+//
+class product_scratch
 {
-	real x;
+public:
+	product_scratch() : max_precision(0)
+	{
+	}
 	
-	mpfr_add(x.r, a.r, b.r, MPFR_RNDN);
-	return x;
-}
+	mpfr_ptr get(mpfr_prec_t precision)
+	{
+		if (precision > max_precision)
+		{
+			limbs.resize(mpfr_custom_get_size(precision) / sizeof(mp_limb_t) + 1);
+			mpfr_custom_init(limbs.data(), precision);
+			mpfr_custom_init_set(t, MPFR_ZERO_KIND, 0, precision, limbs.data());
+			max_precision = precision;
+		}
+		else
+		{
+			mpfr_set_prec_raw(t, precision);
+		}
+		return t;
+	}
+	
+private:
+	std::vector<mp_limb_t> limbs;
+	mpfr_t t;
+	mpfr_prec_t max_precision;
+};
 
-real operator -(const real & a, const real & b)
+static thread_local product_scratch scratch;
+
+//
+// Sets x to a * b, like mpfr_mul, except that the product is first rounded
+// to only as many bits as it can still change sum by, plus guard_bits, and
+// returns how many bits that was.  It's for the terms of a series that has
+// almost converged, where a term that's 2^-100 of the sum only needs its
+// top bits, and a product to a few dozen bits is much cheaper than one to
+// the full precision.
+//
+// abs(a * b) is less than 2^(e(a) + e(b)), so a * b doesn't change sum until
+// the last precision - (e(sum) - e(a) - e(b)) bits of it, and rounding the
+// product to guard_bits more than that changes the sum by at most
+// 2^-guard_bits of an ulp.  If any of them isn't a regular number, or the
+// product can change every bit of the sum, it's done to the full precision.
+//
+long set_mpfr_mul_for_sum(mpfr_ptr x, mpfr_srcptr a, mpfr_srcptr b, mpfr_srcptr sum, long guard_bits)
 {
-	real x;
+	long precision;
+	long bits;
+	mpfr_ptr t;
 	
-	mpfr_sub(x.r, a.r, b.r, MPFR_RNDN);
-	return x;
+	precision = mpfr_get_prec(x);
+	if (mpfr_regular_p(a) == 0 || mpfr_regular_p(b) == 0 || mpfr_regular_p(sum) == 0)
+	{
+		mpfr_mul(x, a, b, MPFR_RNDN);
+		return precision;
+	}
+	bits = precision - (mpfr_get_exp(sum) - mpfr_get_exp(a) - mpfr_get_exp(b)) + guard_bits;
+	if (bits >= precision)
+	{
+		mpfr_mul(x, a, b, MPFR_RNDN);
+		return precision;
+	}
+	if (bits < guard_bits)
+	{
+		bits = guard_bits;
+	}
+	t = scratch.get(bits);
+	mpfr_mul(t, a, b, MPFR_RNDN);
+	mpfr_set(x, t, MPFR_RNDN);
+	return bits;
 }
 
-real operator *(const real & a, const real & b)
+//
+// mpfr_pow works out a ** b as exp(b * log(a)), which is a lot slower than
+// what's needed for the powers that come up most, which are integers (where
+// a is often -1 or 2) and halves of odd integers (usually square roots of
+// something).  Those are done with mpfr_pow_si and mpfr_sqrt instead.  A
+// half-integer power is rounded twice instead of once, which only costs the
+// last bit or so.  mpfr_cmp_si returns 0 when a is NaN, so a has to be
+// checked for that before it's taken to be -1.
+//
+void set_mpfr_pow(mpfr_ptr x, mpfr_srcptr a, mpfr_srcptr b)
 {
-	real x;
+	mpfr_t h;
+	long n;
 	
-	mpfr_mul(x.r, a.r, b.r, MPFR_RNDN);
-	return x;
+	if (mpfr_integer_p(b) != 0 && mpfr_fits_slong_p(b, MPFR_RNDZ) != 0)
+	{
+		n = mpfr_get_si(b, MPFR_RNDZ);
+		if (mpfr_number_p(a) != 0 && mpfr_cmp_si(a, -1) == 0)
+		{
+			mpfr_set_si(x, n % 2 == 0 ? 1 : -1, MPFR_RNDN);
+		}
+		else if (n == -1)
+		{
+			mpfr_ui_div(x, 1, a, MPFR_RNDN);
+		}
+		else
+		{
+			mpfr_pow_si(x, a, n, MPFR_RNDN);
+		}
+		return;
+	}
+	if (mpfr_number_p(b) != 0 && mpfr_regular_p(a) != 0 && mpfr_sgn(a) > 0)
+	{
+		// b is a half-integer if 2 * b is an integer, and multiplying by 2
+		// is exact.
+		mpfr_init2(h, mpfr_get_prec(b));
+		mpfr_mul_2ui(h, b, 1, MPFR_RNDN);
+		if (mpfr_integer_p(h) != 0 && mpfr_fits_slong_p(h, MPFR_RNDZ) != 0)
+		{
+			n = mpfr_get_si(h, MPFR_RNDZ);
+			if (n == 1)
+			{
+				mpfr_sqrt(x, a, MPFR_RNDN);
+			}
+			else if (n == -1)
+			{
+				mpfr_rec_sqrt(x, a, MPFR_RNDN);
+			}
+			else
+			{
+				mpfr_set_prec(h, mpfr_get_prec(x));
+				mpfr_sqrt(h, a, MPFR_RNDN);
+				mpfr_pow_si(x, a, (n - 1) / 2, MPFR_RNDN);
+				mpfr_mul(x, x, h, MPFR_RNDN);
+			}
+			mpfr_clear(h);
+			return;
+		}
+		mpfr_clear(h);
+	}
+	mpfr_pow(x, a, b, MPFR_RNDN);
 }
 
-real operator /(const real & a, const real & b)
+real_binary<real_add, real, real> operator +(const real & a, const real & b)
 {
-	real x;
-	
-	mpfr_div(x.r, a.r, b.r, MPFR_RNDN);
-	return x;
+	return real_binary<real_add, real, real>(a, b);
 }
 
-real operator -(const real & a)
+real_binary<real_sub, real, real> operator -(const real & a, const real & b)
 {
-	real x;
-	
-	mpfr_neg(x.r, a.r, MPFR_RNDN);
-	return x;
+	return real_binary<real_sub, real, real>(a, b);
+}
+
+real_binary<real_mul, real, real> operator *(const real & a, const real & b)
+{
+	return real_binary<real_mul, real, real>(a, b);
+}
+
+real_binary<real_div, real, real> operator /(const real & a, const real & b)
+{
+	return real_binary<real_div, real, real>(a, b);
 }
 
 bool operator >(const real & a, const real & b)
@@ -329,6 +485,52 @@ real abs(const real & a)
 	return x;
 }
 
+//
+// is_negligible(change, x) is abs(change) > ZERO && abs(change / x) <
+// SMALL_ENOUGH, which is what the series and recurrences test to see if
+// they've converged.  Most of the time the exponents alone are enough to
+// tell:  abs(change / x) is within a factor of two of 2^(e(change) - e(x)),
+// so it's only when that's within a factor of four of SMALL_ENOUGH that the
+// division has to be done.  Either way, the answer is the same.
+//
+bool is_negligible(const real & change, const real & x)
+{
+	mpfr_exp_t d;
+	mpfr_exp_t s;
+	
+	if (mpfr_regular_p(change.r) && mpfr_regular_p(x.r))
+	{
+		d = mpfr_get_exp(change.r) - mpfr_get_exp(x.r);
+		s = mpfr_get_exp(real::SMALL_ENOUGH.src());
+		if (d + 2 < s)
+		{
+			return true;
+		}
+		if (d > s + 1)
+		{
+			return false;
+		}
+	}
+	return abs(change) > real::ZERO && abs(change / x) < real::SMALL_ENOUGH;
+}
+
+//
+// See set_mpfr_mul_for_sum.
+//
+long mul_for_sum(real & x, const real & a, const real & b, const real & sum, long guard_bits)
+{
+	return set_mpfr_mul_for_sum(x.r, a.r, b.r, sum.r, guard_bits);
+}
+
+//
+// Sets x to a * 2^e, rounded once.
+//
+void set_z_2exp(real & x, mpz_srcptr a, long e)
+{
+	mpfr_set_z(x.r, a, MPFR_RNDN);
+	mpfr_mul_2si(x.r, x.r, e, MPFR_RNDN);
+}
+
 real atan(const real & a)
 {
 	real x;
@@ -393,168 +595,83 @@ real pow(const real & a, const real & b)
 {
 	real x;
 	
-	mpfr_pow(x.r, a.r, b.r, MPFR_RNDN);
+	set_mpfr_pow(x.r, a.r, b.r);
 	return x;
 }
 
-real remainder(const real & a, const real & b)
+real pow_si(const real & a, long n)
 {
 	real x;
 	
-	mpfr_remainder(x.r, a.r, b.r, MPFR_RNDN);
+	mpfr_pow_si(x.r, a.r, n, MPFR_RNDN);
 	return x;
 }
 
-real round(const real & a)
+real rec_sqrt(const real & a)
 {
 	real x;
 	
-	mpfr_rint(x.r, a.r, MPFR_RNDN);
+	mpfr_rec_sqrt(x.r, a.r, MPFR_RNDN);
 	return x;
 }
 
-real sin(const real & a)
+real reciprocal(const real & a)
 {
 	real x;
 	
-	mpfr_sin(x.r, a.r, MPFR_RNDN);
+	mpfr_ui_div(x.r, 1, a.r, MPFR_RNDN);
 	return x;
 }
 
-int gzbi(const real & i)
-{
-	return i.get_int();
-}
-
-int gnobi(const real & i)
-{
-	return -i.get_int() - 1;
-}
-
-void complex::begin()
-{
-	mpfr_clear(I.a.r);
-	mpfr_init(I.a.r);
-	mpfr_clear(I.b.r);
-	mpfr_init(I.b.r);
-	I = complex(real::ZERO, real::ONE);
-}
-
-complex::complex()
-{
-	a = real::ZERO;
-	b = real::ZERO;
-}
-
-complex::complex(const real & aa)
-{
-	a = aa;
-	b = real::ZERO;
-}
-
-complex::complex(const real & aa, const real & bb)
-{
-	a = aa;
-	b = bb;
-}
-
-complex & complex::operator =(const real & aa)
-{
-	a = aa;
-	b = real::ZERO;
-	return *this;
-}
-
-complex & complex::operator =(const complex & aa)
-{
-	a = aa.a;
-	b = aa.b;
-	return *this;
-}
-
-std::string complex::get_string(int p) const
-{
-	return a.get_string(p) + " + i * " + b.get_string(p);
-}
-
-complex operator +(const complex & a, const complex & b)
+real remainder(const real & a, const real & b)
 {
-	complex x;
+	real x;
 	
-	x.a = a.a + b.a;
-	x.b = a.b + b.b;
+	mpfr_remainder(x.r, a.r, b.r, MPFR_RNDN);
 	return x;
 }
 
-complex operator -(const complex & a, const complex & b)
+real round(const real & a)
 {
-	complex x;
+	real x;
 	
-	x.a = a.a - b.a;
-	x.b = a.b - b.b;
+	mpfr_rint(x.r, a.r, MPFR_RNDN);
 	return x;
 }
 
-complex operator *(const complex & a, const complex & b)
+//
+// Returns (-1) ** n for an integer n, which only depends on whether n is odd.
+//
+real sign_pow(const real & n)
 {
-	complex x;
+	real x;
 	
-	x.a = a.a * b.a - a.b * b.b;
-	x.b = a.a * b.b + a.b * b.a;
+	mpfr_set_si(x.r, mpfr_get_si(n.r, MPFR_RNDZ) % 2 == 0 ? 1 : -1, MPFR_RNDN);
 	return x;
 }
 
-complex operator /(const complex & a, const complex & b)
+real sin(const real & a)
 {
-	real r;
-	complex x;
+	real x;
 	
-	r = b.a * b.a + b.b * b.b;
-	x.a = (a.a * b.a + a.b * b.b) / r;
-	x.b = (a.b * b.a - a.a * b.b) / r;
+	mpfr_sin(x.r, a.r, MPFR_RNDN);
 	return x;
 }
 
-complex operator -(const complex & a)
+real sqrt(const real & a)
 {
-	complex x;
+	real x;
 	
-	x.a = -a.a;
-	x.b = -a.b;
+	mpfr_sqrt(x.r, a.r, MPFR_RNDN);
 	return x;
 }
 
-real abs(const complex & a)
-{
-	return pow(a.a * a.a + a.b * a.b, real::ONE / real::TWO);
-}
-
-//
-// Returns the value on the principal branch.
-//
-complex log(const complex & a)
+int gzbi(const real & i)
 {
-	real r;
-	real angle;
-	complex x;
-	
-	r = abs(a);
-	angle = atan2(a.b, a.a);
-	x = log(r) + complex::I * angle;
-	return x;
+	return i.get_int();
 }
 
-//
-// Returns the value on the principal branch.
-//
-complex pow(const complex & a, const real & b)
+int gnobi(const real & i)
 {
-	real r;
-	real angle;
-	complex x;
-	
-	r = abs(a);
-	angle = atan2(a.b, a.a);
-	x = pow(r, b) * (cos(b * angle) + complex::I * sin(b * angle));
-	return x;
+	return -i.get_int() - 1;
 }
@@ -30,66 +30,1191 @@
 
 #include <mpfr.h>
 #include <string>
+#include <type_traits>
 
-class real
+class real;
+class real_context;
+
+//
+// The scratch register of an expression whose value is a real.  Its limbs
+// are only allocated if it's actually used, with the precision of the
+// destination.
+//
+class real_scratch
+{
+public:
+	real_scratch() : used(false)
+	{
+	}
+	
+	~real_scratch()
+	{
+		if (used)
+		{
+			mpfr_clear(t);
+		}
+	}
+	
+	mpfr_ptr get(mpfr_srcptr x)
+	{
+		used = true;
+		mpfr_init2(t, mpfr_get_prec(x));
+		return t;
+	}
+	
+private:
+	mpfr_t t;
+	bool used;
+};
+
+//
+// Arithmetic on reals is lazy.  a + b, a * b, and so on don't calculate
+// anything, but build a small expression object that remembers the operands,
+// and the whole right-hand side is evaluated straight into its destination
+// once it's assigned to a real (or used anywhere a real is needed).  That way,
+// an expression like (real::TWO * m + r - real::ONE) * (real::TWO * m + r)
+// needs at most one scratch register instead of one temporary per operator,
+// and x * y + z and x * y - z are done with a single rounding using mpfr_fma
+// and mpfr_fms.  real_expr is the base of every expression, including real
+// itself.
+//
+template <class E>
+class real_expr
+{
+public:
+	const E & self() const
+	{
+		return static_cast<const E &>(*this);
+	}
+	
+	int get_int() const;
+	double get_double() const;
+	std::string get_string(int p) const;
+};
+
+//
+// One of the constants, like real::PI.  It stands for the constant of the
+// thread's current context (see real_context below), so that each context
+// has them at its own precision.
+//
+class real_constant : public real_expr<real_constant>
 {
 public:
-	static int max_reals;
-	static int n_reals;
-	static real NAN;
-	static real INF;
-	static real ZERO;
-	static real ONE;
-	static real TWO;
-	static real THREE;
-	static real FOUR;
-	static real FIVE;
-	static real PI;
-	static real EPS;
-	static real SMALL_ENOUGH;
-	
-	static void begin(int precision, int mmax_reals);
+	typedef real value_type;
+	typedef real_scratch scratch;
+	
+	static const bool leaf = true;
+	
+	constexpr real_constant(real real_context::*mmember) : member(mmember)
+	{
+	}
+	
+	mpfr_srcptr src() const;
+	
+	bool aliases(mpfr_srcptr x) const
+	{
+		return x == src();
+	}
+	
+	bool safe(mpfr_srcptr x) const
+	{
+		return true;
+	}
+	
+	void eval(mpfr_ptr x) const
+	{
+		mpfr_set(x, src(), MPFR_RNDN);
+	}
+	
+private:
+	real real_context::*member;
+};
+
+class real : public real_expr<real>
+{
+public:
+	typedef real value_type;
+	typedef real_scratch scratch;
+	
+	static const real_constant NAN;
+	static const real_constant INF;
+	static const real_constant ZERO;
+	static const real_constant ONE;
+	static const real_constant TWO;
+	static const real_constant THREE;
+	static const real_constant FOUR;
+	static const real_constant FIVE;
+	static const real_constant PI;
+	static const real_constant EPS;
+	static const real_constant SMALL_ENOUGH;
 	
 	mpfr_t r;
 	
 	real();
 	real(const real & a);
+	real(real && a);
 	real(int a);
 	real(double a);
 	real(const std::string & a);
+	template <class E, class = typename std::enable_if<std::is_same<typename E::value_type, real>::value>::type>
+	real(const real_expr<E> & a);
 	~real();
 	real & operator =(const real & a);
+	real & operator =(real && a);
 	real & operator =(int a);
 	real & operator =(double a);
 	real & operator =(const std::string & a);
+	template <class E>
+	real & operator =(const real_expr<E> & a);
+	template <class E>
+	real & operator +=(const real_expr<E> & a);
+	template <class E>
+	real & operator -=(const real_expr<E> & a);
+	template <class E>
+	real & operator *=(const real_expr<E> & a);
+	template <class E>
+	real & operator /=(const real_expr<E> & a);
+	template <class T>
+	typename std::enable_if<std::is_integral<T>::value, real &>::type operator +=(T a);
+	template <class T>
+	typename std::enable_if<std::is_integral<T>::value, real &>::type operator -=(T a);
+	template <class T>
+	typename std::enable_if<std::is_integral<T>::value, real &>::type operator *=(T a);
+	template <class T>
+	typename std::enable_if<std::is_integral<T>::value, real &>::type operator /=(T a);
+	int get_precision() const;
 	int get_int() const;
 	double get_double() const;
 	std::string get_string(int p) const;
+	
+	// A real is the leaf of an expression.
+	static const bool leaf = true;
+	
+	mpfr_srcptr src() const
+	{
+		return r;
+	}
+	
+	bool aliases(mpfr_srcptr x) const
+	{
+		return x == r;
+	}
+	
+	bool safe(mpfr_srcptr x) const
+	{
+		return true;
+	}
+	
+	void eval(mpfr_ptr x) const
+	{
+		mpfr_set(x, r, MPFR_RNDN);
+	}
+	
+private:
+	void init();
+	void revive();
 };
 
-class complex
+//
+// Everything about the reals that used to be global: the precision, the
+// number of reals in use (and how many there can be), and the constants.
+// Each thread makes its own context, which is the thread's current one for
+// as long as it exists, and restores the one before it when it's destroyed,
+// so different threads (or different parts of the same thread) can work at
+// different precisions without touching each other, and MPFR's default
+// precision is never used.  (MPFR has to have been built thread-safe for
+// threads to use it at the same time.)
+//
+// max_reals is the maximum number of reals that can be active at the same
+// time in the context, or -1 for no limit.  When there are too many reals in
+// use, the program stops.  This serves as a way to prevent the program from
+// using too much memory, and causing the machine to thrash or whatever.
+// n_reals is the number of reals being used, and is incremented or
+// decremented in the real's constructor or destructor, respectively.
+//
+// The other kinds of reals (see fixed_real.hpp and native_real.hpp) count
+// against the same limit, by how many bytes they take up: their
+// constructors and destructors call add_bytes and remove_bytes, which keep
+// n_bytes, and a real counts as precision / 8 bytes, so that max_reals
+// works out to the same amount of memory no matter which kind is used.
+//
+// A real that's made outside of any context, which only happens to statics
+// like complex<real>::I, is left empty until it's assigned to.
+//
+class real_context
 {
 public:
-	static complex I;
+	int precision;
+	int max_reals;
+	int n_reals;
+	long n_bytes;
 	
-	static void begin();
+	real_context(int pprecision, int mmax_reals);
+	real_context(const real_context & a) = delete;
+	real_context & operator =(const real_context & a) = delete;
 	
-	real a;
-	real b;
+	static real_context * get()
+	{
+		return current;
+	}
 	
-	complex();
-	complex(const real & aa);
-	complex(const real & aa, const real & bb);
-	complex & operator =(const real & aa);
-	complex & operator =(const complex & aa);
-	std::string get_string(int p) const;
+	static void add_bytes(long n)
+	{
+		real_context *context = current;
+		
+		if (context != 0)
+		{
+			context->n_bytes += n;
+			if (context->is_full())
+			{
+				stop();
+			}
+		}
+	}
+	
+	static void remove_bytes(long n)
+	{
+		real_context *context = current;
+		
+		if (context != 0)
+		{
+			context->n_bytes -= n;
+		}
+	}
+	
+	bool is_full() const
+	{
+		return max_reals != -1 && (long)n_reals * precision + n_bytes * 8 > (long)max_reals * precision;
+	}
+	
+	static void stop();
+	
+private:
+	//
+	// Makes the context current before the constants are made, and restores
+	// the previous one only after they're destroyed.
+	//
+	class scope
+	{
+	public:
+		scope(real_context * context) : prev(current)
+		{
+			current = context;
+		}
+		
+		~scope()
+		{
+			current = prev;
+		}
+		
+	private:
+		real_context *prev;
+	};
+	
+	static thread_local real_context *current;
+	
+	scope s;
+	
+public:
+	real NAN;
+	real INF;
+	real ZERO;
+	real ONE;
+	real TWO;
+	real THREE;
+	real FOUR;
+	real FIVE;
+	real PI;
+	real EPS;
+	real SMALL_ENOUGH;
 };
 
-real operator +(const real & a, const real & b);
-real operator -(const real & a, const real & b);
-real operator *(const real & a, const real & b);
-real operator /(const real & a, const real & b);
-real operator -(const real & a);
+inline mpfr_srcptr real_constant::src() const
+{
+	return (real_context::get()->*member).r;
+}
+
+//
+// Used by real::get_string and the other kinds of reals.
+//
+std::string get_mpfr_string(mpfr_srcptr r, int p);
+
+//
+// Used by pow for real and fixed_real.  x can't be a or b.
+//
+void set_mpfr_pow(mpfr_ptr x, mpfr_srcptr a, mpfr_srcptr b);
+
+//
+// Used by mul_for_sum for real and fixed_real.  x can't be a or b.
+//
+long set_mpfr_mul_for_sum(mpfr_ptr x, mpfr_srcptr a, mpfr_srcptr b, mpfr_srcptr sum, long guard_bits);
+
+//
+// Expressions hold reals (the leaves) by reference and other expressions by
+// value.  The reals have to outlive the expression, which they do as long as
+// it's evaluated in the same statement that built it.
+//
+template <class E, bool leaf = E::leaf>
+struct real_operand
+{
+	typedef const E type;
+};
+
+template <class E>
+struct real_operand<E, true>
+{
+	typedef const E & type;
+};
+
+struct real_add
+{
+	static void apply(mpfr_ptr x, mpfr_srcptr a, mpfr_srcptr b)
+	{
+		mpfr_add(x, a, b, MPFR_RNDN);
+	}
+	
+	static void apply(mpfr_ptr x, mpfr_srcptr a, long b)
+	{
+		mpfr_add_si(x, a, b, MPFR_RNDN);
+	}
+	
+	static void apply(mpfr_ptr x, mpfr_srcptr a, unsigned long b)
+	{
+		mpfr_add_ui(x, a, b, MPFR_RNDN);
+	}
+	
+	static void apply(mpfr_ptr x, long a, mpfr_srcptr b)
+	{
+		mpfr_add_si(x, b, a, MPFR_RNDN);
+	}
+	
+	static void apply(mpfr_ptr x, unsigned long a, mpfr_srcptr b)
+	{
+		mpfr_add_ui(x, b, a, MPFR_RNDN);
+	}
+};
+
+struct real_sub
+{
+	static void apply(mpfr_ptr x, mpfr_srcptr a, mpfr_srcptr b)
+	{
+		mpfr_sub(x, a, b, MPFR_RNDN);
+	}
+	
+	static void apply(mpfr_ptr x, mpfr_srcptr a, long b)
+	{
+		mpfr_sub_si(x, a, b, MPFR_RNDN);
+	}
+	
+	static void apply(mpfr_ptr x, mpfr_srcptr a, unsigned long b)
+	{
+		mpfr_sub_ui(x, a, b, MPFR_RNDN);
+	}
+	
+	static void apply(mpfr_ptr x, long a, mpfr_srcptr b)
+	{
+		mpfr_si_sub(x, a, b, MPFR_RNDN);
+	}
+	
+	static void apply(mpfr_ptr x, unsigned long a, mpfr_srcptr b)
+	{
+		mpfr_ui_sub(x, a, b, MPFR_RNDN);
+	}
+};
+
+struct real_mul
+{
+	static void apply(mpfr_ptr x, mpfr_srcptr a, mpfr_srcptr b)
+	{
+		mpfr_mul(x, a, b, MPFR_RNDN);
+	}
+	
+	static void apply(mpfr_ptr x, mpfr_srcptr a, long b)
+	{
+		mpfr_mul_si(x, a, b, MPFR_RNDN);
+	}
+	
+	static void apply(mpfr_ptr x, mpfr_srcptr a, unsigned long b)
+	{
+		mpfr_mul_ui(x, a, b, MPFR_RNDN);
+	}
+	
+	static void apply(mpfr_ptr x, long a, mpfr_srcptr b)
+	{
+		mpfr_mul_si(x, b, a, MPFR_RNDN);
+	}
+	
+	static void apply(mpfr_ptr x, unsigned long a, mpfr_srcptr b)
+	{
+		mpfr_mul_ui(x, b, a, MPFR_RNDN);
+	}
+};
+
+struct real_div
+{
+	static void apply(mpfr_ptr x, mpfr_srcptr a, mpfr_srcptr b)
+	{
+		mpfr_div(x, a, b, MPFR_RNDN);
+	}
+	
+	static void apply(mpfr_ptr x, mpfr_srcptr a, long b)
+	{
+		mpfr_div_si(x, a, b, MPFR_RNDN);
+	}
+	
+	static void apply(mpfr_ptr x, mpfr_srcptr a, unsigned long b)
+	{
+		mpfr_div_ui(x, a, b, MPFR_RNDN);
+	}
+	
+	static void apply(mpfr_ptr x, long a, mpfr_srcptr b)
+	{
+		mpfr_si_div(x, a, b, MPFR_RNDN);
+	}
+	
+	static void apply(mpfr_ptr x, unsigned long a, mpfr_srcptr b)
+	{
+		mpfr_ui_div(x, a, b, MPFR_RNDN);
+	}
+};
+
+//
+// The registers an expression is evaluated with.  Operands that are reals are
+// used directly.  The first operand that is an expression is evaluated into
+// the destination itself, and the second into the one scratch register, which
+// is provided by V, the kind of real the expression evaluates to.  Nodes never
+// fetch more than two expression operands.
+//
+template <class V>
+class real_registers
+{
+public:
+	real_registers(mpfr_ptr xx) : x(xx), n_used(0)
+	{
+	}
+	
+	template <class E>
+	mpfr_srcptr fetch(const E & e)
+	{
+		return fetch(e, std::integral_constant<bool, E::leaf>());
+	}
+	
+private:
+	mpfr_ptr x;
+	typename V::scratch t;
+	int n_used;
+	
+	template <class E>
+	mpfr_srcptr fetch(const E & e, std::true_type)
+	{
+		return e.src();
+	}
+	
+	template <class E>
+	mpfr_srcptr fetch(const E & e, std::false_type)
+	{
+		if (n_used == 0)
+		{
+			n_used = 1;
+			e.eval(x);
+			return x;
+		}
+		else
+		{
+			mpfr_ptr y = t.get(x);
+			
+			n_used = 2;
+			e.eval(y);
+			return y;
+		}
+	}
+};
+
+//
+// Works out whether an expression can be evaluated straight into x, when x
+// may be one of its operands.  Visit the operands in the order they're
+// fetched.  Since the first expression operand overwrites x, it has to be
+// safe itself, and no other operand may read x.  If all of the operands are
+// reals, MPFR takes care of the aliasing.
+//
+class real_safety
+{
+public:
+	real_safety(mpfr_srcptr xx) : x(xx), n_compound(0), first_safe(true), alias(false)
+	{
+	}
+	
+	template <class E>
+	void visit(const E & e)
+	{
+		if (!E::leaf && n_compound++ == 0)
+		{
+			first_safe = e.safe(x);
+		}
+		else if (e.aliases(x))
+		{
+			alias = true;
+		}
+	}
+	
+	bool result() const
+	{
+		return n_compound == 0 || (first_safe && !alias);
+	}
+	
+private:
+	mpfr_srcptr x;
+	int n_compound;
+	bool first_safe;
+	bool alias;
+};
+
+template <class Op, class L, class R>
+struct real_evaluator;
+
+template <class Op, class L, class R>
+class real_binary : public real_expr<real_binary<Op, L, R> >
+{
+public:
+	typedef typename L::value_type value_type;
+	
+	static const bool leaf = false;
+	
+	typename real_operand<L>::type l;
+	typename real_operand<R>::type r;
+	
+	real_binary(const L & ll, const R & rr) : l(ll), r(rr)
+	{
+	}
+	
+	bool aliases(mpfr_srcptr x) const
+	{
+		return l.aliases(x) || r.aliases(x);
+	}
+	
+	bool safe(mpfr_srcptr x) const
+	{
+		return real_evaluator<Op, L, R>::safe(x, l, r);
+	}
+	
+	void eval(mpfr_ptr x) const
+	{
+		real_evaluator<Op, L, R>::eval(x, l, r);
+	}
+};
+
+template <class A>
+class real_negate : public real_expr<real_negate<A> >
+{
+public:
+	typedef typename A::value_type value_type;
+	
+	static const bool leaf = false;
+	
+	typename real_operand<A>::type a;
+	
+	real_negate(const A & aa) : a(aa)
+	{
+	}
+	
+	bool aliases(mpfr_srcptr x) const
+	{
+		return a.aliases(x);
+	}
+	
+	bool safe(mpfr_srcptr x) const
+	{
+		real_safety s(x);
+		
+		s.visit(a);
+		return s.result();
+	}
+	
+	void eval(mpfr_ptr x) const
+	{
+		real_registers<value_type> g(x);
+		
+		mpfr_neg(x, g.fetch(a), MPFR_RNDN);
+	}
+};
+
+//
+// Small integers are kept as they are, and use the _si and _ui versions of
+// the MPFR functions, which are a lot cheaper than a full-precision operation
+// on a real like real::TWO.  Signed integers are widened to long, and
+// unsigned ones to unsigned long.
+//
+template <class T>
+struct real_integer
+{
+	typedef typename std::conditional<std::is_signed<T>::value, long, unsigned long>::type type;
+};
+
+// e op n
+template <class Op, class E, class T>
+class real_binary_int : public real_expr<real_binary_int<Op, E, T> >
+{
+public:
+	typedef typename E::value_type value_type;
+	
+	static const bool leaf = false;
+	
+	typename real_operand<E>::type e;
+	T n;
+	
+	real_binary_int(const E & ee, T nn) : e(ee), n(nn)
+	{
+	}
+	
+	bool aliases(mpfr_srcptr x) const
+	{
+		return e.aliases(x);
+	}
+	
+	bool safe(mpfr_srcptr x) const
+	{
+		real_safety s(x);
+		
+		s.visit(e);
+		return s.result();
+	}
+	
+	void eval(mpfr_ptr x) const
+	{
+		real_registers<value_type> g(x);
+		
+		Op::apply(x, g.fetch(e), n);
+	}
+};
+
+// n op e
+template <class Op, class T, class E>
+class real_int_binary : public real_expr<real_int_binary<Op, T, E> >
+{
+public:
+	typedef typename E::value_type value_type;
+	
+	static const bool leaf = false;
+	
+	T n;
+	typename real_operand<E>::type e;
+	
+	real_int_binary(T nn, const E & ee) : n(nn), e(ee)
+	{
+	}
+	
+	bool aliases(mpfr_srcptr x) const
+	{
+		return e.aliases(x);
+	}
+	
+	bool safe(mpfr_srcptr x) const
+	{
+		real_safety s(x);
+		
+		s.visit(e);
+		return s.result();
+	}
+	
+	void eval(mpfr_ptr x) const
+	{
+		real_registers<value_type> g(x);
+		
+		Op::apply(x, n, g.fetch(e));
+	}
+};
+
+//
+// Evaluates l op r with the operands fetched in order.
+//
+template <class Op, class L, class R>
+struct real_generic
+{
+	static bool safe(mpfr_srcptr x, const L & l, const R & r)
+	{
+		real_safety s(x);
+		
+		s.visit(l);
+		s.visit(r);
+		return s.result();
+	}
+	
+	static void eval(mpfr_ptr x, const L & l, const R & r)
+	{
+		real_registers<typename L::value_type> g(x);
+		mpfr_srcptr a = g.fetch(l);
+		mpfr_srcptr b = g.fetch(r);
+		
+		Op::apply(x, a, b);
+	}
+};
+
+template <class Op, class L, class R>
+struct real_evaluator : public real_generic<Op, L, R>
+{
+};
+
+//
+// a * b + c or a * b - c with a single rounding, optionally negated
+// afterwards, which is exact.  If a, b, and c are all expressions, there
+// aren't enough registers to fuse them, and the node is evaluated as a
+// product followed by a sum instead.
+//
+template <class A, class B, class C>
+struct real_fused
+{
+	static const bool fuse = (!A::leaf) + (!B::leaf) + (!C::leaf) <= 2;
+	
+	static bool safe(mpfr_srcptr x, const A & a, const B & b, const C & c)
+	{
+		real_safety s(x);
+		
+		s.visit(a);
+		s.visit(b);
+		s.visit(c);
+		return s.result();
+	}
+	
+	static void eval(mpfr_ptr x, const A & a, const B & b, const C & c, bool subtract, bool negate)
+	{
+		real_registers<typename A::value_type> g(x);
+		mpfr_srcptr pa = g.fetch(a);
+		mpfr_srcptr pb = g.fetch(b);
+		mpfr_srcptr pc = g.fetch(c);
+		
+		if (subtract)
+		{
+			mpfr_fms(x, pa, pb, pc, MPFR_RNDN);
+		}
+		else
+		{
+			mpfr_fma(x, pa, pb, pc, MPFR_RNDN);
+		}
+		if (negate)
+		{
+			mpfr_neg(x, x, MPFR_RNDN);
+		}
+	}
+};
+
+//
+// a * b + c * d or a * b - c * d with a single rounding.
+//
+template <class A, class B, class C, class D>
+struct real_fused2
+{
+	static const bool fuse = (!A::leaf) + (!B::leaf) + (!C::leaf) + (!D::leaf) <= 2;
+	
+	static bool safe(mpfr_srcptr x, const A & a, const B & b, const C & c, const D & d)
+	{
+		real_safety s(x);
+		
+		s.visit(a);
+		s.visit(b);
+		s.visit(c);
+		s.visit(d);
+		return s.result();
+	}
+	
+	static void eval(mpfr_ptr x, const A & a, const B & b, const C & c, const D & d, bool subtract)
+	{
+		real_registers<typename A::value_type> g(x);
+		mpfr_srcptr pa = g.fetch(a);
+		mpfr_srcptr pb = g.fetch(b);
+		mpfr_srcptr pc = g.fetch(c);
+		mpfr_srcptr pd = g.fetch(d);
+		
+		if (subtract)
+		{
+			mpfr_fmms(x, pa, pb, pc, pd, MPFR_RNDN);
+		}
+		else
+		{
+			mpfr_fmma(x, pa, pb, pc, pd, MPFR_RNDN);
+		}
+	}
+};
+
+// a * b + c
+template <class A, class B, class C>
+struct real_evaluator<real_add, real_binary<real_mul, A, B>, C>
+{
+	typedef real_binary<real_mul, A, B> L;
+	typedef real_fused<A, B, C> F;
+	
+	static bool safe(mpfr_srcptr x, const L & l, const C & r)
+	{
+		return F::fuse ? F::safe(x, l.l, l.r, r) : real_generic<real_add, L, C>::safe(x, l, r);
+	}
+	
+	static void eval(mpfr_ptr x, const L & l, const C & r)
+	{
+		if (F::fuse)
+		{
+			F::eval(x, l.l, l.r, r, false, false);
+		}
+		else
+		{
+			real_generic<real_add, L, C>::eval(x, l, r);
+		}
+	}
+};
+
+// c + a * b
+template <class A, class B, class C>
+struct real_evaluator<real_add, C, real_binary<real_mul, A, B> >
+{
+	typedef real_binary<real_mul, A, B> R;
+	typedef real_fused<A, B, C> F;
+	
+	static bool safe(mpfr_srcptr x, const C & l, const R & r)
+	{
+		return F::fuse ? F::safe(x, r.l, r.r, l) : real_generic<real_add, C, R>::safe(x, l, r);
+	}
+	
+	static void eval(mpfr_ptr x, const C & l, const R & r)
+	{
+		if (F::fuse)
+		{
+			F::eval(x, r.l, r.r, l, false, false);
+		}
+		else
+		{
+			real_generic<real_add, C, R>::eval(x, l, r);
+		}
+	}
+};
+
+// a * b - c
+template <class A, class B, class C>
+struct real_evaluator<real_sub, real_binary<real_mul, A, B>, C>
+{
+	typedef real_binary<real_mul, A, B> L;
+	typedef real_fused<A, B, C> F;
+	
+	static bool safe(mpfr_srcptr x, const L & l, const C & r)
+	{
+		return F::fuse ? F::safe(x, l.l, l.r, r) : real_generic<real_sub, L, C>::safe(x, l, r);
+	}
+	
+	static void eval(mpfr_ptr x, const L & l, const C & r)
+	{
+		if (F::fuse)
+		{
+			F::eval(x, l.l, l.r, r, true, false);
+		}
+		else
+		{
+			real_generic<real_sub, L, C>::eval(x, l, r);
+		}
+	}
+};
+
+// c - a * b, which is -(a * b - c)
+template <class A, class B, class C>
+struct real_evaluator<real_sub, C, real_binary<real_mul, A, B> >
+{
+	typedef real_binary<real_mul, A, B> R;
+	typedef real_fused<A, B, C> F;
+	
+	static bool safe(mpfr_srcptr x, const C & l, const R & r)
+	{
+		return F::fuse ? F::safe(x, r.l, r.r, l) : real_generic<real_sub, C, R>::safe(x, l, r);
+	}
+	
+	static void eval(mpfr_ptr x, const C & l, const R & r)
+	{
+		if (F::fuse)
+		{
+			F::eval(x, r.l, r.r, l, true, true);
+		}
+		else
+		{
+			real_generic<real_sub, C, R>::eval(x, l, r);
+		}
+	}
+};
+
+// a * b + c * d
+template <class A, class B, class C, class D>
+struct real_evaluator<real_add, real_binary<real_mul, A, B>, real_binary<real_mul, C, D> >
+{
+	typedef real_binary<real_mul, A, B> L;
+	typedef real_binary<real_mul, C, D> R;
+	typedef real_fused2<A, B, C, D> F;
+	
+	static bool safe(mpfr_srcptr x, const L & l, const R & r)
+	{
+		return F::fuse ? F::safe(x, l.l, l.r, r.l, r.r) : real_generic<real_add, L, R>::safe(x, l, r);
+	}
+	
+	static void eval(mpfr_ptr x, const L & l, const R & r)
+	{
+		if (F::fuse)
+		{
+			F::eval(x, l.l, l.r, r.l, r.r, false);
+		}
+		else
+		{
+			real_generic<real_add, L, R>::eval(x, l, r);
+		}
+	}
+};
+
+// a * b - c * d
+template <class A, class B, class C, class D>
+struct real_evaluator<real_sub, real_binary<real_mul, A, B>, real_binary<real_mul, C, D> >
+{
+	typedef real_binary<real_mul, A, B> L;
+	typedef real_binary<real_mul, C, D> R;
+	typedef real_fused2<A, B, C, D> F;
+	
+	static bool safe(mpfr_srcptr x, const L & l, const R & r)
+	{
+		return F::fuse ? F::safe(x, l.l, l.r, r.l, r.r) : real_generic<real_sub, L, R>::safe(x, l, r);
+	}
+	
+	static void eval(mpfr_ptr x, const L & l, const R & r)
+	{
+		if (F::fuse)
+		{
+			F::eval(x, l.l, l.r, r.l, r.r, true);
+		}
+		else
+		{
+			real_generic<real_sub, L, R>::eval(x, l, r);
+		}
+	}
+};
+
+template <class E, class>
+real::real(const real_expr<E> & a)
+{
+	init();
+	a.self().eval(r);
+}
+
+//
+// If the destination appears in the expression in a way that it would be
+// overwritten before it's read, evaluate into a temporary and swap it in.
+//
+template <class E>
+real & real::operator =(const real_expr<E> & a)
+{
+	if (r->_mpfr_d != 0 && a.self().safe(r))
+	{
+		a.self().eval(r);
+	}
+	else
+	{
+		real x(a);
+		
+		mpfr_swap(r, x.r);
+	}
+	return *this;
+}
+
+template <class E>
+int real_expr<E>::get_int() const
+{
+	return typename E::value_type(self()).get_int();
+}
+
+template <class E>
+double real_expr<E>::get_double() const
+{
+	return typename E::value_type(self()).get_double();
+}
+
+template <class E>
+std::string real_expr<E>::get_string(int p) const
+{
+	return typename E::value_type(self()).get_string(p);
+}
+
+//
+// The operators are overloaded for every combination of reals, other
+// expressions, and integers, so that the overload taking two reals (which
+// lets a double still convert to a real) is never ambiguous.
+//
+template <class L, class R>
+real_binary<real_add, L, R> operator +(const real_expr<L> & a, const real_expr<R> & b)
+{
+	return real_binary<real_add, L, R>(a.self(), b.self());
+}
+
+template <class L>
+real_binary<real_add, L, real> operator +(const real_expr<L> & a, const real & b)
+{
+	return real_binary<real_add, L, real>(a.self(), b);
+}
+
+template <class R>
+real_binary<real_add, real, R> operator +(const real & a, const real_expr<R> & b)
+{
+	return real_binary<real_add, real, R>(a, b.self());
+}
+
+template <class L, class R>
+real_binary<real_sub, L, R> operator -(const real_expr<L> & a, const real_expr<R> & b)
+{
+	return real_binary<real_sub, L, R>(a.self(), b.self());
+}
+
+template <class L>
+real_binary<real_sub, L, real> operator -(const real_expr<L> & a, const real & b)
+{
+	return real_binary<real_sub, L, real>(a.self(), b);
+}
+
+template <class R>
+real_binary<real_sub, real, R> operator -(const real & a, const real_expr<R> & b)
+{
+	return real_binary<real_sub, real, R>(a, b.self());
+}
+
+template <class L, class R>
+real_binary<real_mul, L, R> operator *(const real_expr<L> & a, const real_expr<R> & b)
+{
+	return real_binary<real_mul, L, R>(a.self(), b.self());
+}
+
+template <class L>
+real_binary<real_mul, L, real> operator *(const real_expr<L> & a, const real & b)
+{
+	return real_binary<real_mul, L, real>(a.self(), b);
+}
+
+template <class R>
+real_binary<real_mul, real, R> operator *(const real & a, const real_expr<R> & b)
+{
+	return real_binary<real_mul, real, R>(a, b.self());
+}
+
+template <class L, class R>
+real_binary<real_div, L, R> operator /(const real_expr<L> & a, const real_expr<R> & b)
+{
+	return real_binary<real_div, L, R>(a.self(), b.self());
+}
+
+template <class L>
+real_binary<real_div, L, real> operator /(const real_expr<L> & a, const real & b)
+{
+	return real_binary<real_div, L, real>(a.self(), b);
+}
+
+template <class R>
+real_binary<real_div, real, R> operator /(const real & a, const real_expr<R> & b)
+{
+	return real_binary<real_div, real, R>(a, b.self());
+}
+
+template <class L, class T>
+typename std::enable_if<std::is_integral<T>::value, real_binary_int<real_add, L, typename real_integer<T>::type> >::type operator +(const real_expr<L> & a, T b)
+{
+	return real_binary_int<real_add, L, typename real_integer<T>::type>(a.self(), b);
+}
+
+template <class T, class R>
+typename std::enable_if<std::is_integral<T>::value, real_int_binary<real_add, typename real_integer<T>::type, R> >::type operator +(T a, const real_expr<R> & b)
+{
+	return real_int_binary<real_add, typename real_integer<T>::type, R>(a, b.self());
+}
+
+template <class L, class T>
+typename std::enable_if<std::is_integral<T>::value, real_binary_int<real_sub, L, typename real_integer<T>::type> >::type operator -(const real_expr<L> & a, T b)
+{
+	return real_binary_int<real_sub, L, typename real_integer<T>::type>(a.self(), b);
+}
+
+template <class T, class R>
+typename std::enable_if<std::is_integral<T>::value, real_int_binary<real_sub, typename real_integer<T>::type, R> >::type operator -(T a, const real_expr<R> & b)
+{
+	return real_int_binary<real_sub, typename real_integer<T>::type, R>(a, b.self());
+}
+
+template <class L, class T>
+typename std::enable_if<std::is_integral<T>::value, real_binary_int<real_mul, L, typename real_integer<T>::type> >::type operator *(const real_expr<L> & a, T b)
+{
+	return real_binary_int<real_mul, L, typename real_integer<T>::type>(a.self(), b);
+}
+
+template <class T, class R>
+typename std::enable_if<std::is_integral<T>::value, real_int_binary<real_mul, typename real_integer<T>::type, R> >::type operator *(T a, const real_expr<R> & b)
+{
+	return real_int_binary<real_mul, typename real_integer<T>::type, R>(a, b.self());
+}
+
+template <class L, class T>
+typename std::enable_if<std::is_integral<T>::value, real_binary_int<real_div, L, typename real_integer<T>::type> >::type operator /(const real_expr<L> & a, T b)
+{
+	return real_binary_int<real_div, L, typename real_integer<T>::type>(a.self(), b);
+}
+
+template <class T, class R>
+typename std::enable_if<std::is_integral<T>::value, real_int_binary<real_div, typename real_integer<T>::type, R> >::type operator /(T a, const real_expr<R> & b)
+{
+	return real_int_binary<real_div, typename real_integer<T>::type, R>(a, b.self());
+}
+
+template <class T>
+typename std::enable_if<std::is_integral<T>::value, real_binary_int<real_add, real, typename real_integer<T>::type> >::type operator +(const real & a, T b)
+{
+	return real_binary_int<real_add, real, typename real_integer<T>::type>(a, b);
+}
+
+template <class T>
+typename std::enable_if<std::is_integral<T>::value, real_int_binary<real_add, typename real_integer<T>::type, real> >::type operator +(T a, const real & b)
+{
+	return real_int_binary<real_add, typename real_integer<T>::type, real>(a, b);
+}
+
+template <class T>
+typename std::enable_if<std::is_integral<T>::value, real_binary_int<real_sub, real, typename real_integer<T>::type> >::type operator -(const real & a, T b)
+{
+	return real_binary_int<real_sub, real, typename real_integer<T>::type>(a, b);
+}
+
+template <class T>
+typename std::enable_if<std::is_integral<T>::value, real_int_binary<real_sub, typename real_integer<T>::type, real> >::type operator -(T a, const real & b)
+{
+	return real_int_binary<real_sub, typename real_integer<T>::type, real>(a, b);
+}
+
+template <class T>
+typename std::enable_if<std::is_integral<T>::value, real_binary_int<real_mul, real, typename real_integer<T>::type> >::type operator *(const real & a, T b)
+{
+	return real_binary_int<real_mul, real, typename real_integer<T>::type>(a, b);
+}
+
+template <class T>
+typename std::enable_if<std::is_integral<T>::value, real_int_binary<real_mul, typename real_integer<T>::type, real> >::type operator *(T a, const real & b)
+{
+	return real_int_binary<real_mul, typename real_integer<T>::type, real>(a, b);
+}
+
+template <class T>
+typename std::enable_if<std::is_integral<T>::value, real_binary_int<real_div, real, typename real_integer<T>::type> >::type operator /(const real & a, T b)
+{
+	return real_binary_int<real_div, real, typename real_integer<T>::type>(a, b);
+}
+
+template <class T>
+typename std::enable_if<std::is_integral<T>::value, real_int_binary<real_div, typename real_integer<T>::type, real> >::type operator /(T a, const real & b)
+{
+	return real_int_binary<real_div, typename real_integer<T>::type, real>(a, b);
+}
+
+template <class A>
+real_negate<A> operator -(const real_expr<A> & a)
+{
+	return real_negate<A>(a.self());
+}
+
+real_binary<real_add, real, real> operator +(const real & a, const real & b);
+real_binary<real_sub, real, real> operator -(const real & a, const real & b);
+real_binary<real_mul, real, real> operator *(const real & a, const real & b);
+real_binary<real_div, real, real> operator /(const real & a, const real & b);
 bool operator >(const real & a, const real & b);
 bool operator >=(const real & a, const real & b);
 bool operator <(const real & a, const real & b);
@@ -97,6 +1222,9 @@ bool operator <=(const real & a, const real & b);
 bool operator ==(const real & a, const real & b);
 bool operator !=(const real & a, const real & b);
 real abs(const real & a);
+bool is_negligible(const real & change, const real & x);
+long mul_for_sum(real & x, const real & a, const real & b, const real & sum, long guard_bits);
+void set_z_2exp(real & x, mpz_srcptr a, long e);
 real atan(const real & a);
 real atan2(const real & b, const real & a);
 real cos(const real & a);
@@ -105,18 +1233,124 @@ real log(const real & a);
 real max(const real & a, const real & b);
 real pochhammer(const real & a, const real & k);
 real pow(const real & a, const real & b);
+real pow_si(const real & a, long n);
+real rec_sqrt(const real & a);
+real reciprocal(const real & a);
 real remainder(const real & a, const real & b);
 real round(const real & a);
+real sign_pow(const real & n);
 real sin(const real & a);
+real sqrt(const real & a);
 int gzbi(const real & i);
 int gnobi(const real & i);
-complex operator +(const complex & a, const complex & b);
-complex operator -(const complex & a, const complex & b);
-complex operator *(const complex & a, const complex & b);
-complex operator /(const complex & a, const complex & b);
-complex operator -(const complex & a);
-real abs(const complex & a);
-complex log(const complex & a);
-complex pow(const complex & a, const real & b);
+
+//
+// The compound assignments work in place whenever the right-hand side allows
+// it, e.g., S1 += change is a single mpfr_add on S1, and i += 2 is a single
+// mpfr_add_si.
+//
+template <class E>
+real & real::operator +=(const real_expr<E> & a)
+{
+	return *this = *this + a.self();
+}
+
+template <class E>
+real & real::operator -=(const real_expr<E> & a)
+{
+	return *this = *this - a.self();
+}
+
+template <class E>
+real & real::operator *=(const real_expr<E> & a)
+{
+	return *this = *this * a.self();
+}
+
+template <class E>
+real & real::operator /=(const real_expr<E> & a)
+{
+	return *this = *this / a.self();
+}
+
+template <class T>
+typename std::enable_if<std::is_integral<T>::value, real &>::type real::operator +=(T a)
+{
+	return *this = *this + a;
+}
+
+template <class T>
+typename std::enable_if<std::is_integral<T>::value, real &>::type real::operator -=(T a)
+{
+	return *this = *this - a;
+}
+
+template <class T>
+typename std::enable_if<std::is_integral<T>::value, real &>::type real::operator *=(T a)
+{
+	return *this = *this * a;
+}
+
+template <class T>
+typename std::enable_if<std::is_integral<T>::value, real &>::type real::operator /=(T a)
+{
+	return *this = *this / a;
+}
+
+//
+// abs, log, and pow are also defined for complexes, so an expression has to
+// pick the version for the kind of real it evaluates to explicitly.
+//
+template <class E>
+typename E::value_type abs(const real_expr<E> & a)
+{
+	return abs(typename E::value_type(a));
+}
+
+template <class E>
+typename E::value_type log(const real_expr<E> & a)
+{
+	return log(typename E::value_type(a));
+}
+
+template <class E>
+typename E::value_type pow(const real_expr<E> & a, const typename E::value_type & b)
+{
+	return pow(typename E::value_type(a), b);
+}
+
+//
+// The same goes for the functions that pow hands its easy cases off to, so
+// that they work on expressions for every kind of real.
+//
+template <class E>
+typename E::value_type pow_si(const real_expr<E> & a, long n)
+{
+	return pow_si(typename E::value_type(a), n);
+}
+
+template <class E>
+typename E::value_type rec_sqrt(const real_expr<E> & a)
+{
+	return rec_sqrt(typename E::value_type(a));
+}
+
+template <class E>
+typename E::value_type reciprocal(const real_expr<E> & a)
+{
+	return reciprocal(typename E::value_type(a));
+}
+
+template <class E>
+typename E::value_type sign_pow(const real_expr<E> & n)
+{
+	return sign_pow(typename E::value_type(n));
+}
+
+template <class E>
+typename E::value_type sqrt(const real_expr<E> & a)
+{
+	return sqrt(typename E::value_type(a));
+}
 
 #endif
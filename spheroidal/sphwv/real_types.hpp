@@ -0,0 +1,56 @@
+//
+// Copyright (c) 2014, Ross Adelman, Nail A. Gumerov, and Ramani Duraiswami
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#ifndef REAL_TYPES_HPP
+#define REAL_TYPES_HPP
+
+#include "fixed_real.hpp"
+#include "native_real.hpp"
+#include "real.hpp"
+
+//
+// The kinds of reals that the code is compiled for.  Everything that's
+// templated on the kind of real is defined in a .cpp file, which explicitly
+// instantiates it for each of these with FOR_EACH_REAL_TYPE.  300 and 500
+// are the precisions used by generate_tasks.m in ../, 1000 is there for
+// larger values of c, and anything else is done with the usual reals, whose
+// precision is picked at run time.  The native_reals are the same code in
+// hardware (or software-emulated) floating point, for when the precision of
+// MPFR isn't needed.
+//
+#define FOR_EACH_REAL_TYPE(F) \
+	F(real) \
+	F(fixed_real<300>) \
+	F(fixed_real<500>) \
+	F(fixed_real<1000>) \
+	F(native_real<double>) \
+	F(native_real<long double>) \
+	F(native_real<__float128>) \
+	F(native_real<double_double>) \
+	F(native_real<extended_double>)
+
+#endif
@@ -0,0 +1,65 @@
+//
+// Copyright (c) 2014, Ross Adelman, Nail A. Gumerov, and Ramani Duraiswami
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include <atomic>
+#include <iostream>
+#include "root_finding.hpp"
+#include <string>
+
+int root_finding::method = root_finding::FALSE_POSITION;
+bool root_finding::precision_ladder = false;
+std::atomic<long> root_finding::n_zeros(0);
+std::atomic<long> root_finding::n_iterations(0);
+std::atomic<long> root_finding::n_evaluations(0);
+std::atomic<long> root_finding::n_ladder_evaluations(0);
+thread_local long root_finding::n_thread_evaluations = 0;
+
+bool root_finding::parse(int & method, const std::string & value)
+{
+	if (value == "false_position")
+	{
+		method = FALSE_POSITION;
+	}
+	else if (value == "illinois")
+	{
+		method = ILLINOIS;
+	}
+	else if (value == "anderson_bjorck")
+	{
+		method = ANDERSON_BJORCK;
+	}
+	else
+	{
+		return false;
+	}
+	return true;
+}
+
+void root_finding::print_statistics()
+{
+	std::cout << "root_finding: " << n_zeros << " zeros, " << n_iterations << " iterations, " << n_evaluations << " evaluations of U (" << n_ladder_evaluations << " on the precision ladder)" << std::endl;
+}
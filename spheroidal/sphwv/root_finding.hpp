@@ -0,0 +1,82 @@
+//
+// Copyright (c) 2014, Ross Adelman, Nail A. Gumerov, and Ramani Duraiswami
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#ifndef ROOT_FINDING_HPP
+#define ROOT_FINDING_HPP
+
+#include <atomic>
+#include <string>
+
+//
+// root_finding::method is how calculate_zero narrows down the bracket around
+// lambda, which main sets with -root_finder.  It's FALSE_POSITION by
+// default, which is what it's always done: the next guess is where the line
+// through the ends of the bracket crosses zero, and it replaces the end
+// whose U has the same sign.  When U is convex or concave over the bracket,
+// the same end keeps getting replaced, and the other one never moves, so
+// it only converges linearly.  ILLINOIS halves the U of the end that stays
+// put whenever that happens twice in a row, and ANDERSON_BJORCK scales it
+// by 1 - U(x) / U(the end that was replaced) instead (or by 1 / 2 if that
+// isn't positive), which pulls the next guess over to the other side of the
+// zero.  Both converge superlinearly, and the bracket is always kept.
+//
+// root_finding::precision_ladder, which main sets with -precision_ladder y,
+// has lambda found at a ladder of lower precisions before the full one (see
+// climb_precision_ladder in common_spheroidal.cpp).  It's false by default.
+//
+// The counters are added up over every zero that calculate_zero finds (at
+// any precision): n_zeros is how many there were, n_iterations is how many
+// guesses they took, n_evaluations is how many times U was worked out
+// altogether (including while the bracket was being found), and
+// n_ladder_evaluations is how many of those were on the precision ladder.
+// They're atomic, since zeros can be found on different threads at the same
+// time.  With -verbose y, main prints them at the end.
+//
+// n_thread_evaluations counts the same thing as n_evaluations, but only on
+// the calling thread, so that the evaluations that one thread's ladder took
+// can be told apart from the ones that other threads did in the meantime.
+//
+class root_finding
+{
+public:
+	static const int FALSE_POSITION = 0;
+	static const int ILLINOIS = 1;
+	static const int ANDERSON_BJORCK = 2;
+	
+	static int method;
+	static bool precision_ladder;
+	static std::atomic<long> n_zeros;
+	static std::atomic<long> n_iterations;
+	static std::atomic<long> n_evaluations;
+	static std::atomic<long> n_ladder_evaluations;
+	static thread_local long n_thread_evaluations;
+	
+	static bool parse(int & method, const std::string & value);
+	static void print_statistics();
+};
+
+#endif